@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+/**
+ * @brief Counts heap allocations and live heap bytes of the whole process by replacing the global operator new.
+ *
+ * The replacements are not inline, so this header must be included by exactly one translation unit of a benchmark.
+ */
+namespace bench
+{
+    struct AllocCounter
+    {
+        static inline std::atomic<size_t> allocations = 0;
+        static inline std::atomic<size_t> live_bytes = 0;
+    };
+} // namespace bench
+
+void *operator new(size_t size)
+{
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if ( ptr == nullptr ) {
+        throw std::bad_alloc();
+    }
+    bench::AllocCounter::allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::AllocCounter::live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if ( ptr != nullptr ) {
+        bench::AllocCounter::live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+        std::free(ptr);
+    }
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t /*size*/) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t /*size*/) noexcept { operator delete(ptr); }
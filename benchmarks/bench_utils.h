@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sockpp/connector.h>
+#include <sockpp/tcp_connector.h>
+#include <sockpp/unix_connector.h>
+
+#include <server/network/framing.h>
+
+/**
+ * @brief Small helpers shared by the benchmark executables.
+ *
+ * There is no benchmark framework vendored, so every benchmark is a plain executable that
+ * times its workload with std::chrono and prints a table via printHeader/printRow.
+ */
+namespace bench
+{
+    using clock = std::chrono::steady_clock;
+
+    struct LatencyStats
+    {
+        double p50_us;
+        double p99_us;
+        double mean_us;
+        size_t samples;
+    };
+
+    inline LatencyStats summarize(std::vector<clock::duration> samples)
+    {
+        if ( samples.empty() ) {
+            return {0, 0, 0, 0};
+        }
+        std::sort(samples.begin(), samples.end());
+        auto to_us = [](clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+        double total = 0;
+        for ( const auto &sample : samples ) {
+            total += to_us(sample);
+        }
+        const size_t p99_idx = std::min(samples.size() - 1, samples.size() * 99 / 100);
+        return {to_us(samples[samples.size() / 2]), to_us(samples[p99_idx]), total / samples.size(), samples.size()};
+    }
+
+    inline void printHeader(const std::string &title)
+    {
+        std::printf("\n%s\n", title.c_str());
+        std::printf("%-32s %12s %12s %12s %10s\n", "case", "p50 [us]", "p99 [us]", "mean [us]", "samples");
+    }
+
+    inline void printRow(const std::string &name, const LatencyStats &stats)
+    {
+        std::printf("%-32s %12.2f %12.2f %12.2f %10zu\n", name.c_str(), stats.p50_us, stats.p99_us, stats.mean_us,
+                    stats.samples);
+    }
+
+    /**
+     * @brief Times `iterations` calls of `fn` after `warmup` untimed calls.
+     */
+    template <typename Fn>
+    LatencyStats measure(size_t warmup, size_t iterations, Fn &&fn)
+    {
+        for ( size_t i = 0; i < warmup; ++i ) {
+            fn();
+        }
+        std::vector<clock::duration> samples;
+        samples.reserve(iterations);
+        for ( size_t i = 0; i < iterations; ++i ) {
+            auto start = clock::now();
+            fn();
+            samples.push_back(clock::now() - start);
+        }
+        return summarize(std::move(samples));
+    }
+
+    /**
+     * @brief Blocking client speaking the framing of the server (see server::Frame), over TCP or a Unix socket.
+     */
+    class FramedClient
+    {
+    public:
+        static FramedClient connectTcp(const std::string &host, uint16_t port)
+        {
+            auto connection = std::make_unique<sockpp::tcp_connector>();
+            connectWithRetry(*connection, sockpp::inet_address(host, port));
+            return FramedClient(std::move(connection));
+        }
+
+        static FramedClient connectUnix(const std::string &path)
+        {
+            auto connection = std::make_unique<sockpp::unix_connector>();
+            connectWithRetry(*connection, sockpp::unix_address(path));
+            return FramedClient(std::move(connection));
+        }
+
+        sockpp::connector &socket() { return *_connection; }
+
+        /**
+         * @brief Sends a frame, tagged with a channel for multiplexed connections.
+         */
+        void send(const std::string &message, std::optional<server::channel_id_t> channel = std::nullopt)
+        {
+            if ( _connection->write(server::encodeFrame(message, channel)).is_error() ) {
+                throw std::runtime_error("FramedClient: write failed");
+            }
+        }
+
+        server::Frame receiveFrame()
+        {
+            while ( true ) {
+                if ( std::optional<server::Frame> frame = _parser.next() ) {
+                    return std::move(frame.value());
+                }
+                char buffer[4096];
+                auto result = _connection->read(buffer, sizeof(buffer));
+                if ( result.is_error() || result.value() == 0 ) {
+                    throw std::runtime_error("FramedClient: connection closed");
+                }
+                _parser.append(buffer, result.value());
+            }
+        }
+
+        std::string receive() { return receiveFrame().payload; }
+
+    private:
+        explicit FramedClient(std::unique_ptr<sockpp::connector> connection) : _connection(std::move(connection)) {}
+
+        // the server might still be starting up
+        static void connectWithRetry(sockpp::connector &connection, const sockpp::sock_address &address)
+        {
+            for ( int attempt = 0; attempt < 100; ++attempt ) {
+                if ( connection.connect(address) ) {
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            throw std::runtime_error("FramedClient: could not connect to the server");
+        }
+
+        std::unique_ptr<sockpp::connector> _connection;
+        server::FrameParser _parser;
+    };
+} // namespace bench
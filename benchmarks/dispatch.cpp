@@ -0,0 +1,196 @@
+/**
+ * Cost of finding out which message (or decision) was received: the switch over the kind tag that the lobby, the
+ * game interface and the client use, against the chain of dynamic_casts that was used before. Every message and
+ * decision type is dispatched on its own, as the position in the dynamic_cast chain matters. One sample is a batch of
+ * dispatches of the same object, the table shows the p50 and mean per dispatch.
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <shared/action_decision.h>
+#include <shared/message_types.h>
+
+#include "bench_utils.h"
+
+namespace
+{
+    constexpr size_t WARMUP = 200;
+    constexpr size_t SAMPLES = 5'000;
+    constexpr size_t BATCH = 1'000;
+
+    // the object could change between two dispatches, so the compiler has to dispatch every time
+    template <typename T>
+    T *opaque(T *ptr)
+    {
+        asm volatile("" : "+r"(ptr) : : "memory");
+        return ptr;
+    }
+
+    /**
+     * @brief Position of the first type in Types that message is an instance of, like an if / else if chain.
+     */
+    template <typename... Types, typename BaseType>
+    size_t castChain(BaseType *message)
+    {
+        size_t index = 0;
+        ((dynamic_cast<Types *>(message) != nullptr || (++index, false)) || ...);
+        return index;
+    }
+
+    size_t castChain(shared::ClientToServerMessage *message)
+    {
+        using namespace shared;
+        return castChain<GameStateRequestMessage, CreateLobbyRequestMessage, JoinLobbyRequestMessage,
+                         StartGameRequestMessage, ActionDecisionMessage>(message);
+    }
+
+    size_t castChain(shared::ServerToClientMessage *message)
+    {
+        using namespace shared;
+        return castChain<GameStateMessage, CreateLobbyResponseMessage, JoinLobbyBroadcastMessage,
+                         StartGameBroadcastMessage, EndGameBroadcastMessage, ResultResponseMessage,
+                         ActionOrderMessage>(message);
+    }
+
+    size_t castChain(shared::ActionDecision *decision)
+    {
+        using namespace shared;
+        return castChain<PlayActionCardDecision, BuyCardDecision, EndActionPhaseDecision, EndTurnDecision,
+                         DeckChoiceDecision, GainFromBoardDecision>(decision);
+    }
+
+    size_t kindSwitch(const shared::Message *message)
+    {
+        switch ( message->getKind() ) {
+            case shared::MessageKind::GAME_STATE_REQUEST:
+            case shared::MessageKind::GAME_STATE:
+                return 0;
+            case shared::MessageKind::CREATE_LOBBY_REQUEST:
+            case shared::MessageKind::CREATE_LOBBY_RESPONSE:
+                return 1;
+            case shared::MessageKind::JOIN_LOBBY_REQUEST:
+            case shared::MessageKind::JOIN_LOBBY_BROADCAST:
+                return 2;
+            case shared::MessageKind::START_GAME_REQUEST:
+            case shared::MessageKind::START_GAME_BROADCAST:
+                return 3;
+            case shared::MessageKind::ACTION_DECISION:
+            case shared::MessageKind::END_GAME_BROADCAST:
+                return 4;
+            case shared::MessageKind::RESULT_RESPONSE:
+                return 5;
+            case shared::MessageKind::ACTION_ORDER:
+                return 6;
+            default:
+                return 7;
+        }
+    }
+
+    size_t kindSwitch(const shared::ActionDecision *decision)
+    {
+        switch ( decision->getKind() ) {
+            case shared::DecisionKind::PLAY_ACTION_CARD:
+                return 0;
+            case shared::DecisionKind::BUY_CARD:
+                return 1;
+            case shared::DecisionKind::END_ACTION_PHASE:
+                return 2;
+            case shared::DecisionKind::END_TURN:
+                return 3;
+            case shared::DecisionKind::DECK_CHOICE:
+                return 4;
+            case shared::DecisionKind::GAIN_FROM_BOARD:
+                return 5;
+            default:
+                return 6;
+        }
+    }
+
+    size_t checksum = 0;
+
+    template <typename BaseType>
+    void run(const std::string &name, BaseType *object)
+    {
+        auto batch = [&](auto dispatch)
+        {
+            return bench::measure(WARMUP, SAMPLES,
+                                  [&]()
+                                  {
+                                      for ( size_t i = 0; i < BATCH; ++i ) {
+                                          checksum += dispatch(opaque(object));
+                                      }
+                                  });
+        };
+        const auto switch_stats = batch([](BaseType *ptr) { return kindSwitch(ptr); });
+        const auto cast_stats = batch([](BaseType *ptr) { return castChain(ptr); });
+
+        // a batch takes BATCH times as long as one dispatch, so us per batch are ns per dispatch
+        std::printf("%-28s %12.2f %12.2f %12.2f %12.2f\n", name.c_str(), switch_stats.p50_us, switch_stats.mean_us,
+                    cast_stats.p50_us, cast_stats.mean_us);
+    }
+} // namespace
+
+int main()
+{
+    using namespace shared;
+
+    const std::vector<CardBase::id_t> kingdom = {"Village", "Smithy",      "Festival", "Market", "Laboratory",
+                                                 "Witch",   "Council_Room", "Moat",     "Cellar", "Chapel"};
+
+    std::printf("\nmessage dispatch, %zu dispatches per sample\n", BATCH);
+    std::printf("%-28s %12s %12s %12s %12s\n", "type", "switch p50", "switch mean", "cast p50", "cast mean");
+    std::printf("%-28s %12s %12s %12s %12s\n", "", "[ns]", "[ns]", "[ns]", "[ns]");
+
+    std::vector<std::pair<std::string, std::unique_ptr<ClientToServerMessage>>> client_messages;
+    client_messages.emplace_back("GameStateRequestMessage", std::make_unique<GameStateRequestMessage>("g", "p", "m"));
+    client_messages.emplace_back("CreateLobbyRequestMessage",
+                                 std::make_unique<CreateLobbyRequestMessage>("g", "p", "m"));
+    client_messages.emplace_back("JoinLobbyRequestMessage", std::make_unique<JoinLobbyRequestMessage>("g", "p", "m"));
+    client_messages.emplace_back("StartGameRequestMessage",
+                                 std::make_unique<StartGameRequestMessage>("g", "p", kingdom, "m"));
+    client_messages.emplace_back("ActionDecisionMessage",
+                                 std::make_unique<ActionDecisionMessage>(
+                                         "g", "p", std::make_unique<EndTurnDecision>(), std::nullopt, "m"));
+    for ( const auto &[name, message] : client_messages ) {
+        run(name, message.get());
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<ServerToClientMessage>>> server_messages;
+    server_messages.emplace_back("GameStateMessage",
+                                 std::make_unique<GameStateMessage>("g", nullptr, std::nullopt, "m"));
+    server_messages.emplace_back("CreateLobbyResponseMessage",
+                                 std::make_unique<CreateLobbyResponseMessage>("g", std::nullopt, "m"));
+    server_messages.emplace_back("JoinLobbyBroadcastMessage",
+                                 std::make_unique<JoinLobbyBroadcastMessage>("g", std::vector<PlayerBase::id_t>{},
+                                                                             "m"));
+    server_messages.emplace_back("StartGameBroadcastMessage", std::make_unique<StartGameBroadcastMessage>("g", "m"));
+    server_messages.emplace_back("EndGameBroadcastMessage",
+                                 std::make_unique<EndGameBroadcastMessage>("g", std::vector<PlayerResult>{}, "m"));
+    server_messages.emplace_back("ResultResponseMessage",
+                                 std::make_unique<ResultResponseMessage>("g", true, std::nullopt, std::nullopt, "m"));
+    server_messages.emplace_back("ActionOrderMessage",
+                                 std::make_unique<ActionOrderMessage>("g", std::make_unique<EndTurnOrder>(), nullptr,
+                                                                      std::nullopt, "m"));
+    for ( const auto &[name, message] : server_messages ) {
+        run(name, message.get());
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<ActionDecision>>> decisions;
+    decisions.emplace_back("PlayActionCardDecision", std::make_unique<PlayActionCardDecision>("Village"));
+    decisions.emplace_back("BuyCardDecision", std::make_unique<BuyCardDecision>("Gold"));
+    decisions.emplace_back("EndActionPhaseDecision", std::make_unique<EndActionPhaseDecision>());
+    decisions.emplace_back("EndTurnDecision", std::make_unique<EndTurnDecision>());
+    decisions.emplace_back("DeckChoiceDecision",
+                           std::make_unique<DeckChoiceDecision>(std::vector<CardBase::id_t>{},
+                                                                std::vector<ChooseFromOrder::AllowedChoice>{}));
+    decisions.emplace_back("GainFromBoardDecision", std::make_unique<GainFromBoardDecision>("Silver"));
+    for ( const auto &[name, decision] : decisions ) {
+        run(name, decision.get());
+    }
+
+    std::printf("\nchecksum %zu\n", checksum);
+    return 0;
+}
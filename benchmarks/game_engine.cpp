@@ -0,0 +1,437 @@
+/**
+ * CPU time of the game engine without any networking: four bots play "big money" games (buy Province, Gold or
+ * Silver, nothing else) through a server::GameInterface, the same way the lobby drives a game. One sample is one
+ * turn, including the reduced game state of every player that is sent out after each action.
+ * As the engine logs a lot (even below the log level), the card handling of a single server::Player, drawing a card
+ * and putting it back on top of the draw pile (e.g. Sea Hag, Treasure Map), the score of a player and the supply pile
+ * lookups of the board are also measured on their own. Also reports the heap allocations per turn and the heap
+ * memory held by a game in progress.
+ * A bot that buys out of turn is rejected once with an exception and once with an error code (std::nothrow), both
+ * directly by the GameState and through the GameInterface.
+ * Forking a game in the midgame (as a search would do for every move it tries) is measured on its own and followed by
+ * a turn in the fork, which has to copy the piles it changes. The same game is also turned into a snapshot and back,
+ * and hashed with the hashes the piles keep up to date and from scratch.
+ * The reduced player of a hand of 200 cards, as it can be built up with God_Mode, is measured after every change.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <server/game/game_interface.h>
+#include <server/game/server_board.h>
+#include <shared/action_decision.h>
+#include <shared/message_types.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/logger.h>
+
+#include "alloc_counter.h"
+#include "bench_utils.h"
+
+namespace
+{
+    constexpr size_t WARMUP = 2'000;
+    constexpr size_t SAMPLES = 50'000;
+    // a big money game lasts about 60 turns
+    constexpr size_t MEMORY_TURNS = 40;
+
+    const std::string GAME_ID = "bench";
+    const std::vector<shared::CardBase::id_t> KINGDOM = {"Village",      "Smithy", "Festival", "Market", "Laboratory",
+                                                         "Council_Room", "Witch",  "Moat",     "Cellar", "Chapel"};
+    const std::vector<server::Player::id_t> PLAYERS = {"alice", "bob", "carol", "dave"};
+
+    struct Buy
+    {
+        const char *card;
+        unsigned int cost;
+    };
+    const Buy BUY_PRIORITY[] = {{"Province", 8}, {"Gold", 6}, {"Silver", 3}};
+
+    // the cards of a big money player in the midgame
+    const std::vector<std::pair<const char *, size_t>> DECK = {
+            {"Copper", 7}, {"Estate", 3}, {"Silver", 8}, {"Gold", 5}, {"Province", 3}, {"Duchy", 2}};
+
+    /**
+     * @brief What a turn does to the cards of a player, without GameState and behaviours around it.
+     */
+    struct PlayerCards
+    {
+        server::Player player{"alice"};
+        const server::Player::card_id province = "Province";
+
+        PlayerCards()
+        {
+            for ( const auto &[card, count] : DECK ) {
+                for ( size_t i = 0; i < count; ++i ) {
+                    player.gain(card);
+                }
+            }
+            player.draw(5);
+        }
+
+        void playTurn()
+        {
+            if ( player.hasType<shared::HAND>(shared::CardType::ACTION) ) {
+                throw std::logic_error("there are no actions in the deck");
+            }
+            auto treasures = player.getType<shared::HAND>(shared::CardType::TREASURE);
+            if ( !treasures.empty() ) {
+                player.take<shared::HAND>(treasures);
+                player.add<shared::DISCARD_PILE>(treasures);
+            }
+            if ( player.hasCard<shared::HAND>(province) ) {
+                player.move<shared::HAND, shared::DISCARD_PILE>(province);
+            }
+            player.endTurn();
+        }
+    };
+
+    /**
+     * @brief Draws a card and puts it back on top of a full draw pile, so the discard pile is never reshuffled.
+     */
+    struct TopDeck
+    {
+        server::Player player{"alice"};
+
+        TopDeck()
+        {
+            for ( const auto &[card, count] : DECK ) {
+                for ( size_t i = 0; i < count; ++i ) {
+                    player.add<shared::DRAW_PILE_BOTTOM>(card);
+                }
+            }
+        }
+
+        void drawAndPutBack()
+        {
+            player.draw(1);
+            player.move<shared::HAND, shared::DRAW_PILE_TOP>(1);
+        }
+    };
+
+    /**
+     * @brief The board queries of a buy: is the card available, take it, is the game over.
+     */
+    struct SupplyLookups
+    {
+        server::ServerBoard::ptr_t board = server::ServerBoard::make(KINGDOM, PLAYERS.size());
+        const server::Player::card_id province = "Province";
+        const server::Player::card_id village = "Village";
+        const server::Player::card_id silver = "Silver";
+        size_t checksum = 0;
+
+        void buy()
+        {
+            checksum += static_cast<size_t>(board->has(province)) + static_cast<size_t>(board->has(village));
+            if ( board->has(silver) ) {
+                board->tryTake(silver);
+            }
+            checksum += board->getEmptyPilesCount() + static_cast<size_t>(board->isGameOver());
+        }
+    };
+
+    /**
+     * @brief bob tries to buy a Province while it is the turn of alice, which never changes the game.
+     */
+    struct RejectedMoves
+    {
+        server::GameInterface::ptr_t game = server::GameInterface::make(GAME_ID, KINGDOM, PLAYERS);
+        server::GameState state{KINGDOM, PLAYERS, 42};
+        const server::Player::card_id province = "Province";
+        // bob sits right after alice
+        const server::Player::seat_t bob = 1;
+        size_t rejected = 0;
+
+        RejectedMoves() { game->startGame(); }
+
+        void throwingState()
+        {
+            try {
+                state.tryBuy(bob, province);
+            } catch ( const exception::NotYourTurn & ) {
+                ++rejected;
+            }
+        }
+
+        void nothrowState() { rejected += static_cast<size_t>(!state.tryBuy(bob, province, std::nothrow)); }
+
+        std::unique_ptr<shared::ClientToServerMessage> message() const
+        {
+            return std::make_unique<shared::ActionDecisionMessage>(
+                    GAME_ID, PLAYERS[1], std::make_unique<shared::BuyCardDecision>("Province"), std::nullopt,
+                    "message");
+        }
+
+        void throwingInterface()
+        {
+            auto msg = message();
+            try {
+                game->handleMessage(msg);
+            } catch ( const exception::NotYourTurn & ) {
+                ++rejected;
+            }
+        }
+
+        void nothrowInterface()
+        {
+            auto msg = message();
+            auto result = game->handleMessage(msg, std::nothrow);
+            rejected += static_cast<size_t>(std::holds_alternative<server::MoveResult>(result));
+        }
+    };
+
+    /**
+     * @brief A game after MEMORY_TURNS turns of big money (without the GameInterface), to be forked.
+     */
+    struct Fork
+    {
+        server::GameState state{KINGDOM, PLAYERS, 42};
+        size_t checksum = 0;
+
+        Fork()
+        {
+            for ( size_t turn = 0; turn < MEMORY_TURNS; ++turn ) {
+                state.getCurrentPlayer().gain(BUY_PRIORITY[turn % std::size(BUY_PRIORITY)].card);
+                state.endTurn();
+            }
+        }
+
+        void fork() { checksum += state.fork().getCurrentPlayer().get<shared::HAND>().size(); }
+
+        void forkAndPlay()
+        {
+            // big money has no actions, the fork is in the buy phase already
+            auto fork = state.fork();
+            fork.tryPlayAllTreasures(fork.getCurrentSeat());
+            fork.tryEndTurn(fork.getCurrentSeat());
+            checksum += fork.getCurrentPlayer().get<shared::HAND>().size();
+        }
+
+        void snapshot() { checksum += state.snapshot().current_player; }
+        void hash() { checksum += state.hash(); }
+        void computeHash() { checksum += state.computeHash(); }
+
+        void restore()
+        {
+            static const server::GameSnapshot SNAPSHOT = state.snapshot();
+            checksum += server::GameState(SNAPSHOT, PLAYERS).getCurrentPlayer().get<shared::HAND>().size();
+        }
+    };
+
+    /**
+     * @brief The reduced game state for every player, what the lobby sends out after each action. In between, the
+     * current player gains a Copper or gives it back, so one player changed since the last broadcast.
+     */
+    struct Broadcast
+    {
+        server::GameState state{KINGDOM, PLAYERS, 42};
+        const server::Player::card_id copper = "Copper";
+        bool gained = false;
+        size_t checksum = 0;
+
+        void unchanged()
+        {
+            for ( server::Player::seat_t seat = 0; seat < PLAYERS.size(); ++seat ) {
+                checksum += state.getReducedState(seat)->reduced_enemies.size();
+            }
+        }
+
+        void afterGain()
+        {
+            if ( gained ) {
+                state.getCurrentPlayer().take<shared::DISCARD_PILE>(copper);
+            } else {
+                state.getCurrentPlayer().gain(copper);
+            }
+            gained = !gained;
+            unchanged();
+        }
+    };
+
+    // a hand built up with God_Mode, which gives enough actions to play every drawing card of the deck
+    const std::vector<std::pair<const char *, size_t>> LARGE_HAND = {
+            {"God_Mode", 20}, {"Laboratory", 30}, {"Smithy", 20}, {"Village", 20}, {"Market", 20}, {"Copper", 30},
+            {"Silver", 20},   {"Gold", 15},       {"Estate", 10}, {"Duchy", 5},    {"Province", 10}};
+
+    /**
+     * @brief The reduced player of a large hand, built again after every change: a God_Mode is played and taken
+     * back into the hand.
+     */
+    struct LargeHand
+    {
+        server::Player player{"alice"};
+        const server::Player::card_id god_mode = "God_Mode";
+        size_t checksum = 0;
+
+        LargeHand()
+        {
+            std::vector<shared::CardId> hand;
+            for ( const auto &[card, count] : LARGE_HAND ) {
+                hand.insert(hand.end(), count, card);
+            }
+            std::shuffle(hand.begin(), hand.end(), std::mt19937(42));
+            player.add<shared::HAND>(hand);
+        }
+
+        void playAndTakeBack()
+        {
+            player.move<shared::HAND, shared::STAGED_CARDS>(god_mode);
+            checksum += player.getReducedPlayer()->getHandCards().size();
+            player.move<shared::STAGED_CARDS, shared::HAND>(god_mode);
+            checksum += player.getReducedPlayer()->getHandCards().size();
+        }
+    };
+
+    struct Game
+    {
+        server::GameInterface::ptr_t game;
+        size_t turn = 0;
+        inline static size_t failed_buys = 0;
+
+        Game() : game(server::GameInterface::make(GAME_ID, KINGDOM, PLAYERS)) { game->startGame(); }
+
+        void send(const server::Player::id_t &player_id, std::unique_ptr<shared::ActionDecision> decision)
+        {
+            // a fixed message id, generating uuids is not what we want to measure
+            std::unique_ptr<shared::ClientToServerMessage> message =
+                    std::make_unique<shared::ActionDecisionMessage>(GAME_ID, player_id, std::move(decision),
+                                                                    std::nullopt, "message");
+            game->handleMessage(message);
+        }
+
+        void playTurn()
+        {
+            const auto &player_id = PLAYERS[turn++ % PLAYERS.size()];
+            const auto state = game->getGameState(player_id);
+
+            std::unique_ptr<shared::ActionDecision> decision = std::make_unique<shared::EndTurnDecision>();
+            for ( const auto &buy : BUY_PRIORITY ) {
+                if ( state->reduced_player->getTreasure() >= buy.cost ) {
+                    decision = std::make_unique<shared::BuyCardDecision>(buy.card);
+                    break;
+                }
+            }
+            try {
+                send(player_id, std::move(decision));
+            } catch ( const std::exception & ) {
+                // the pile we wanted to buy from is empty
+                ++failed_buys;
+                send(player_id, std::make_unique<shared::EndTurnDecision>());
+            }
+
+            for ( const auto &id : PLAYERS ) {
+                game->getGameState(id);
+            }
+        }
+    };
+} // namespace
+
+int main()
+{
+    shared::Logger::initialize();
+    shared::Logger::setLevel(ERROR);
+
+    auto game = std::make_unique<Game>();
+    size_t games = 1;
+    auto stats = bench::measure(WARMUP, SAMPLES,
+                                [&]()
+                                {
+                                    if ( game->game->isGameOver() ) {
+                                        game = std::make_unique<Game>();
+                                        ++games;
+                                    }
+                                    game->playTurn();
+                                });
+
+    PlayerCards player_cards;
+    auto player_stats = bench::measure(WARMUP, SAMPLES, [&]() { player_cards.playTurn(); });
+    int score_checksum = 0;
+    auto score_stats =
+            bench::measure(WARMUP, SAMPLES, [&]() { score_checksum += player_cards.player.getVictoryPoints(); });
+
+    TopDeck top_deck;
+    auto top_deck_stats = bench::measure(WARMUP, SAMPLES, [&]() { top_deck.drawAndPutBack(); });
+
+    RejectedMoves rejected;
+    auto rejected_throw_stats = bench::measure(WARMUP, SAMPLES, [&]() { rejected.throwingState(); });
+    auto rejected_nothrow_stats = bench::measure(WARMUP, SAMPLES, [&]() { rejected.nothrowState(); });
+    auto rejected_interface_throw_stats = bench::measure(WARMUP, SAMPLES, [&]() { rejected.throwingInterface(); });
+    auto rejected_interface_nothrow_stats =
+            bench::measure(WARMUP, SAMPLES, [&]() { rejected.nothrowInterface(); });
+    if ( rejected.rejected != 4 * (WARMUP + SAMPLES) ) {
+        throw std::logic_error("a move that should have been rejected was made");
+    }
+
+    Fork fork;
+    auto fork_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.fork(); });
+    auto fork_play_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.forkAndPlay(); });
+    auto snapshot_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.snapshot(); });
+    auto restore_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.restore(); });
+    auto hash_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.hash(); });
+    auto compute_hash_stats = bench::measure(WARMUP, SAMPLES, [&]() { fork.computeHash(); });
+    const size_t fork_allocations_before = bench::AllocCounter::allocations;
+    for ( size_t i = 0; i < SAMPLES; ++i ) {
+        fork.fork();
+    }
+    const size_t fork_allocations = bench::AllocCounter::allocations - fork_allocations_before;
+
+    Broadcast broadcast;
+    auto broadcast_stats = bench::measure(WARMUP, SAMPLES, [&]() { broadcast.unchanged(); });
+    auto broadcast_gain_stats = bench::measure(WARMUP, SAMPLES, [&]() { broadcast.afterGain(); });
+
+    LargeHand large_hand;
+    auto large_hand_stats = bench::measure(WARMUP, SAMPLES, [&]() { large_hand.playAndTakeBack(); });
+
+    SupplyLookups supply;
+    auto supply_stats = bench::measure(WARMUP, SAMPLES, [&]() { supply.buy(); });
+    const size_t supply_allocations_before = bench::AllocCounter::allocations;
+    for ( size_t i = 0; i < SAMPLES; ++i ) {
+        supply.buy();
+    }
+    const size_t supply_allocations = bench::AllocCounter::allocations - supply_allocations_before;
+
+    bench::printHeader("game engine, 4 players, big money");
+    bench::printRow("turn", stats);
+    bench::printRow("card handling of one player", player_stats);
+    bench::printRow("victory points of one player", score_stats);
+    bench::printRow("draw and put back on top", top_deck_stats);
+    bench::printRow("supply pile lookups of a buy", supply_stats);
+    bench::printRow("rejected buy, exception", rejected_throw_stats);
+    bench::printRow("rejected buy, error code", rejected_nothrow_stats);
+    bench::printRow("rejected message, exception", rejected_interface_throw_stats);
+    bench::printRow("rejected message, error code", rejected_interface_nothrow_stats);
+    bench::printRow("fork of a game", fork_stats);
+    bench::printRow("fork and a turn in the fork", fork_play_stats);
+    bench::printRow("snapshot of a game", snapshot_stats);
+    bench::printRow("game from a snapshot", restore_stats);
+    bench::printRow("hash of a game", hash_stats);
+    bench::printRow("hash of a game from scratch", compute_hash_stats);
+    bench::printRow("reduced states, unchanged", broadcast_stats);
+    bench::printRow("reduced states, one changed", broadcast_gain_stats);
+    bench::printRow("God_Mode hand of 200, 2 changes", large_hand_stats);
+    std::printf("\n%zu games played, %.1f turns per game, %zu failed buys\n", games,
+                static_cast<double>(WARMUP + SAMPLES) / games, Game::failed_buys);
+    std::printf("%zu heap allocations in %zu supply pile lookups (checksum %zu)\n", supply_allocations,
+                SAMPLES, supply.checksum);
+    std::printf("%.1f heap allocations per fork (checksum %zu)\n",
+                static_cast<double>(fork_allocations) / SAMPLES, fork.checksum);
+    std::printf("score checksum %d, reduced states checksum %zu, large hand checksum %zu\n", score_checksum,
+                broadcast.checksum, large_hand.checksum);
+
+    game.reset();
+    const size_t bytes_before = bench::AllocCounter::live_bytes;
+    game = std::make_unique<Game>();
+    const size_t allocations_before = bench::AllocCounter::allocations;
+    for ( size_t i = 0; i < MEMORY_TURNS; ++i ) {
+        game->playTurn();
+    }
+    std::printf("%.1f heap allocations per turn, %zu heap bytes held by a game after %zu turns\n",
+                static_cast<double>(bench::AllocCounter::allocations - allocations_before) / MEMORY_TURNS,
+                bench::AllocCounter::live_bytes - bytes_before, MEMORY_TURNS);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * Many simulated players talking to the server: one socket per player vs. one multiplexed socket for all of them.
+ * Every round each player sends one request and waits for its answer (all requests of a round are in flight at once).
+ */
+
+#include <string>
+#include <vector>
+
+#include <shared/message_types.h>
+
+#include "bench_utils.h"
+#include "server_fixture.h"
+
+namespace
+{
+    constexpr uint16_t PORT = 50516;
+    // stays well below the default limit of 1024 file descriptors (client and server side live in this process)
+    constexpr size_t PLAYERS = 200;
+    constexpr size_t WARMUP = 10;
+    constexpr size_t ROUNDS = 200;
+
+    std::string requestFor(const std::string &player_id)
+    {
+        // the lobby does not exist, so the server answers every request with a ResultResponseMessage
+        return shared::GameStateRequestMessage("no_such_lobby", player_id).toJson();
+    }
+} // namespace
+
+int main()
+{
+    bench::startServer(PORT);
+
+    std::vector<bench::FramedClient> clients;
+    std::vector<std::string> requests;
+    auto connect_start = bench::clock::now();
+    for ( size_t i = 0; i < PLAYERS; ++i ) {
+        clients.push_back(bench::FramedClient::connectTcp(server::DEFAULT_SERVER_HOST, PORT));
+        requests.push_back(requestFor("socket_player_" + std::to_string(i)));
+    }
+    auto sockets_connect = bench::clock::now() - connect_start;
+
+    connect_start = bench::clock::now();
+    bench::FramedClient mux = bench::FramedClient::connectTcp(server::DEFAULT_SERVER_HOST, PORT);
+    std::vector<std::string> mux_requests;
+    for ( size_t i = 0; i < PLAYERS; ++i ) {
+        mux_requests.push_back(requestFor("mux_player_" + std::to_string(i)));
+    }
+    auto mux_connect = bench::clock::now() - connect_start;
+
+    auto socket_round = [&]() {
+        for ( size_t i = 0; i < PLAYERS; ++i ) {
+            clients[i].send(requests[i]);
+        }
+        for ( auto &client : clients ) {
+            client.receive();
+        }
+    };
+    auto mux_round = [&]() {
+        for ( size_t i = 0; i < PLAYERS; ++i ) {
+            mux.send(mux_requests[i], static_cast<server::channel_id_t>(i));
+        }
+        for ( size_t i = 0; i < PLAYERS; ++i ) {
+            mux.receiveFrame();
+        }
+    };
+
+    bench::printHeader("One round of " + std::to_string(PLAYERS) + " players");
+    bench::printRow("one socket per player", bench::measure(WARMUP, ROUNDS, socket_round));
+    bench::printRow("one multiplexed socket", bench::measure(WARMUP, ROUNDS, mux_round));
+
+    auto to_ms = [](bench::clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::printf("\nconnection setup: %zu sockets / server threads: %.2f ms, multiplexed: 1 socket / server thread: "
+                "%.2f ms\n",
+                PLAYERS, to_ms(sockets_connect), to_ms(mux_connect));
+
+    bench::exitBenchmark();
+}
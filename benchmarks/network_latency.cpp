@@ -0,0 +1,46 @@
+/**
+ * Round-trip latency of a request through the full server (framing, parsing, lobby dispatch, response),
+ * once over loopback TCP and once over the Unix-domain listener.
+ */
+
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+#include <shared/message_types.h>
+
+#include "bench_utils.h"
+#include "server_fixture.h"
+
+namespace
+{
+    constexpr uint16_t PORT = 50515;
+    constexpr size_t WARMUP = 1'000;
+    constexpr size_t ITERATIONS = 20'000;
+
+    bench::LatencyStats roundTrips(bench::FramedClient &client, const std::string &player_id)
+    {
+        // the lobby does not exist, so the server answers every request with a ResultResponseMessage
+        const std::string request = shared::GameStateRequestMessage("no_such_lobby", player_id).toJson();
+        return bench::measure(WARMUP, ITERATIONS, [&]() {
+            client.send(request);
+            client.receive();
+        });
+    }
+} // namespace
+
+int main()
+{
+    const std::string unix_path = "/tmp/dominion_bench_" + std::to_string(getpid()) + ".sock";
+    bench::startServer(PORT, unix_path);
+
+    bench::FramedClient tcp_client = bench::FramedClient::connectTcp(server::DEFAULT_SERVER_HOST, PORT);
+    bench::FramedClient unix_client = bench::FramedClient::connectUnix(unix_path);
+
+    bench::printHeader("Request round trip through the server");
+    bench::printRow("tcp loopback", roundTrips(tcp_client, "tcp_player"));
+    bench::printRow("unix socket", roundTrips(unix_client, "unix_player"));
+
+    unlink(unix_path.c_str());
+    bench::exitBenchmark();
+}
@@ -0,0 +1,225 @@
+/**
+ * Cost of turning the messages the server sends most often into JSON: the game state message, that goes to every
+ * player after each action, and an action order with the game state in it. The messages are written straight to a
+ * rapidjson::Writer (what toJson() does), and for comparison built as a Document out of the nested Documents of the
+ * game state, the board, the players and the order, which are copied into their parent and then turned into a string.
+ * Also reports the heap allocations per message. rapidjson allocates with malloc and not with operator new, so this
+ * benchmark counts the calls of malloc, calloc and realloc instead of using alloc_counter.h (glibc only, and not with
+ * AddressSanitizer, which replaces malloc itself).
+ * The other way round, an action decision of a client is parsed with ClientToServerMessage::fromJson, which reads it
+ * with a SAX handler, and only into a Document for comparison (the first half of what fromJson did before). Debug
+ * builds parse every message both ways, so only the numbers of a release build mean anything.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <server/game/game_state.h>
+#include <shared/message_types.h>
+#include <shared/utils/json.h>
+#include <shared/utils/logger.h>
+
+#include "bench_utils.h"
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define BENCH_ASAN 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define BENCH_ASAN 1
+#endif
+
+#if defined(__GLIBC__) && !defined(BENCH_ASAN)
+#define BENCH_COUNT_MALLOC 1
+
+namespace
+{
+    std::atomic<size_t> malloc_calls = 0;
+} // namespace
+
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void __libc_free(void *ptr);
+
+    void *malloc(size_t size)
+    {
+        malloc_calls.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        malloc_calls.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        malloc_calls.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void *ptr) { __libc_free(ptr); }
+}
+#endif
+
+namespace
+{
+    constexpr size_t WARMUP = 2'000;
+    constexpr size_t SAMPLES = 20'000;
+
+    const std::vector<shared::CardBase::id_t> KINGDOM_CARDS = {"Village", "Smithy",       "Festival", "Market",
+                                                               "Laboratory", "Council_Room", "Witch",    "Moat",
+                                                               "Cellar",     "Chapel"};
+
+    // ======= THE MESSAGES AS DOCUMENTS, AS THEY WERE WRITTEN BEFORE ======= //
+
+    rapidjson::Document documentFromMsg(const std::string &type, const shared::Message &msg)
+    {
+        rapidjson::Document doc;
+        doc.SetObject();
+        ADD_STRING_MEMBER(type.c_str(), type);
+        ADD_STRING_MEMBER(msg.game_id.c_str(), game_id);
+        ADD_STRING_MEMBER(msg.message_id.c_str(), message_id);
+        return doc;
+    }
+
+    // the nested documents of reduced::GameState::toJson() are copied into the message, as they were before
+    void addGameState(rapidjson::Document &doc, const reduced::GameState &game_state)
+    {
+        rapidjson::Document game_state_doc = game_state.toJson();
+        rapidjson::Value game_state_value;
+        game_state_value.CopyFrom(game_state_doc, doc.GetAllocator());
+        doc.AddMember("game_state", game_state_value, doc.GetAllocator());
+    }
+
+    std::string documentJson(const shared::GameStateMessage &msg)
+    {
+        rapidjson::Document doc = documentFromMsg("game_state", msg);
+        addGameState(doc, *msg.game_state);
+        ADD_OPTIONAL_STRING_MEMBER(msg.in_response_to, in_response_to);
+        return documentToString(doc);
+    }
+
+    std::string documentJson(const shared::ActionOrderMessage &msg)
+    {
+        rapidjson::Document doc = documentFromMsg("action_order", msg);
+        rapidjson::Document order_json = msg.order->toJson();
+        doc.AddMember("order", order_json, doc.GetAllocator());
+        addGameState(doc, *msg.game_state);
+        ADD_OPTIONAL_STRING_MEMBER(msg.description, description);
+        return documentToString(doc);
+    }
+
+    // ======= BENCHMARK ======= //
+
+    /**
+     * @brief A message that is written or parsed, run returns the size of the result for the checksum.
+     */
+    struct Case
+    {
+        std::string name;
+        std::function<size_t()> run;
+    };
+
+    /**
+     * @brief Average number of malloc, calloc and realloc calls of one call of run, or -1 if they are not counted in
+     * this build.
+     */
+    double mallocsPerMessage(const Case &bench_case, size_t &checksum)
+    {
+#ifdef BENCH_COUNT_MALLOC
+        const size_t before = malloc_calls.load(std::memory_order_relaxed);
+        for ( size_t i = 0; i < SAMPLES; ++i ) {
+            checksum += bench_case.run();
+        }
+        return static_cast<double>(malloc_calls.load(std::memory_order_relaxed) - before) / SAMPLES;
+#else
+        checksum += bench_case.run();
+        return -1;
+#endif
+    }
+} // namespace
+
+int main()
+{
+    shared::Logger::initialize();
+    shared::Logger::setLevel(ERROR);
+
+    // a game in its first turn, with a few cards bought and played so that no pile of the state is empty
+    server::GameState game(KINGDOM_CARDS, {"alice", "bob", "carol", "dave"}, 42);
+    game.getCurrentPlayer().gain("Gold");
+    game.getCurrentPlayer().gain("Province");
+    game.getBoard()->trashCard("Copper");
+    game.getBoard()->addToPlayedCards("Village");
+
+    const shared::GameStateMessage game_state_msg("game", game.getReducedState(size_t{0}), std::nullopt, "message");
+    const shared::ActionOrderMessage action_order_msg(
+            "game",
+            std::make_unique<shared::ChooseFromHandOrder>(0, 4, shared::ChooseFromOrder::AllowedChoice::DISCARD),
+            game.getReducedState(size_t{1}), "Cellar: discard any number of cards", "message");
+    const shared::ResultResponseMessage result_msg("game", true, "request", std::nullopt, "message");
+
+    if ( game_state_msg.toJson() != documentJson(game_state_msg) ||
+         action_order_msg.toJson() != documentJson(action_order_msg) ) {
+        std::fprintf(stderr, "the writer and the documents give different JSON\n");
+        return 1;
+    }
+
+    const std::string decision_json =
+            shared::ActionDecisionMessage(
+                    "game", "alice",
+                    std::make_unique<shared::DeckChoiceDecision>(
+                            std::vector<shared::CardBase::id_t>{"Copper", "Estate", "Estate"},
+                            std::vector<shared::ChooseFromOrder::AllowedChoice>(
+                                    3, shared::ChooseFromOrder::AllowedChoice::DISCARD)),
+                    "order", "message")
+                    .toJson();
+
+    const std::vector<Case> cases = {
+            {"game_state, writer", [&] { return game_state_msg.toJson().size(); }},
+            {"game_state, nested documents", [&] { return documentJson(game_state_msg).size(); }},
+            {"action_order, writer", [&] { return action_order_msg.toJson().size(); }},
+            {"action_order, nested documents", [&] { return documentJson(action_order_msg).size(); }},
+            {"result_response, writer", [&] { return result_msg.toJson().size(); }},
+            {"action_decision, fromJson",
+             [&] { return static_cast<size_t>(shared::ClientToServerMessage::fromJson(decision_json)->getKind()); }},
+            {"action_decision, Document only",
+             [&]
+             {
+                 rapidjson::Document doc;
+                 doc.Parse(decision_json.c_str());
+                 return static_cast<size_t>(doc.MemberCount());
+             }},
+    };
+
+    size_t checksum = 0;
+    bench::printHeader("message serialization, 4 players");
+    for ( const auto &bench_case : cases ) {
+        bench::printRow(bench_case.name,
+                        bench::measure(WARMUP, SAMPLES, [&] { checksum += bench_case.run(); }));
+    }
+
+    std::printf("\n%-32s %12s\n", "case", "mallocs");
+    for ( const auto &bench_case : cases ) {
+        const double mallocs = mallocsPerMessage(bench_case, checksum);
+        if ( mallocs < 0 ) {
+            std::printf("%-32s %12s\n", bench_case.name.c_str(), "n/a");
+        } else {
+            std::printf("%-32s %12.1f\n", bench_case.name.c_str(), mallocs);
+        }
+    }
+    std::printf("\nchecksum %zu\n", checksum);
+}
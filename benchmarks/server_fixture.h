@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include <server/network/server_network_manager.h>
+#include <shared/utils/logger.h>
+
+namespace bench
+{
+    /**
+     * @brief Runs a full server (network, lobbies, games) inside the benchmark process.
+     *
+     * The server never returns, so it lives in a detached thread and benchmarks end with exitBenchmark().
+     */
+    inline void startServer(uint16_t port, const std::string &unix_socket_path = "",
+                            const server::SocketOptions &socket_options = {})
+    {
+        shared::Logger::initialize();
+        shared::Logger::setLevel(ERROR);
+
+        std::thread server_thread([port, unix_socket_path, socket_options]() {
+            server::ServerNetworkManager server(socket_options);
+            server.run(server::DEFAULT_SERVER_HOST, port, unix_socket_path);
+        });
+        server_thread.detach();
+    }
+
+    /**
+     * @brief Runs a server in a child process, for benchmarks that need several differently configured servers.
+     * Must be called before the benchmark starts any threads.
+     */
+    inline pid_t forkServer(uint16_t port, const server::SocketOptions &socket_options = {})
+    {
+        // the child would print the buffered output a second time
+        std::fflush(stdout);
+        pid_t pid = fork();
+        if ( pid == 0 ) {
+            shared::Logger::initialize();
+            shared::Logger::setLevel(ERROR);
+            server::ServerNetworkManager server(socket_options);
+            server.run(server::DEFAULT_SERVER_HOST, port);
+            std::_Exit(1);
+        }
+        return pid;
+    }
+
+    inline void stopServer(pid_t pid)
+    {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+    }
+
+    /**
+     * @brief A port that is unlikely to be taken by an earlier run of the same benchmark (still in TIME_WAIT).
+     */
+    inline uint16_t pickPort(uint16_t base) { return static_cast<uint16_t>(base + getpid() % 1000 * 10); }
+
+    /**
+     * @brief Ends the process without running static destructors, the server threads are still blocked in accept().
+     */
+    [[noreturn]] inline void exitBenchmark()
+    {
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+} // namespace bench
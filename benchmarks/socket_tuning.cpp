@@ -0,0 +1,136 @@
+/**
+ * Round-trip time of a BuyCardDecision in a running two player game, for different socket options of the server.
+ * Each configuration gets its own server process, the bots alternate buying a Copper.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <shared/action_decision.h>
+#include <shared/message_types.h>
+
+#include "bench_utils.h"
+#include "server_fixture.h"
+
+namespace
+{
+    constexpr uint16_t BASE_PORT = 40000;
+    constexpr size_t WARMUP = 200;
+    constexpr size_t SAMPLES = 2'000;
+    // a two player game starts with 46 Coppers in the supply
+    constexpr size_t BUYS_PER_GAME = 40;
+
+    const std::vector<shared::CardBase::id_t> KINGDOM = {"Village",    "Smithy",       "Festival", "Market", "Laboratory",
+                                                         "Council_Room", "Witch", "Moat", "Cellar", "Chapel"};
+
+    struct Bot
+    {
+        std::string id;
+        bench::FramedClient client;
+
+        template <typename T>
+        std::unique_ptr<T> waitFor()
+        {
+            while ( true ) {
+                auto message = shared::ServerToClientMessage::fromJson(client.receive());
+                if ( auto *result = dynamic_cast<shared::ResultResponseMessage *>(message.get());
+                     result != nullptr && !result->success ) {
+                    throw std::runtime_error("server rejected a request: " + result->additional_information.value_or(""));
+                }
+                if ( dynamic_cast<T *>(message.get()) != nullptr ) {
+                    return std::unique_ptr<T>(static_cast<T *>(message.release()));
+                }
+            }
+        }
+    };
+
+    // returns the index of the player that is on turn
+    size_t startGame(Bot (&bots)[2], const std::string &lobby_id)
+    {
+        bots[0].client.send(shared::CreateLobbyRequestMessage(lobby_id, bots[0].id).toJson());
+        bots[0].waitFor<shared::CreateLobbyResponseMessage>();
+        bots[1].client.send(shared::JoinLobbyRequestMessage(lobby_id, bots[1].id).toJson());
+        bots[1].waitFor<shared::JoinLobbyBroadcastMessage>();
+        bots[0].waitFor<shared::JoinLobbyBroadcastMessage>();
+
+        bots[0].client.send(shared::StartGameRequestMessage(lobby_id, bots[0].id, KINGDOM).toJson());
+        size_t current = 0;
+        for ( size_t i = 0; i < 2; ++i ) {
+            bots[i].waitFor<shared::StartGameBroadcastMessage>();
+            auto first = shared::ServerToClientMessage::fromJson(bots[i].client.receive());
+            if ( dynamic_cast<shared::ActionOrderMessage *>(first.get()) != nullptr ) {
+                current = i;
+            }
+        }
+        return current;
+    }
+
+    bench::LatencyStats buyRoundTrips(uint16_t port)
+    {
+        Bot bots[2] = {{"bot_a", bench::FramedClient::connectTcp(server::DEFAULT_SERVER_HOST, port)},
+                       {"bot_b", bench::FramedClient::connectTcp(server::DEFAULT_SERVER_HOST, port)}};
+
+        std::vector<bench::clock::duration> samples;
+        for ( size_t game = 0; samples.size() < WARMUP + SAMPLES; ++game ) {
+            const std::string lobby_id = "bench_lobby_" + std::to_string(game);
+            size_t current = startGame(bots, lobby_id);
+
+            for ( size_t buy = 0; buy < BUYS_PER_GAME && samples.size() < WARMUP + SAMPLES; ++buy ) {
+                const std::string request =
+                        shared::ActionDecisionMessage(lobby_id, bots[current].id,
+                                                      std::make_unique<shared::BuyCardDecision>("Copper"))
+                                .toJson();
+
+                auto start = bench::clock::now();
+                bots[current].client.send(request);
+                bots[current].client.receive();
+                samples.push_back(bench::clock::now() - start);
+
+                // buying with the only buy ends the turn, the other bot gets its order
+                bots[1 - current].client.receive();
+                current = 1 - current;
+            }
+        }
+
+        samples.erase(samples.begin(), samples.begin() + WARMUP);
+        return bench::summarize(std::move(samples));
+    }
+} // namespace
+
+int main()
+{
+    struct Setting
+    {
+        std::string name;
+        server::SocketOptions options;
+    };
+
+    std::vector<Setting> settings(7);
+    settings[0].name = "defaults";
+    settings[1].name = "tcp-nodelay";
+    settings[1].options.tcp_nodelay = true;
+    settings[2].name = "tcp-cork";
+    settings[2].options.tcp_cork = true;
+    settings[3].name = "tcp-nodelay + tcp-cork";
+    settings[3].options.tcp_nodelay = true;
+    settings[3].options.tcp_cork = true;
+    settings[4].name = "4 KiB send/receive buffers";
+    settings[4].options.send_buffer_size = 4 * 1024;
+    settings[4].options.receive_buffer_size = 4 * 1024;
+    settings[5].name = "1 MiB send/receive buffers";
+    settings[5].options.send_buffer_size = 1024 * 1024;
+    settings[5].options.receive_buffer_size = 1024 * 1024;
+    settings[6].name = "busy-poll 50us";
+    settings[6].options.busy_poll_us = 50;
+
+    bench::printHeader("BuyCardDecision round trip (2 player game, TCP loopback)");
+    for ( size_t i = 0; i < settings.size(); ++i ) {
+        const uint16_t port = bench::pickPort(BASE_PORT) + i;
+        pid_t server = bench::forkServer(port, settings[i].options);
+        bench::printRow(settings[i].name, buyRoundTrips(port));
+        bench::stopServer(server);
+    }
+
+    return 0;
+}
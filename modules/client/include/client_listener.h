@@ -1,14 +1,14 @@
 #pragma once
 
 #include <wx/wx.h>
-#include "sockpp/tcp_connector.h"
+#include "sockpp/connector.h"
 
 
 class ClientListener : public wxThread
 {
 
 public:
-    ClientListener(sockpp::tcp_connector *connection);
+    ClientListener(sockpp::connector *connection);
     ~ClientListener() override;
 
     void shutdown();
@@ -21,7 +21,7 @@ private:
     bool isActive();
 
 
-    sockpp::tcp_connector *_connection;
+    sockpp::connector *_connection;
 
     bool _isActive;
 };
@@ -4,12 +4,21 @@
 #include <string>
 #include "client_listener.h"
 #include "shared/message_types.h"
-#include "sockpp/tcp_connector.h"
+#include "sockpp/connector.h"
 
 class ClientNetworkManager
 {
 
 public:
+    // hosts of the form "unix:/path/to/socket" connect to a Unix-domain socket of a server on the same machine
+    inline static const std::string UNIX_HOST_PREFIX = "unix:";
+
+    /**
+     * @brief Connects to the server and starts the listener thread.
+     *
+     * @param host either a TCP host name or UNIX_HOST_PREFIX followed by a socket path (the port is ignored then)
+     * @param port
+     */
     static void init(const std::string &host, const uint16_t port);
 
     static void sendRequest(std::unique_ptr<shared::ClientToServerMessage> req);
@@ -24,7 +33,7 @@ private:
     static bool connect(const std::string &host, const uint16_t port);
 
 
-    static sockpp::tcp_connector *_connection;
+    static sockpp::connector *_connection;
     static ClientListener *_listener;
 
     static bool _connection_success;
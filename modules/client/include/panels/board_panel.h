@@ -102,10 +102,10 @@ namespace client
         KingdomPiles_.clear();
         CursePiles_.clear();
 
-        const auto &VictoryCards = board->getVictoryCards();
-        const auto &TreasureCards = board->getTreasureCards();
-        const auto &KingdomCards = board->getKingdomCards();
-        const auto CurseCards = shared::Board::pile_container_t({board->getCurseCardPile()});
+        const auto VictoryCards = board->getVictoryCards();
+        const auto TreasureCards = board->getTreasureCards();
+        const auto KingdomCards = board->getKingdomCards();
+        const auto CurseCards = shared::Board::pile_container_t(&board->getCurseCardPile(), 1);
 
         // use a grid bag sizer that allow us to place the cards in a grid
         // and not fill all spaces
@@ -7,7 +7,7 @@
 #include "client_network_manager.h"
 
 
-ClientListener::ClientListener(sockpp::tcp_connector *connection) :
+ClientListener::ClientListener(sockpp::connector *connection) :
     wxThread(wxTHREAD_DETACHED), _connection(connection), _isActive(true)
 {}
 
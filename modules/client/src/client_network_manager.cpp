@@ -8,10 +8,11 @@
 
 #include <shared/utils/logger.h>
 #include <sockpp/tcp_connector.h>
+#include <sockpp/unix_connector.h>
 #include <sstream>
 
 // initialize static members
-sockpp::tcp_connector *ClientNetworkManager::_connection = nullptr;
+sockpp::connector *ClientNetworkManager::_connection = nullptr;
 ClientListener *ClientNetworkManager::_listener = nullptr;
 
 bool ClientNetworkManager::_connection_success = false;
@@ -38,12 +39,18 @@ void ::ClientNetworkManager::init(const std::string &host, const uint16_t port)
         delete ClientNetworkManager::_connection;
         LOG(INFO) << "Removed old connection";
     }
-    ClientNetworkManager::_connection = new sockpp::tcp_connector();
+    const bool is_unix = host.rfind(UNIX_HOST_PREFIX, 0) == 0;
+    if ( is_unix ) {
+        ClientNetworkManager::_connection = new sockpp::unix_connector();
+    } else {
+        ClientNetworkManager::_connection = new sockpp::tcp_connector();
+    }
 
     // try to connect to server
     if ( ClientNetworkManager::connect(host, port) ) {
-        LOG(INFO) << "Connected to " << host << ":" << std::to_string(port);
-        wxGetApp().getController().showStatus("Connected to " + host + ":" + std::to_string(port));
+        const std::string target = is_unix ? host : host + ":" + std::to_string(port);
+        LOG(INFO) << "Connected to " << target;
+        wxGetApp().getController().showStatus("Connected to " + target);
         ClientNetworkManager::_connection_success = true;
         // start network thread
         ClientNetworkManager::_listener = new ClientListener(ClientNetworkManager::_connection);
@@ -65,16 +72,21 @@ bool ClientNetworkManager::connect(const std::string &host, const uint16_t port)
 {
     try {
 
-        // create sockpp address and catch any errors
-        sockpp::inet_address address = sockpp::inet_address(host, port);
-
         // set a timeout of 3 seconds for the connection
         auto timeout = std::chrono::seconds(3);
 
+        // create sockpp address and catch any errors
+        std::unique_ptr<sockpp::sock_address> address;
+        if ( host.rfind(UNIX_HOST_PREFIX, 0) == 0 ) {
+            address = std::make_unique<sockpp::unix_address>(host.substr(UNIX_HOST_PREFIX.size()));
+        } else {
+            address = std::make_unique<sockpp::inet_address>(host, port);
+        }
+
         // establish connection to given address
-        if ( !ClientNetworkManager::_connection->connect(host, port, timeout) ) {
+        if ( !ClientNetworkManager::_connection->connect(*address, timeout) ) {
             wxGetApp().getController().showError("Connection error",
-                                                 "Failed to connect to server " + address.to_string());
+                                                 "Failed to connect to server " + host);
             return false;
         }
     } catch ( const std::exception &e ) {
@@ -121,7 +133,7 @@ void ClientNetworkManager::sendRequest(std::unique_ptr<shared::ClientToServerMes
         sockpp::result<size_t> result = ClientNetworkManager::_connection->write(msg);
 
         if ( result.is_error() ) {
-            LOG(ERROR) << "Error writing to TCP stream: " << result.error_message();
+            LOG(ERROR) << "Error writing to stream: " << result.error_message();
         }
 
         // if the number of bytes sent does not match the length of the msg, probably something went wrong
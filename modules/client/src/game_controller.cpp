@@ -427,21 +427,25 @@ namespace client
     {
 // NOLINTBEGIN(bugprone-macro-parentheses)
 #define HANDLE_MESSAGE(type)                                                                                           \
-    if ( typeid(msgRef) == typeid(type) ) {                                                                            \
-        LOG(INFO) << "Received message of type " << #type;                                                             \
-        std::unique_ptr<type> casted(static_cast<type *>(msg.release()));                                              \
-        receive##type(std::move(casted));                                                                              \
-        return;                                                                                                        \
-    }
+    case type::KIND:                                                                                                   \
+        {                                                                                                              \
+            LOG(INFO) << "Received message of type " << #type;                                                         \
+            std::unique_ptr<type> casted(static_cast<type *>(msg.release()));                                          \
+            receive##type(std::move(casted));                                                                          \
+            return;                                                                                                    \
+        }
         // NOLINTEND(bugprone-macro-parentheses)
-        ServerToClientMessage &msgRef = *msg;
-        HANDLE_MESSAGE(ActionOrderMessage);
-        HANDLE_MESSAGE(CreateLobbyResponseMessage);
-        HANDLE_MESSAGE(JoinLobbyBroadcastMessage);
-        HANDLE_MESSAGE(ResultResponseMessage);
-        HANDLE_MESSAGE(GameStateMessage);
-        HANDLE_MESSAGE(StartGameBroadcastMessage);
-        HANDLE_MESSAGE(EndGameBroadcastMessage);
+        switch ( msg->getKind() ) {
+            HANDLE_MESSAGE(ActionOrderMessage);
+            HANDLE_MESSAGE(CreateLobbyResponseMessage);
+            HANDLE_MESSAGE(JoinLobbyBroadcastMessage);
+            HANDLE_MESSAGE(ResultResponseMessage);
+            HANDLE_MESSAGE(GameStateMessage);
+            HANDLE_MESSAGE(StartGameBroadcastMessage);
+            HANDLE_MESSAGE(EndGameBroadcastMessage);
+            default:
+                break;
+        }
 #undef HANDLE_MESSAGE
 
         LOG(ERROR) << "Unknown message type";
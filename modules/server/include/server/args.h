@@ -1,4 +1,5 @@
 
+#include <server/network/socket_options.h>
 #include <shared/utils/logger.h>
 
 namespace server
@@ -11,12 +12,22 @@ namespace server
         std::string getLogFile();
         LogLevel getLogLevel();
         uint16_t getPort();
+        /**
+         * @brief Path of the Unix-domain socket to listen on in addition to TCP, empty if disabled.
+         */
+        std::string getUnixSocket();
+        /**
+         * @brief Socket tuning of client connections.
+         */
+        SocketOptions getSocketOptions();
         bool isDebug();
 
     private:
         std::string _logFile;
         LogLevel _logLevel;
         uint16_t _port;
+        std::string _unixSocket;
+        SocketOptions _socketOptions;
         bool _debug;
     };
 } // namespace server
@@ -1,8 +1,18 @@
 #pragma once
+#include <coroutine>
+#include <exception>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
 #include <server/game/game_state.h>
 #include <server/message/order_response.h>
 #include <shared/message_types.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/logger.h>
+#include <shared/utils/utils.h>
 
 namespace server
 {
@@ -24,7 +34,10 @@ namespace server
             Behaviour() : finished_behaviour(false) {}
             virtual ~Behaviour() = default;
 
-            virtual ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &player_id,
+            /**
+             * @param player the seat of the player who made the decision, or of the current player if there is none
+             */
+            virtual ret_t apply(server::GameState &state, shared::PlayerBase::seat_t player,
                                 action_decision_t action_decision = std::nullopt) = 0;
 
             /**
@@ -33,7 +46,215 @@ namespace server
              */
             bool isDone() const { return finished_behaviour; }
         };
+
+        /**
+         * @brief A behaviour that needs decisions of the players, written as a C++20 coroutine.
+         *
+         * run() is called once, when the behaviour is applied the first time. Whenever it needs a decision it sends
+         * out an order and suspends:
+         *
+         *     auto cost = co_await ask<shared::DeckChoiceDecision>(order, [&](auto player, auto &decision) {
+         *         // validate and apply the decision, throw if it is not allowed
+         *         return ...;
+         *     });
+         *
+         * The next apply() passes its decision to the handler of the ask. If the handler throws, the exception goes
+         * back to the caller and the behaviour keeps waiting for another decision. Otherwise the coroutine continues
+         * right after the co_await with whatever the handler returned, so the behaviour never has to find out which
+         * step it is at. The behaviour is done when run() returns.
+         *
+         * The coroutine frame is allocated with the allocator of the behaviour, which is the arena of the
+         * BehaviourChain, and destroyed with the behaviour.
+         */
+        class CoBehaviour : public Behaviour
+        {
+        public:
+            // lets std::pmr::polymorphic_allocator::new_object pass the arena of the behaviour
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            struct Promise;
+            using handle_t = std::coroutine_handle<Promise>;
+
+            /**
+             * @brief What run() returns. The frame belongs to the CoBehaviour that called run().
+             */
+            struct Task
+            {
+                using promise_type = Promise;
+                handle_t handle;
+            };
+
+            struct Promise
+            {
+                // the order to send and how to take the decision, set by the ask the coroutine is suspended at
+                ret_t order;
+                void *awaiter = nullptr;
+                void (*accept)(void *awaiter, shared::PlayerBase::seat_t player,
+                               std::unique_ptr<shared::ActionDecision> &decision) = nullptr;
+                std::exception_ptr exception;
+
+                // not an aggregate, otherwise the arguments of run() would be used to initialize the members
+                Promise() = default;
+
+                Task get_return_object() { return {handle_t::from_promise(*this)}; }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                std::suspend_always final_suspend() noexcept { return {}; }
+                void return_void() {}
+                void unhandled_exception() { exception = std::current_exception(); }
+
+                /**
+                 * @brief Allocates the frame of run() from the allocator of the behaviour (the first argument of a
+                 * member coroutine is the object). The memory resource is stored behind the frame for operator delete.
+                 */
+                static void *operator new(size_t size, CoBehaviour &self, server::GameState & /*game_state*/,
+                                          shared::PlayerBase::seat_t & /*requestor*/)
+                {
+                    std::pmr::memory_resource *resource = self.allocator.resource();
+                    void *memory =
+                            resource->allocate(resourceOffset(size) + sizeof(resource), alignof(std::max_align_t));
+                    *reinterpret_cast<std::pmr::memory_resource **>(static_cast<std::byte *>(memory) +
+                                                                    resourceOffset(size)) = resource;
+                    return memory;
+                }
+
+                static void operator delete(void *memory, size_t size)
+                {
+                    auto *resource = *reinterpret_cast<std::pmr::memory_resource **>(static_cast<std::byte *>(memory) +
+                                                                                     resourceOffset(size));
+                    resource->deallocate(memory, resourceOffset(size) + sizeof(resource), alignof(std::max_align_t));
+                }
+
+            private:
+                static constexpr size_t resourceOffset(size_t size)
+                {
+                    constexpr size_t alignment = alignof(std::pmr::memory_resource *);
+                    return (size + alignment - 1) / alignment * alignment;
+                }
+            };
+
+            explicit CoBehaviour(const allocator_type &allocator = {}) : allocator(allocator) {}
+            ~CoBehaviour() override
+            {
+                if ( frame ) {
+                    frame.destroy();
+                }
+            }
+            // the frame belongs to this object
+            CoBehaviour(const CoBehaviour &) = delete;
+            CoBehaviour &operator=(const CoBehaviour &) = delete;
+
+            inline ret_t apply(server::GameState &game_state, shared::PlayerBase::seat_t player,
+                               action_decision_t action_decision = std::nullopt) final;
+
+        protected:
+            /**
+             * @brief The steps of the behaviour.
+             */
+            virtual Task run(server::GameState &game_state, shared::PlayerBase::seat_t requestor) = 0;
+
+            /**
+             * @brief Sends out order and waits for a decision of DecisionType, see the description of the class.
+             * @param handler is called with the seat of the deciding player and the decision, it throws if the
+             * decision is not allowed. Its return value is the value of the co_await.
+             */
+            template <typename DecisionType, typename Handler>
+            static auto ask(ret_t order, Handler handler);
+
+        private:
+            template <typename DecisionType, typename Handler>
+            struct DecisionAwaiter;
+
+            allocator_type allocator;
+            handle_t frame;
+        };
+
+        template <typename DecisionType, typename Handler>
+        struct CoBehaviour::DecisionAwaiter
+        {
+            using result_t = std::invoke_result_t<Handler &, shared::PlayerBase::seat_t, DecisionType &>;
+
+            ret_t order;
+            Handler handler;
+            std::conditional_t<std::is_void_v<result_t>, std::monostate, std::optional<result_t>> result;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(handle_t handle) noexcept
+            {
+                auto &promise = handle.promise();
+                promise.order = std::move(order);
+                promise.awaiter = this;
+                promise.accept = &accept;
+            }
+
+            result_t await_resume()
+            {
+                if constexpr ( !std::is_void_v<result_t> ) {
+                    return std::move(*result);
+                }
+            }
+
+            static void accept(void *self, shared::PlayerBase::seat_t player,
+                               std::unique_ptr<shared::ActionDecision> &decision)
+            {
+                auto *awaiter = static_cast<DecisionAwaiter *>(self);
+                auto *typed_decision = shared::decisionCast<DecisionType>(decision.get());
+                if ( typed_decision == nullptr ) {
+                    LOG(ERROR) << "Decision of the player at seat " << player << " has the wrong type! Expected: "
+                               << utils::demangle(typeid(DecisionType).name());
+                    throw std::runtime_error("Decision type is not allowed!");
+                }
+
+                if constexpr ( std::is_void_v<result_t> ) {
+                    awaiter->handler(player, *typed_decision);
+                } else {
+                    awaiter->result.emplace(awaiter->handler(player, *typed_decision));
+                }
+            }
+        };
+
+        template <typename DecisionType, typename Handler>
+        auto CoBehaviour::ask(ret_t order, Handler handler)
+        {
+            return DecisionAwaiter<DecisionType, Handler>{std::move(order), std::move(handler), {}};
+        }
+
+        inline CoBehaviour::ret_t CoBehaviour::apply(server::GameState &game_state, shared::PlayerBase::seat_t player,
+                                                     action_decision_t action_decision)
+        {
+            if ( !frame ) {
+                if ( action_decision.has_value() ) {
+                    LOG(ERROR) << "Received a decision, but didnt excpect one";
+                    throw std::runtime_error("Received a decision, but didnt excpect one");
+                }
+                frame = run(game_state, player).handle;
+            } else if ( frame.done() ) {
+                LOG(ERROR) << "Tried to apply " << CLASS_NAME << " after it has finished";
+                throw exception::UnreachableCode();
+            } else {
+                if ( !action_decision.has_value() || action_decision.value() == nullptr ) {
+                    LOG(ERROR) << "Expected a decision, but didnt receive one";
+                    throw std::runtime_error("Expected a decision, but didnt receive one");
+                }
+                // throws if the decision is not allowed, the coroutine stays where it is then
+                auto &promise = frame.promise();
+                promise.accept(promise.awaiter, player, action_decision.value());
+            }
+
+            // continues right after the co_await (or at the beginning) until the next ask or the end
+            frame.resume();
+
+            auto &promise = frame.promise();
+            if ( promise.exception ) {
+                std::rethrow_exception(promise.exception);
+            }
+            if ( frame.done() ) {
+                finished_behaviour = true;
+                return OrderResponse();
+            }
+            return std::move(promise.order);
+        }
     } // namespace base
 } // namespace server
 
-#include <server/game/behaviours_impl.hpp>
\ No newline at end of file
+#include <server/game/behaviours_impl.hpp>
@@ -1,8 +1,12 @@
 #pragma once
 
-#include <server/game/behaviour_registry.h>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 #include <vector>
 
+#include <server/game/behaviour_registry.h>
+
 namespace server
 {
     /**
@@ -10,22 +14,37 @@ namespace server
      * class, which are then stored. Should a card contain multistep behaviours (cards that require interaction from one
      * or more users to continue) we can easily stop and continue where we left off. The class only does basic
      * error-handling, the more detailed handling will be done by the behaviours themselves.
+     *
+     * There is one chain per game. The behaviours of a turn live in its arena, a monotonic buffer that is released as
+     * a whole by resetArena() at the end of the turn.
      */
     class BehaviourChain
     {
-        std::string current_card;
+        // enough for the behaviours of a few cards, the arena falls back to the heap beyond that
+        static constexpr size_t ARENA_SIZE = 1024;
+
+        shared::CardId current_card;
         size_t behaviour_idx;
         std::unique_ptr<BehaviourRegistry> behaviour_registry;
 
-        std::vector<std::unique_ptr<base::Behaviour>> behaviour_list;
+        alignas(std::max_align_t) std::array<std::byte, ARENA_SIZE> arena_buffer;
+        std::pmr::monotonic_buffer_resource arena;
+
+        // allocated in the arena, so it is declared after it
+        BehaviourRegistry::behaviour_list_t behaviour_list;
+        // set instead of behaviour_list if the card only has one-shot behaviours
+        BehaviourRegistry::static_behaviours_t static_behaviours = nullptr;
 
     public:
         using ret_t = server::base::Behaviour::ret_t;
 
         BehaviourChain();
         ~BehaviourChain() = default;
+        // the arena points into this object
+        BehaviourChain(const BehaviourChain &) = delete;
+        BehaviourChain &operator=(const BehaviourChain &) = delete;
 
-        void loadBehaviours(const std::string &card_id);
+        void loadBehaviours(shared::CardId card_id);
 
         /**
          * @brief This is called the first time we execute a behaviour.
@@ -36,10 +55,16 @@ namespace server
         /**
          * @brief If a card has multi-step behaviours we call this function to pass in the action_decision.
          */
-        ret_t continueChain(server::GameState &game_state, const shared::PlayerBase::id_t &player_id,
+        ret_t continueChain(server::GameState &game_state, shared::PlayerBase::seat_t player,
                             std::unique_ptr<shared::ActionDecision> &action_decision);
 
-        inline bool empty() const { return (behaviour_idx == 0) && current_card.empty() && behaviour_list.empty(); }
+        inline bool empty() const { return (behaviour_idx == 0) && !current_card.valid() && behaviour_list.empty(); }
+
+        /**
+         * @brief Gives back the memory of all behaviours of the turn at once. Called at the end of a turn.
+         * @throws exception::UnreachableCode if a card is still being played
+         */
+        void resetArena();
 
     private:
         inline void resetBehaviours();
@@ -12,28 +12,20 @@ namespace server
             server::base::Behaviour::ret_t sendAttackToEnemies(GameState &game_state, OrderGenerator gen)
             {
                 server::base::Behaviour::ret_t orders;
-                const auto player_id = game_state.getCurrentPlayerId();
-                const auto player_ids = game_state.getAllPlayerIDs();
+                const auto attacker = game_state.getCurrentSeat();
 
-                std::for_each(player_ids.begin(), player_ids.end(),
-                              [&](const auto enemy_id)
-                              {
-                                  if ( enemy_id == player_id ) {
-                                      return;
-                                  }
-
-                                  if ( game_state.getPlayer(enemy_id).canBlock() ) {
-                                      return;
-                                  }
-
-                                  auto order = gen(game_state, enemy_id);
+                for ( shared::PlayerBase::seat_t enemy = 0; enemy < game_state.getPlayerCount(); ++enemy ) {
+                    if ( enemy == attacker || game_state.getPlayer(enemy).canBlock() ) {
+                        continue;
+                    }
 
-                                  if ( order == nullptr ) {
-                                      return;
-                                  }
+                    auto order = gen(game_state, enemy);
+                    if ( order == nullptr ) {
+                        continue;
+                    }
 
-                                  orders.addOrder(enemy_id, std::move(order));
-                              });
+                    orders.addOrder(enemy, std::move(order));
+                }
 
                 return orders;
             }
@@ -41,24 +33,19 @@ namespace server
             template <typename AttackFunction>
             void applyAttackToEnemies(GameState &game_state, AttackFunction attack_func)
             {
-                auto attacker_id = game_state.getCurrentPlayerId();
-                const size_t player_count = game_state.getAllPlayerIDs().size();
-                const auto all_player_ids = game_state.getAllPlayerIDs();
-                // find the cur_player idx
-                auto attacker_it = std::find(all_player_ids.begin(), all_player_ids.end(), attacker_id);
-                size_t attacker_index = std::distance(all_player_ids.begin(), attacker_it);
-
-                // starting at 1 to skip current player_id
+                const auto attacker = game_state.getCurrentSeat();
+                const size_t player_count = game_state.getPlayerCount();
+
+                // starting at 1 to skip the attacker, the enemies are attacked in playing order
                 for ( size_t i = 1; i < player_count; ++i ) {
-                    const size_t enemy_index = (i + attacker_index) % player_count;
-                    const auto enemy_id = game_state.getAllPlayerIDs().at(enemy_index);
+                    const shared::PlayerBase::seat_t enemy = (attacker + i) % player_count;
 
-                    if ( game_state.getPlayer(enemy_id).canBlock() ) {
+                    if ( game_state.getPlayer(enemy).canBlock() ) {
                         return;
                     }
 
                     try {
-                        attack_func(game_state, enemy_id);
+                        attack_func(game_state, enemy);
                     } catch ( const std::exception &e ) {
                         LOG(DEBUG) << e.what();
                         return;
@@ -67,36 +54,23 @@ namespace server
             }
 
 
-            static inline auto validateResponse(GameState &game_state, const shared::PlayerBase::id_t &requestor_id,
-                                                std::unique_ptr<shared::ActionDecision> &action_decision,
-                                                unsigned int min_cards, unsigned int max_cards,
-                                                shared::CardType expected_type = static_cast<shared::CardType>(
-                                                        shared::CardType::ACTION | shared::CardType::ATTACK |
-                                                        shared::CardType::CURSE | shared::CardType::KINGDOM |
-                                                        shared::CardType::REACTION | shared::CardType::TREASURE |
-                                                        shared::CardType::VICTORY))
-            {
-                const auto player_id = requestor_id;
-                auto &player = game_state.getPlayer(player_id);
-                const auto *deck_choice = dynamic_cast<shared::DeckChoiceDecision *>(action_decision.get());
-                const auto choice_size = deck_choice->cards.size();
-
-                // validate the decision type
-                if ( deck_choice == nullptr ) {
-                    LOG(ERROR) << FUNC_NAME << " got a wrong decision type! Expected: shared::DeckChoiceDecision";
-                    throw std::runtime_error("Decision type is not allowed!");
-
-                    const auto *decision_ptr = action_decision.get();
-                    if ( decision_ptr != nullptr ) {
-                        LOG(ERROR) << FUNC_NAME << " got a wrong decision type from player " << player_id
-                                   << "! expected: shared::GainFromBoardDecision, got: "
-                                   << utils::demangle(typeid(*decision_ptr).name());
-                    } else {
-                        LOG(ERROR) << FUNC_NAME << " got a null pointer for action decision!";
-                    }
+            inline constexpr auto ANY_CARD_TYPE = static_cast<shared::CardType>(
+                    shared::CardType::ACTION | shared::CardType::ATTACK | shared::CardType::CURSE |
+                    shared::CardType::KINGDOM | shared::CardType::REACTION | shared::CardType::TREASURE |
+                    shared::CardType::VICTORY);
 
-                    throw std::runtime_error("Decision type is not allowed!");
-                }
+            /**
+             * @brief Checks that the player chose between min_cards and max_cards cards of expected_type from their
+             * hand.
+             * @throws std::runtime_error if the choice is not allowed
+             */
+            static inline void validateResponse(GameState &game_state, shared::PlayerBase::seat_t requestor,
+                                                const shared::DeckChoiceDecision &deck_choice, unsigned int min_cards,
+                                                unsigned int max_cards, shared::CardType expected_type = ANY_CARD_TYPE)
+            {
+                auto &player = game_state.getPlayer(requestor);
+                const auto &player_id = player.getId();
+                const auto choice_size = deck_choice.cards.size();
 
                 // validate number of cards
                 if ( min_cards == max_cards ) {
@@ -117,7 +91,7 @@ namespace server
                 }
 
                 // validate existence and type of the card
-                for ( const auto &card_id : deck_choice->cards ) {
+                for ( const auto &card_id : deck_choice.cards ) {
                     const auto card_type = shared::CardFactory::getType(card_id);
 
                     if ( (card_type & expected_type) != card_type ) {
@@ -132,7 +106,23 @@ namespace server
                         throw std::runtime_error("Card not in hand!");
                     }
                 }
+            }
+
+            static inline auto validateResponse(GameState &game_state, shared::PlayerBase::seat_t requestor,
+                                                std::unique_ptr<shared::ActionDecision> &action_decision,
+                                                unsigned int min_cards, unsigned int max_cards,
+                                                shared::CardType expected_type = ANY_CARD_TYPE)
+            {
+                const auto *deck_choice = shared::decisionCast<shared::DeckChoiceDecision>(action_decision.get());
+
+                // validate the decision type
+                if ( deck_choice == nullptr ) {
+                    LOG(ERROR) << FUNC_NAME << " got a wrong decision type from player "
+                               << game_state.getPlayer(requestor).getId() << "! Expected: shared::DeckChoiceDecision";
+                    throw std::runtime_error("Decision type is not allowed!");
+                }
 
+                validateResponse(game_state, requestor, *deck_choice, min_cards, max_cards, expected_type);
                 return *deck_choice;
             }
 
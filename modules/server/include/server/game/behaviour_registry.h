@@ -2,15 +2,16 @@
 
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <typeindex>
-#include <unordered_map>
 #include <vector>
 
 #include <server/game/behaviour_base.h>
-#include <server/game/victory_card_behaviours.h>
 #include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_id.h>
 #include <shared/utils/utils.h>
 
 namespace server
@@ -19,10 +20,32 @@ namespace server
      * @brief Behaviours are registered in this class. The Behaviour chain can request behaviours from the
      * BehaviourRegistry. As some of the behaviours we have require to keep some state, we create a new behaviour list
      * for each call. This way we can ensure that we always have fresh behaviours and it also helps with modularity.
+     *
+     * The behaviours are allocated from a std::pmr::memory_resource given by the caller (the arena of the
+     * BehaviourChain), so the list only destroys them and their memory is reclaimed together with the resource.
+     *
+     * Cards whose behaviours are all one-shot (see behaviour::is_one_shot) additionally get a static entry, which
+     * applies the behaviours from a tuple on the stack. This is what most cards (and all treasures) use.
      */
     class BehaviourRegistry
     {
     public:
+        /**
+         * @brief Only runs the destructor, the memory belongs to the memory_resource the behaviour came from.
+         */
+        struct DestroyBehaviour
+        {
+            void operator()(base::Behaviour *behaviour) const { std::destroy_at(behaviour); }
+        };
+
+        using behaviour_ptr_t = std::unique_ptr<base::Behaviour, DestroyBehaviour>;
+        using behaviour_list_t = std::pmr::vector<behaviour_ptr_t>;
+
+        /**
+         * @brief Applies all behaviours of a card at once, for the current player.
+         */
+        using static_behaviours_t = void (*)(GameState &game_state, shared::PlayerBase::seat_t player);
+
         /**
          * @brief Constructs a new BehaviourRegistry.
          * IF the behaviours are not already initialised it will do so.
@@ -32,10 +55,16 @@ namespace server
         /**
          * @brief Generates a list of behaviours that are registered for the card_id. The list will be generated anew
          * for each call to getBehaviours.
+         *
+         * @param resource where the list and the behaviours are allocated, has to outlive the list
          */
-        std::vector<std::unique_ptr<base::Behaviour>> getBehaviours(const std::string &card_id);
+        behaviour_list_t getBehaviours(shared::CardId card_id, std::pmr::memory_resource *resource);
 
-        VictoryCardBehaviour &getVictoryBehaviour(const shared::CardBase::id_t &card_id) const;
+        /**
+         * @brief The static entry of the card, which does not allocate anything.
+         * @return nullptr if the card has behaviours that keep state, use getBehaviours for those.
+         */
+        static_behaviours_t getStaticBehaviours(shared::CardId card_id) const;
 
     private:
         /**
@@ -49,52 +78,49 @@ namespace server
          * @tparam BehaviourType The behaviours that will be used for the card.
          */
         template <typename... BehaviourType>
-        inline void insert(const shared::CardBase::id_t &card_id);
-
-        /**
-         * @brief Inserts a list of behaviours into the registry. This will be called from the constructor.
-         *
-         * @tparam VictoryCardBehaviour The behaviour that will be used for the victory points.
-         * @tparam BehaviourTypes The behaviours that will be used for the card.
-         */
-        template <typename VictoryCardBehaviour, typename... BehaviourTypes>
-        void insertVictory(const shared::CardBase::id_t &card_id);
+        inline void insert(shared::CardId card_id);
 
         // TODO(#229): I guess this is a memory leak.
         // In order to fix this, we could make the behaviour registry a singleton.
-        static std::unordered_map<shared::CardBase::id_t, std::unique_ptr<VictoryCardBehaviour>> _victory_map;
-        static std::unordered_map<shared::CardBase::id_t,
-                                  std::function<std::vector<std::unique_ptr<base::Behaviour>>()>>
-                _map;
+        // Indexed by shared::CardId::index(), unregistered cards have empty entries.
+        static std::vector<std::function<behaviour_list_t(std::pmr::memory_resource *)>> _map;
+        // Indexed like _map, nullptr for cards that are not made of one-shot behaviours only.
+        static std::vector<static_behaviours_t> _static_map;
         static bool _is_initialised;
     };
 
     // static member initialisation
-    inline std::unordered_map<shared::CardBase::id_t, std::unique_ptr<VictoryCardBehaviour>>
-            BehaviourRegistry::_victory_map;
-    inline std::unordered_map<std::string, std::function<std::vector<std::unique_ptr<base::Behaviour>>()>>
+    inline std::vector<std::function<BehaviourRegistry::behaviour_list_t(std::pmr::memory_resource *)>>
             BehaviourRegistry::_map;
+    inline std::vector<BehaviourRegistry::static_behaviours_t> BehaviourRegistry::_static_map;
     inline bool BehaviourRegistry::_is_initialised;
 
     template <typename... BehaviourType>
-    inline void BehaviourRegistry::insert(const shared::CardBase::id_t &card_id)
+    inline void BehaviourRegistry::insert(shared::CardId card_id)
     {
-        insertVictory<ConstantVictoryPoints<0>, BehaviourType...>(card_id);
-    }
+        if ( !card_id.valid() ) {
+            LOG(INFO) << "Skipping behaviours of a card that is not registered in the CardFactory";
+            return;
+        }
 
-    template <typename VictoryCardBehaviour, typename... BehaviourType>
-    inline void BehaviourRegistry::insertVictory(const shared::CardBase::id_t &card_id)
-    {
         LOG(INFO) << "Registering card: " << card_id;
         ((LOG(INFO) << "  Behaviour type: " << utils::demangle(typeid(BehaviourType).name())), ...);
 
-        _victory_map[card_id] = std::make_unique<VictoryCardBehaviour>();
-
-        _map[card_id] = []()
+        _map[card_id.index()] = [](std::pmr::memory_resource *resource)
         {
-            std::vector<std::unique_ptr<base::Behaviour>> behaviours;
-            (behaviours.emplace_back(std::make_unique<BehaviourType>()), ...);
+            std::pmr::polymorphic_allocator<> allocator(resource);
+            behaviour_list_t behaviours(allocator);
+            behaviours.reserve(sizeof...(BehaviourType));
+            (behaviours.emplace_back(allocator.new_object<BehaviourType>()), ...);
             return behaviours;
         };
+
+        if constexpr ( (behaviour::is_one_shot<BehaviourType> && ...) ) {
+            _static_map[card_id.index()] = [](GameState &game_state, shared::PlayerBase::seat_t player)
+            {
+                std::tuple<BehaviourType...> behaviours;
+                std::apply([&](auto &...behaviour) { (behaviour.apply(game_state, player), ...); }, behaviours);
+            };
+        }
     }
 } // namespace server
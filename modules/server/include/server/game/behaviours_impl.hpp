@@ -1,3 +1,5 @@
+#include <array>
+
 #include <server/game/behaviour_base.h>
 #include <server/game/behaviour_helper.hpp>
 #include <shared/utils/utils.h>
@@ -12,11 +14,11 @@ namespace server
     class name : public server::base::Behaviour                                                                        \
     {                                                                                                                  \
     public:                                                                                                            \
-        inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,                     \
+        inline ret_t apply(server::GameState &state, shared::PlayerBase::seat_t requestor,                             \
                            server::base::Behaviour::action_decision_t action_decision = std::nullopt);                 \
     };                                                                                                                 \
     inline server::base::Behaviour::ret_t name::apply(server::GameState &game_state,                                   \
-                                                      const shared::PlayerBase::id_t &requestor_id,                    \
+                                                      shared::PlayerBase::seat_t requestor,                            \
                                                       server::base::Behaviour::action_decision_t action_decision)
 // NOLINTEND(bugprone-macro-parentheses)
 
@@ -27,21 +29,36 @@ namespace server
     class name : public server::base::Behaviour                                                                        \
     {                                                                                                                  \
     public:                                                                                                            \
-        inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,                     \
+        inline ret_t apply(server::GameState &state, shared::PlayerBase::seat_t requestor,                             \
                            server::base::Behaviour::action_decision_t action_decision = std::nullopt);                 \
     };                                                                                                                 \
     template <template_type template_name>                                                                             \
     inline server::base::Behaviour::ret_t name<template_name>::apply(                                                  \
-            server::GameState &game_state, const shared::PlayerBase::id_t &requestor_id,                               \
+            server::GameState &game_state, shared::PlayerBase::seat_t requestor,                                       \
             server::base::Behaviour::action_decision_t action_decision)
 // NOLINTEND(bugprone-macro-parentheses)
 
+// False positive of clang-tidy
+// NOLINTBEGIN(bugprone-macro-parentheses)
+#define DEFINE_CO_BEHAVIOUR(name)                                                                                      \
+    class name : public server::base::CoBehaviour                                                                      \
+    {                                                                                                                  \
+    public:                                                                                                            \
+        using CoBehaviour::CoBehaviour;                                                                                \
+                                                                                                                       \
+    protected:                                                                                                         \
+        inline Task run(server::GameState &game_state, shared::PlayerBase::seat_t requestor) override;                 \
+    };                                                                                                                 \
+    inline server::base::CoBehaviour::Task name::run(server::GameState &game_state,                                    \
+                                                     shared::PlayerBase::seat_t requestor)
+// NOLINTEND(bugprone-macro-parentheses)
+
 // ================================
 // HELPER MACROS
 // ================================
 
 // call this at the top of your behaviour to log the call.
-#define LOG_CALL LOG(INFO) << "Applying " << CLASS_NAME << " to player " << requestor_id
+#define LOG_CALL LOG(INFO) << "Applying " << CLASS_NAME << " to the player at seat " << requestor
 
 // call this if the linter is beeing a lil bitch.
 #define SUPPRESS_UNUSED_VAR_WARNING(variable) (void)(variable)
@@ -67,7 +84,7 @@ namespace server
     [](server::base::Behaviour::action_decision_t &action_decision) -> decision_type *                                 \
     {                                                                                                                  \
         ASSERT_DECISION                                                                                                \
-        auto *casted_decision = dynamic_cast<(decision_type) *>(action_decision->get());                               \
+        auto *casted_decision = shared::decisionCast<decision_type>(action_decision->get());                          \
         if ( !casted_decision ) {                                                                                      \
             LOG(ERROR) << "Decision has wrong type! Expected: " << utils::demangle(typeid(decision_type).name())       \
                        << ", but got: " << utils::demangle(typeid(*action_decision->get()).name());                    \
@@ -89,7 +106,7 @@ namespace server
             LOG_CALL;
             ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addTreasure(coins);
 
             BEHAVIOUR_DONE;
@@ -100,7 +117,7 @@ namespace server
             LOG_CALL;
             ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addBuys(buys);
 
             BEHAVIOUR_DONE;
@@ -111,7 +128,7 @@ namespace server
             LOG_CALL;
             ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addActions(actions);
 
             BEHAVIOUR_DONE;
@@ -122,7 +139,7 @@ namespace server
             LOG_CALL;
             ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.draw(n_cards);
 
             BEHAVIOUR_DONE;
@@ -133,12 +150,11 @@ namespace server
             LOG_CALL;
             ASSERT_NO_DECISION;
 
-            auto all_player_ids = game_state.getAllPlayerIDs();
-            for ( auto &player_id : all_player_ids ) {
-                if ( player_id == game_state.getCurrentPlayerId() ) {
+            for ( shared::PlayerBase::seat_t enemy = 0; enemy < game_state.getPlayerCount(); ++enemy ) {
+                if ( enemy == game_state.getCurrentSeat() ) {
                     continue;
                 }
-                auto &affected_player = game_state.getPlayer(player_id);
+                auto &affected_player = game_state.getPlayer(enemy);
                 affected_player.draw(n_cards);
             }
 
@@ -149,16 +165,17 @@ namespace server
         {
             LOG_CALL;
             ASSERT_NO_DECISION;
+            constexpr auto curse = shared::CardId::of("Curse");
 
             // ensure play order
             helper::applyAttackToEnemies(game_state,
-                                         [&](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
+                                         [&](GameState &game_state, shared::PlayerBase::seat_t enemy)
                                          {
-                                             auto &affected_enemy = game_state.getPlayer(enemy_id);
+                                             auto &affected_enemy = game_state.getPlayer(enemy);
                                              affected_enemy.move<shared::DRAW_PILE_TOP, shared::DISCARD_PILE>(1);
-                                             if ( game_state.getBoard()->has("Curse") ) {
-                                                 game_state.getBoard()->tryTake("Curse");
-                                                 affected_enemy.add<shared::DRAW_PILE_TOP>("Curse");
+                                             if ( game_state.getBoard()->has(curse) ) {
+                                                 game_state.getBoard()->tryTake(curse);
+                                                 affected_enemy.add<shared::DRAW_PILE_TOP>(curse);
                                              }
                                          });
 
@@ -169,11 +186,12 @@ namespace server
         {
             LOG_CALL;
             ASSERT_NO_DECISION;
+            constexpr auto copper = shared::CardId::of("Copper");
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
-            if ( affected_player.hasCard<shared::HAND>("Copper") ) {
+            auto &affected_player = game_state.getPlayer(requestor);
+            if ( affected_player.hasCard<shared::HAND>(copper) ) {
                 // Discard the copper
-                affected_player.move<shared::HAND, shared::TRASH>("Copper");
+                affected_player.move<shared::HAND, shared::TRASH>(copper);
                 affected_player.addTreasure(3);
             }
 
@@ -184,77 +202,72 @@ namespace server
         {
             LOG_CALL;
             ASSERT_NO_DECISION;
+            constexpr auto copper = shared::CardId::of("Copper");
+            constexpr auto gold = shared::CardId::of("Gold");
 
             auto &affected_player = game_state.getCurrentPlayer();
             auto &board = *game_state.getBoard();
-            if ( board.has("Copper") )
+            if ( board.has(copper) )
             {
-                board.tryTake("Copper");
-                affected_player.gain("Copper");
+                board.tryTake(copper);
+                affected_player.gain(copper);
             }
-            if ( board.has("Gold") )
+            if ( board.has(gold) )
             {
-                board.tryTake("Gold");
-                affected_player.gain("Gold");
+                board.tryTake(gold);
+                affected_player.gain(gold);
             }
             BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(Poacher)
+        DEFINE_CO_BEHAVIOUR(Poacher)
         {
             LOG_CALL;
 
-            if ( !action_decision.has_value() ) {
-                auto board = game_state.getBoard();
-                auto cards_to_discard = board->getEmptyPilesCount();
-                if ( cards_to_discard != 0) {
-                    return {game_state.getCurrentPlayerId(),
-                            std::make_unique<shared::ChooseFromHandOrder>(cards_to_discard, cards_to_discard,
-                                                                          shared::ChooseFromOrder::AllowedChoice::DISCARD)};
-                }
+            const auto cards_to_discard = game_state.getBoard()->getEmptyPilesCount();
+            if ( cards_to_discard == 0 ) {
+                co_return;
             }
 
-            auto board = game_state.getBoard();
-            auto cards_to_discard = board->getEmptyPilesCount();
-
-            if ( cards_to_discard != 0 ) {
-                auto decision =
-                        helper::validateResponse(game_state, requestor_id, action_decision.value(), cards_to_discard, cards_to_discard);
-
-                if ( decision.cards.size() == 0 ) {
-                    BEHAVIOUR_DONE;
-                }
-
-                auto &affected_player = game_state.getCurrentPlayer();
-                for ( const auto &card_id : decision.cards ) {
-                    affected_player.move<shared::HAND, shared::DISCARD_PILE>(card_id);
-                }
-            }
-            BEHAVIOUR_DONE;
+            co_await ask<shared::DeckChoiceDecision>(
+                    {requestor,
+                     std::make_unique<shared::ChooseFromHandOrder>(cards_to_discard, cards_to_discard,
+                                                                   shared::ChooseFromOrder::AllowedChoice::DISCARD)},
+                    [&](shared::PlayerBase::seat_t decider, shared::DeckChoiceDecision &decision)
+                    {
+                        helper::validateResponse(game_state, decider, decision, cards_to_discard, cards_to_discard);
+
+                        auto &affected_player = game_state.getPlayer(decider);
+                        for ( const auto &card_id : decision.cards ) {
+                            affected_player.move<shared::HAND, shared::DISCARD_PILE>(card_id);
+                        }
+                    });
         }
 
         DEFINE_BEHAVIOUR(TreasureMap)
         {
             LOG_CALL;
             ASSERT_NO_DECISION;
+            constexpr auto treasure_map = shared::CardId::of("Treasure_Map");
+            constexpr auto gold = shared::CardId::of("Gold");
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             auto &board = *game_state.getBoard();
-            if ( affected_player.hasCard<shared::HAND>("Treasure_Map") ) {
-                affected_player.move<shared::HAND, shared::TRASH>("Treasure_Map");
+            if ( affected_player.hasCard<shared::HAND>(treasure_map) ) {
+                affected_player.move<shared::HAND, shared::TRASH>(treasure_map);
                 // Currently, ServerPlayer::move does not delete the card from
                 // the hand, so we have to do it manually
-                board.trashCard("Treasure_Map");
-                if ( !board.removeFromPlayedCards("Treasure_Map") ) {
+                board.trashCard(treasure_map);
+                if ( !board.removeFromPlayedCards(treasure_map) ) {
                     // We played a treasure map, so it should be in the played cards now
                     LOG(ERROR) << "Treasure_Map not found in played cards";
                     throw std::runtime_error("Treasure_Map not found in played cards");
                 }
-                board.trashCard("Treasure_Map");
+                board.trashCard(treasure_map);
                 for ( int i = 0; i < 4; i++ ) {
-                    if ( board.has("Gold") ) {
-                        board.tryTake("Gold");
-                        affected_player.add<shared::DRAW_PILE_TOP>("Gold");
+                    if ( board.has(gold) ) {
+                        board.tryTake(gold);
+                        affected_player.add<shared::DRAW_PILE_TOP>(gold);
                     }
                 }
             }
@@ -266,7 +279,7 @@ namespace server
 #define TODO_IMPLEMENT_ME                                                                                              \
     SUPPRESS_UNUSED_VAR_WARNING(game_state);                                                                           \
     SUPPRESS_UNUSED_VAR_WARNING(action_decision);                                                                      \
-    SUPPRESS_UNUSED_VAR_WARNING(requestor_id);                                                                         \
+    SUPPRESS_UNUSED_VAR_WARNING(requestor);                                                                            \
     LOG(ERROR) << "BEHAVIOUR " << CLASS_NAME << " IS NOT IMPLEMENTED YET";                                             \
     throw std::runtime_error("not implemented");                                                                       \
     return OrderResponse()
@@ -288,13 +301,14 @@ namespace server
 
             LOG_CALL;
             ASSERT_NO_DECISION;
+            constexpr auto curse = shared::CardId::of("Curse");
 
             helper::applyAttackToEnemies(game_state,
-                                         [&](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
+                                         [&](GameState &game_state, shared::PlayerBase::seat_t enemy)
                                          {
-                                             if ( game_state.getBoard()->has("Curse") ) {
-                                                 game_state.getBoard()->tryTake("Curse");
-                                                 game_state.getPlayer(enemy_id).gain("Curse");
+                                             if ( game_state.getBoard()->has(curse) ) {
+                                                 game_state.getBoard()->tryTake(curse);
+                                                 game_state.getPlayer(enemy).gain(curse);
                                              }
                                          });
 
@@ -309,10 +323,10 @@ namespace server
 
             if ( !has_action_decision ) {
                 // choose any card
-                return {requestor_id, std::make_unique<shared::GainFromBoardOrder>(max_cost)};
+                return {requestor, std::make_unique<shared::GainFromBoardOrder>(max_cost)};
             }
 
-            auto *gain_decision = dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get());
+            auto *gain_decision = shared::decisionCast<shared::GainFromBoardDecision>(action_decision.value().get());
             if ( gain_decision == nullptr ) {
                 const auto *decision_ptr = action_decision.value().get();
                 if ( decision_ptr != nullptr ) {
@@ -326,7 +340,7 @@ namespace server
             }
 
             const auto chosen_card_id = gain_decision->chosen_card;
-            game_state.tryGain<shared::HAND>(requestor_id, chosen_card_id);
+            game_state.tryGain<shared::HAND>(requestor, chosen_card_id);
 
             BEHAVIOUR_DONE;
         }
@@ -336,14 +350,14 @@ namespace server
             LOG_CALL;
 
             const bool has_action_decision = action_decision.has_value();
-            const auto cur_player_id = game_state.getCurrentPlayerId();
+            const auto current_player = game_state.getCurrentSeat();
 
             if (!has_action_decision) {
                 // choose any card
-                return { cur_player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost) };
+                return { current_player, std::make_unique<shared::GainFromBoardOrder>(max_cost) };
             }
 
-            auto* gain_decision = dynamic_cast<shared::GainFromBoardDecision*>(action_decision.value().get());
+            auto* gain_decision = shared::decisionCast<shared::GainFromBoardDecision>(action_decision.value().get());
             if (gain_decision == nullptr) {
                 const auto* decision_ptr = action_decision.value().get();
                 if (decision_ptr != nullptr) {
@@ -358,7 +372,7 @@ namespace server
             }
 
             const auto chosen_card_id = gain_decision->chosen_card;
-            game_state.tryGain<shared::DISCARD_PILE>(cur_player_id, chosen_card_id);
+            game_state.tryGain<shared::DISCARD_PILE>(current_player, chosen_card_id);
 
             BEHAVIOUR_DONE;
         }
@@ -369,12 +383,12 @@ namespace server
 
             if ( !action_decision.has_value() ) {
                 // send out gain card oder
-                return {game_state.getCurrentPlayerId(),
+                return {game_state.getCurrentSeat(),
                         std::make_unique<shared::ChooseFromHandOrder>(
                                 1, 1, shared::ChooseFromOrder::AllowedChoice::DRAW_PILE)};
             }
 
-            auto deck_choice = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1);
+            auto deck_choice = helper::validateResponse(game_state, requestor, action_decision.value(), 1, 1);
 
             const auto move_card_id = deck_choice.cards.at(0);
             game_state.getCurrentPlayer().move<shared::CardAccess::HAND, shared::CardAccess::DRAW_PILE_TOP>(
@@ -383,81 +397,72 @@ namespace server
             BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(Mine)
+        DEFINE_CO_BEHAVIOUR(Mine)
         {
             LOG_CALL;
 
-            const bool has_action_decision = action_decision.has_value();
-            const auto player_id = game_state.getCurrentPlayerId();
-            auto &affected_player = game_state.getPlayer(requestor_id);
-
-            if ( !has_action_decision ) {
-                if ( !affected_player.hasType<shared::CardAccess::HAND>(shared::CardType::TREASURE) ) {
-                    LOG(INFO) << "Player: "
-                              << " has no treasure in hand, returning";
-                    BEHAVIOUR_DONE;
-                }
-
-                return {requestor_id,
-                        std::make_unique<shared::ChooseFromHandOrder>(
-                                1, 1, shared::ChooseFromOrder::AllowedChoice::DISCARD, shared::CardType::TREASURE)};
-            }
-
-            if ( dynamic_cast<shared::DeckChoiceDecision *>(action_decision.value().get()) != nullptr ) {
-                auto trash_decision = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1,
-                                                               shared::CardType::TREASURE);
-
-                const auto card_id = trash_decision.cards.at(0);
-                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
-                const auto max_cost = shared::CardFactory::getCost(card_id) + 3;
-                return {player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost, shared::CardType::TREASURE)};
-
-            } else if ( auto *card_choice =
-                                dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get()) ) {
-                auto card_id = card_choice->chosen_card;
-
-                if ( !shared::CardFactory::isTreasure(card_id) ) {
-                    LOG(ERROR) << FUNC_NAME << "Player: " << requestor_id << " tried to select card: " << card_id
-                               << " which does not have type Treasure";
-                    throw std::runtime_error("CardType not allowed!");
-                }
-
-                game_state.tryGain<shared::HAND>(player_id, card_id);
+            const auto current_player = game_state.getCurrentSeat();
+            if ( !game_state.getPlayer(requestor).hasType<shared::CardAccess::HAND>(shared::CardType::TREASURE) ) {
+                LOG(INFO) << "Player: " << game_state.getPlayer(requestor).getId()
+                          << " has no treasure in hand, returning";
+                co_return;
             }
 
-            BEHAVIOUR_DONE;
+            const auto max_cost = co_await ask<shared::DeckChoiceDecision>(
+                    {requestor,
+                     std::make_unique<shared::ChooseFromHandOrder>(
+                             1, 1, shared::ChooseFromOrder::AllowedChoice::DISCARD, shared::CardType::TREASURE)},
+                    [&](shared::PlayerBase::seat_t decider, shared::DeckChoiceDecision &decision)
+                    {
+                        helper::validateResponse(game_state, decider, decision, 1, 1, shared::CardType::TREASURE);
+
+                        const auto card_id = decision.cards.at(0);
+                        game_state.getPlayer(decider).move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(
+                                card_id);
+                        return shared::CardFactory::getCost(card_id) + 3;
+                    });
+
+            co_await ask<shared::GainFromBoardDecision>(
+                    {current_player,
+                     std::make_unique<shared::GainFromBoardOrder>(max_cost, shared::CardType::TREASURE)},
+                    [&](shared::PlayerBase::seat_t decider, shared::GainFromBoardDecision &decision)
+                    {
+                        const auto card_id = decision.chosen_card;
+                        if ( !shared::CardFactory::isTreasure(card_id) ) {
+                            LOG(ERROR) << FUNC_NAME << "Player: " << game_state.getPlayer(decider).getId()
+                                       << " tried to select card: " << card_id << " which does not have type Treasure";
+                            throw std::runtime_error("CardType not allowed!");
+                        }
+
+                        game_state.tryGain<shared::HAND>(current_player, card_id);
+                    });
         }
 
-        DEFINE_BEHAVIOUR(Remodel)
+        DEFINE_CO_BEHAVIOUR(Remodel)
         {
             LOG_CALL;
 
-            const bool has_action_decision = action_decision.has_value();
-            const auto player_id = game_state.getCurrentPlayerId();
-            auto &player = game_state.getCurrentPlayer();
-
-            if ( !has_action_decision ) {
-                return {player_id,
-                        std::make_unique<shared::ChooseFromHandOrder>(1, 1,
-                                                                      shared::ChooseFromOrder::AllowedChoice::TRASH)};
-            }
-
-            if ( dynamic_cast<shared::DeckChoiceDecision *>(action_decision.value().get()) != nullptr ) {
-                auto trash_decision = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1);
-
-                const auto card_id = trash_decision.cards.at(0);
-                player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
-                game_state.getBoard()->trashCard("card_id");
-                const auto max_cost = shared::CardFactory::getCost(card_id) + 2;
-                return {player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost)};
-
-            } else if ( auto *card_choice =
-                                dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get()) ) {
-                auto card_id = card_choice->chosen_card;
-                game_state.tryGain<shared::DISCARD_PILE>(player_id, card_id);
-            }
-
-            BEHAVIOUR_DONE;
+            const auto current_player = game_state.getCurrentSeat();
+
+            const auto max_cost = co_await ask<shared::DeckChoiceDecision>(
+                    {current_player,
+                     std::make_unique<shared::ChooseFromHandOrder>(1, 1,
+                                                                   shared::ChooseFromOrder::AllowedChoice::TRASH)},
+                    [&](shared::PlayerBase::seat_t decider, shared::DeckChoiceDecision &decision)
+                    {
+                        helper::validateResponse(game_state, decider, decision, 1, 1);
+
+                        const auto card_id = decision.cards.at(0);
+                        game_state.getCurrentPlayer().move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(
+                                card_id);
+                        game_state.getBoard()->trashCard(card_id);
+                        return shared::CardFactory::getCost(card_id) + 2;
+                    });
+
+            co_await ask<shared::GainFromBoardDecision>(
+                    {current_player, std::make_unique<shared::GainFromBoardOrder>(max_cost)},
+                    [&](shared::PlayerBase::seat_t /*decider*/, shared::GainFromBoardDecision &decision)
+                    { game_state.tryGain<shared::DISCARD_PILE>(current_player, decision.chosen_card); });
         }
 
 
@@ -465,15 +470,15 @@ namespace server
         {
             LOG_CALL;
             if ( !action_decision.has_value() ) {
-                return {game_state.getCurrentPlayerId(),
+                return {game_state.getCurrentSeat(),
                         std::make_unique<shared::ChooseFromHandOrder>(0, 4,
                                                                       shared::ChooseFromOrder::AllowedChoice::TRASH)};
             }
 
             auto trash_decision =
-                    helper::validateResponse(game_state, requestor_id, action_decision.value(), 0, num_cards);
+                    helper::validateResponse(game_state, requestor, action_decision.value(), 0, num_cards);
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             for ( const auto &card_id : trash_decision.cards ) {
                 affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
             }
@@ -487,13 +492,13 @@ namespace server
 
             const auto max_discard_amount = game_state.getCurrentPlayer().get<shared::CardAccess::HAND>().size();
             if ( !action_decision.has_value() ) {
-                return {requestor_id,
+                return {requestor,
                         std::make_unique<shared::ChooseFromHandOrder>(0, max_discard_amount,
                                                                       shared::ChooseFromOrder::AllowedChoice::TRASH)};
             }
 
             auto discard_decision =
-                    helper::validateResponse(game_state, requestor_id, action_decision.value(), 0, max_discard_amount);
+                    helper::validateResponse(game_state, requestor, action_decision.value(), 0, max_discard_amount);
 
             // stop behaviour if no cards are selected
             // otherwise draw(0) would draw the entire draw pile
@@ -501,7 +506,7 @@ namespace server
                 BEHAVIOUR_DONE;
             }
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.draw(discard_decision.cards.size());
             for ( const auto &card_id : discard_decision.cards ) {
                 affected_player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(card_id);
@@ -510,81 +515,99 @@ namespace server
             BEHAVIOUR_DONE;
         }
 
-        class MilitiaAttack : public server::base::Behaviour
-        {
-            std::unordered_map<shared::PlayerBase::id_t, unsigned int> expect_response;
-
-        public:
-            inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,
-                               server::base::Behaviour::action_decision_t action_decision = std::nullopt) override;
-        };
-        inline server::base::Behaviour::ret_t
-        MilitiaAttack::apply(server::GameState &game_state, const shared::PlayerBase::id_t &requestor_id,
-                             server::base::Behaviour::action_decision_t action_decision)
+        DEFINE_CO_BEHAVIOUR(MilitiaAttack)
         {
             LOG_CALL;
-            // check if anything has to be done
-            if ( !action_decision.has_value() ) {
-                auto order = helper::sendAttackToEnemies(
-                        game_state,
-                        [this](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
-                        {
-                            const auto &enemy = game_state.getPlayer(enemy_id);
-                            const auto hand_size = enemy.get<shared::HAND>().size();
-
 
-                            if ( hand_size <= 3 || enemy.canBlock() ) {
-                                // no order for this player
-                                return std::unique_ptr<shared::ChooseFromHandOrder>(nullptr);
+            // how many cards each attacked enemy still has to discard, by seat
+            std::array<unsigned int, shared::board_config::MAX_PLAYER_COUNT> expect_response{};
+            size_t pending_responses = 0;
+
+            auto orders = helper::sendAttackToEnemies(
+                    game_state,
+                    [&](GameState &state, shared::PlayerBase::seat_t enemy)
+                    {
+                        const auto &enemy_player = state.getPlayer(enemy);
+                        const auto hand_size = enemy_player.get<shared::HAND>().size();
+
+                        if ( hand_size <= 3 || enemy_player.canBlock() ) {
+                            // no order for this player
+                            return std::unique_ptr<shared::ChooseFromHandOrder>(nullptr);
+                        }
+
+                        const unsigned int n_cards_to_discard = hand_size - 3;
+                        expect_response[enemy] = n_cards_to_discard;
+                        ++pending_responses;
+
+                        return std::make_unique<shared::ChooseFromHandOrder>(
+                                n_cards_to_discard, n_cards_to_discard, shared::ChooseFromOrder::AllowedChoice::TRASH);
+                    });
+
+            while ( pending_responses > 0 ) {
+                co_await ask<shared::DeckChoiceDecision>(
+                        std::move(orders),
+                        [&](shared::PlayerBase::seat_t enemy, shared::DeckChoiceDecision &decision)
+                        {
+                            if ( enemy >= expect_response.size() || expect_response[enemy] == 0 ) {
+                                LOG(WARN) << "Not expecting a response from the enemy at seat " << enemy;
+                                throw exception::NotYourTurn();
                             }
 
-                            const unsigned int n_cards_to_discard = hand_size - 3;
+                            const auto n_cards_to_discard = expect_response[enemy];
+                            helper::validateResponse(game_state, enemy, decision, n_cards_to_discard,
+                                                     n_cards_to_discard);
 
-                            this->expect_response.emplace(enemy_id, n_cards_to_discard);
+                            auto &affected_enemy = game_state.getPlayer(enemy);
+                            for ( const auto &card_id : decision.cards ) {
+                                affected_enemy.move<shared::HAND, shared::DISCARD_PILE>(card_id);
+                            }
 
-                            return std::make_unique<shared::ChooseFromHandOrder>(
-                                    n_cards_to_discard, n_cards_to_discard,
-                                    shared::ChooseFromOrder::AllowedChoice::TRASH);
+                            expect_response[enemy] = 0;
+                            --pending_responses;
                         });
-
-                bool has_no_orders = std::all_of(order.begin(), order.end(),
-                                                 [](const auto &map_entry) { return map_entry.second == nullptr; });
-
-                if ( has_no_orders ) {
-                    BEHAVIOUR_DONE;
-                } else {
-                    return order;
-                }
-            }
-
-            auto enemy_iter = this->expect_response.find(requestor_id);
-            if ( enemy_iter == this->expect_response.end() ) {
-                LOG(WARN) << "Not expecting a response from enemy: " << requestor_id;
-                throw exception::NotYourTurn();
-            }
-
-            const auto n_cards_to_discard = this->expect_response.at(requestor_id);
-            auto decision = helper::validateResponse(game_state, requestor_id, action_decision.value(),
-                                                     n_cards_to_discard, n_cards_to_discard);
-
-            auto &affected_enemy = game_state.getPlayer(requestor_id);
-            for ( const auto &card_id : decision.cards ) {
-                affected_enemy.move<shared::HAND, shared::DISCARD_PILE>(card_id);
+                // the other enemies already have their orders
+                orders = OrderResponse();
             }
+        }
 
-            this->expect_response.erase(enemy_iter);
-
-            if ( !this->expect_response.empty() ) {
-                return OrderResponse();
-            }
+        // ================================
+        // ONE-SHOT BEHAVIOURS
+        // ================================
 
-            BEHAVIOUR_DONE;
-        }
+        /**
+         * @brief Behaviours that never ask for a decision and are done after a single apply, so they do not need to
+         * keep any state between calls. Cards made only of such behaviours are applied without creating a behaviour
+         * list, see BehaviourRegistry::getStaticBehaviours.
+         */
+        template <typename BehaviourType>
+        inline constexpr bool is_one_shot = false;
+
+        template <int coins>
+        inline constexpr bool is_one_shot<GainCoins<coins>> = true;
+        template <int buys>
+        inline constexpr bool is_one_shot<GainBuys<buys>> = true;
+        template <int actions>
+        inline constexpr bool is_one_shot<GainActions<actions>> = true;
+        template <int n_cards>
+        inline constexpr bool is_one_shot<DrawCards<n_cards>> = true;
+        template <int n_cards>
+        inline constexpr bool is_one_shot<DrawCardsEnemies<n_cards>> = true;
+        template <>
+        inline constexpr bool is_one_shot<SeaHag> = true;
+        template <>
+        inline constexpr bool is_one_shot<Moneylender> = true;
+        template <>
+        inline constexpr bool is_one_shot<TreasureTrove> = true;
+        template <>
+        inline constexpr bool is_one_shot<TreasureMap> = true;
+        template <>
+        inline constexpr bool is_one_shot<CurseEnemy> = true;
 
 // ================================
 // UNDEF MACROS
 // ================================
 #undef DEFINE_BEHAVIOUR
+#undef DEFINE_CO_BEHAVIOUR
 #undef BEHAVIOUR_DONE
 #undef DEFINE_TEMPLATED_BEHAVIOUR
 #undef TRY_CAST_DECISION
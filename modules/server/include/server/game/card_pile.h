@@ -0,0 +1,681 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+#include <server/game/zobrist.h>
+#include <shared/game/cards/card_id.h>
+#include <shared/game/cards/card_table.h>
+
+namespace server
+{
+    namespace detail
+    {
+        // the tables of VictoryTally, computed from the CARD_TABLE at compile time
+        inline constexpr uint8_t NO_VICTORY_RULE = 0xff;
+
+        struct VictoryWeight
+        {
+            // points if the card is worth a fixed number of points
+            int points = 0;
+            // bit r is set if the card is counted by VICTORY_RULES[r]
+            uint8_t counted_by = 0;
+            // index into VICTORY_RULES if the worth of the card depends on the deck
+            uint8_t rule = NO_VICTORY_RULE;
+        };
+
+        inline constexpr size_t VICTORY_RULE_COUNT =
+                std::count_if(std::begin(shared::CARD_TABLE), std::end(shared::CARD_TABLE),
+                              [](const shared::CardDescriptor &card) { return card.victory.per_n != 0; });
+        static_assert(VICTORY_RULE_COUNT <= 8, "counted_by only has 8 bits");
+
+        // the cards whose worth depends on the deck
+        inline constexpr std::array<size_t, VICTORY_RULE_COUNT> VICTORY_RULES = []()
+        {
+            std::array<size_t, VICTORY_RULE_COUNT> rules{};
+            size_t rule = 0;
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                if ( shared::CARD_TABLE[index].victory.per_n != 0 ) {
+                    rules[rule++] = index;
+                }
+            }
+            return rules;
+        }();
+
+        // indexed by card index, the last entry is used for invalid cards
+        inline constexpr std::array<VictoryWeight, shared::CARD_COUNT + 1> VICTORY_WEIGHTS = []()
+        {
+            std::array<VictoryWeight, shared::CARD_COUNT + 1> weights{};
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                if ( shared::CARD_TABLE[index].victory.per_n == 0 ) {
+                    weights[index].points = shared::CARD_TABLE[index].victory.points;
+                }
+            }
+            for ( size_t rule = 0; rule < VICTORY_RULE_COUNT; ++rule ) {
+                const auto &victory = shared::CARD_TABLE[VICTORY_RULES[rule]].victory;
+                const auto counted_type = static_cast<shared::CardType>(victory.counted_type);
+                weights[VICTORY_RULES[rule]].rule = static_cast<uint8_t>(rule);
+                for ( size_t index = 0; index <= shared::CARD_COUNT; ++index ) {
+                    bool counted = false;
+                    if ( index == shared::CARD_COUNT ) {
+                        // invalid cards have no type, they only count as a card
+                        counted = victory.counted_card.empty() && victory.counted_type == 0;
+                    } else if ( !victory.counted_card.empty() ) {
+                        counted = shared::CARD_TABLE[index].name == victory.counted_card;
+                    } else {
+                        counted = (shared::CARD_TABLE[index].type & counted_type) == counted_type;
+                    }
+                    if ( counted ) {
+                        weights[index].counted_by |= static_cast<uint8_t>(1u << rule);
+                    }
+                }
+            }
+            return weights;
+        }();
+
+        // the bits of shared::CardType, CardCounts counts the cards per bit
+        inline constexpr size_t TYPE_BITS = std::bit_width(static_cast<unsigned int>(
+                shared::CardType::KINGDOM | shared::CardType::TREASURE | shared::CardType::VICTORY |
+                shared::CardType::CURSE | shared::CardType::ACTION | shared::CardType::ATTACK |
+                shared::CardType::REACTION));
+        static_assert(std::all_of(std::begin(shared::CARD_TABLE), std::end(shared::CARD_TABLE),
+                                  [](const shared::CardDescriptor &card) { return (card.type >> TYPE_BITS) == 0; }),
+                      "every card type has to fit into the counted bits");
+
+        inline constexpr uint8_t NO_TYPE_BIT = 0xff;
+
+        /**
+         * Indexed by a type (a combination of shared::CardType), the bit whose cards are exactly the cards of that
+         * type, or NO_TYPE_BIT if there is none. That is the case if all cards with this bit have all bits of the
+         * type, e.g. for REACTION (REACTION | ACTION | KINGDOM) the REACTION bit. This holds for all values of
+         * shared::CardType, as cards are made of them.
+         */
+        inline constexpr std::array<uint8_t, (1u << TYPE_BITS)> TYPE_BIT = []()
+        {
+            // for every bit, the bits that all cards with this bit have
+            std::array<unsigned int, TYPE_BITS> implied{};
+            implied.fill((1u << TYPE_BITS) - 1);
+            for ( const auto &card : shared::CARD_TABLE ) {
+                for ( size_t bit = 0; bit < TYPE_BITS; ++bit ) {
+                    if ( (card.type & (1u << bit)) != 0 ) {
+                        implied[bit] &= card.type;
+                    }
+                }
+            }
+
+            std::array<uint8_t, (1u << TYPE_BITS)> type_bit{};
+            type_bit.fill(NO_TYPE_BIT);
+            for ( unsigned int type = 0; type < type_bit.size(); ++type ) {
+                for ( size_t bit = 0; bit < TYPE_BITS; ++bit ) {
+                    if ( (type & (1u << bit)) != 0 && (type & ~implied[bit]) == 0 ) {
+                        type_bit[type] = static_cast<uint8_t>(bit);
+                        break;
+                    }
+                }
+            }
+            return type_bit;
+        }();
+        static_assert(std::ranges::none_of(std::array{shared::CardType::KINGDOM, shared::CardType::TREASURE,
+                                                      shared::CardType::VICTORY, shared::CardType::CURSE,
+                                                      shared::CardType::ACTION, shared::CardType::ATTACK,
+                                                      shared::CardType::REACTION},
+                                           [](shared::CardType type) { return TYPE_BIT[type] == NO_TYPE_BIT; }),
+                      "the types of shared::CardType should be counted without looking at the cards");
+
+        // the place of each card in a hand (see HandPile), indexed by card index, invalid cards come last
+        inline constexpr std::array<uint8_t, shared::CARD_COUNT + 1> HAND_ORDER = []()
+        {
+            // actions first, then treasures, victory cards and everything else, each by cost and then by name
+            auto group = [](shared::CardType type)
+            {
+                if ( (type & shared::CardType::ACTION) != 0 ) {
+                    return 1;
+                } else if ( (type & shared::CardType::TREASURE) != 0 ) {
+                    return 2;
+                } else if ( (type & shared::CardType::VICTORY) != 0 ) {
+                    return 3;
+                } else {
+                    return 4;
+                }
+            };
+            std::array<size_t, shared::CARD_COUNT> indices{};
+            std::iota(indices.begin(), indices.end(), size_t{0});
+            std::sort(indices.begin(), indices.end(),
+                      [&group](size_t a, size_t b)
+                      {
+                          const auto &card_a = shared::CARD_TABLE[a];
+                          const auto &card_b = shared::CARD_TABLE[b];
+                          return std::tuple(group(card_a.type), card_a.cost, card_a.name) <
+                                 std::tuple(group(card_b.type), card_b.cost, card_b.name);
+                      });
+
+            std::array<uint8_t, shared::CARD_COUNT + 1> order{};
+            for ( size_t place = 0; place < shared::CARD_COUNT; ++place ) {
+                order[indices[place]] = static_cast<uint8_t>(place);
+            }
+            order[shared::CARD_COUNT] = static_cast<uint8_t>(shared::CARD_COUNT);
+            return order;
+        }();
+    } // namespace detail
+
+    /**
+     * @brief The victory points of a set of cards, updated card by card.
+     *
+     * Cards worth a fixed number of points are summed up directly. For the cards whose worth depends on the deck
+     * (see shared::VictoryRule::per_n) the tally keeps their copies and the number of cards they count, so points()
+     * never looks at the cards themselves. Tallies of disjoint piles can be added up.
+     */
+    class VictoryTally
+    {
+    public:
+        void add(shared::CardId card_id) { update(card_id, 1); }
+        void remove(shared::CardId card_id) { update(card_id, -1); }
+        void clear() { *this = VictoryTally(); }
+
+        int points() const
+        {
+            int result = fixed_points;
+            for ( size_t rule = 0; rule < detail::VICTORY_RULE_COUNT; ++rule ) {
+                const auto &victory = shared::CARD_TABLE[detail::VICTORY_RULES[rule]].victory;
+                result += copies[rule] * victory.points * (counted[rule] / static_cast<int>(victory.per_n));
+            }
+            return result;
+        }
+
+        VictoryTally &operator+=(const VictoryTally &other)
+        {
+            fixed_points += other.fixed_points;
+            for ( size_t rule = 0; rule < detail::VICTORY_RULE_COUNT; ++rule ) {
+                copies[rule] += other.copies[rule];
+                counted[rule] += other.counted[rule];
+            }
+            return *this;
+        }
+
+        friend VictoryTally operator+(VictoryTally lhs, const VictoryTally &rhs) { return lhs += rhs; }
+
+    private:
+        void update(shared::CardId card_id, int delta)
+        {
+            const auto &weight = detail::VICTORY_WEIGHTS[card_id.valid() ? card_id.index() : shared::CARD_COUNT];
+            fixed_points += delta * weight.points;
+            if ( weight.rule != detail::NO_VICTORY_RULE ) {
+                copies[weight.rule] += delta;
+            }
+            for ( unsigned int mask = weight.counted_by; mask != 0; mask &= mask - 1 ) {
+                counted[std::countr_zero(mask)] += delta;
+            }
+        }
+
+        int fixed_points = 0;
+        std::array<int, detail::VICTORY_RULE_COUNT> copies{};
+        std::array<int, detail::VICTORY_RULE_COUNT> counted{};
+    };
+
+    /**
+     * @brief How many copies of each card a pile holds, indexed by shared::CardId::index().
+     *
+     * The cards are also counted per bit of their type, so the type queries do not have to look at every card.
+     */
+    class CardCounts
+    {
+    public:
+        using count_t = uint16_t;
+
+        size_t count(shared::CardId card_id) const { return card_id.valid() ? counts[card_id.index()] : 0; }
+        bool contains(shared::CardId card_id) const { return count(card_id) != 0; }
+        size_t size() const { return total; }
+        const VictoryTally &victoryTally() const { return victory; }
+
+        /**
+         * @brief Zobrist hash of the counts, kept up to date on every change (see zobrist::key).
+         */
+        uint64_t hash() const { return zobrist; }
+
+        /**
+         * @brief The same as hash(), but computed from the counts.
+         */
+        uint64_t computeHash() const
+        {
+            uint64_t result = 0;
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                result ^= zobrist::key(index, counts[index]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Number of cards whose type contains all bits of `type`, e.g. CardType::VICTORY also counts Curses.
+         */
+        size_t countType(shared::CardType type) const
+        {
+            if ( const auto bit = typeBit(type); bit != detail::NO_TYPE_BIT ) {
+                return type_counts[bit];
+            }
+            size_t result = 0;
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                if ( (shared::CARD_TABLE[index].type & type) == type ) {
+                    result += counts[index];
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Checks if there is a card whose type contains all bits of `type`.
+         */
+        bool hasType(shared::CardType type) const
+        {
+            if ( const auto bit = typeBit(type); bit != detail::NO_TYPE_BIT ) {
+                return type_counts[bit] != 0;
+            }
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                if ( counts[index] != 0 && (shared::CARD_TABLE[index].type & type) == type ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if there is a card whose type shares at least one bit with `type`.
+         */
+        bool hasAnyType(shared::CardType type) const { return (types & type) != 0; }
+
+        /**
+         * @brief The bits of shared::CardType that at least one card of the pile has.
+         */
+        unsigned int typeMask() const { return types; }
+
+        // invalid cards are only counted in size()
+        void add(shared::CardId card_id)
+        {
+            if ( card_id.valid() ) {
+                zobrist ^= zobrist::step(card_id.index(), counts[card_id.index()]++);
+                for ( unsigned int mask = shared::CARD_TABLE[card_id.index()].type; mask != 0; mask &= mask - 1 ) {
+                    const auto bit = std::countr_zero(mask);
+                    if ( type_counts[bit]++ == 0 ) {
+                        types |= 1u << bit;
+                    }
+                }
+            }
+            ++total;
+            victory.add(card_id);
+        }
+
+        void remove(shared::CardId card_id)
+        {
+            if ( card_id.valid() ) {
+                zobrist ^= zobrist::step(card_id.index(), --counts[card_id.index()]);
+                for ( unsigned int mask = shared::CARD_TABLE[card_id.index()].type; mask != 0; mask &= mask - 1 ) {
+                    const auto bit = std::countr_zero(mask);
+                    if ( --type_counts[bit] == 0 ) {
+                        types &= ~(1u << bit);
+                    }
+                }
+            }
+            --total;
+            victory.remove(card_id);
+        }
+
+        void clear()
+        {
+            counts.fill(0);
+            type_counts.fill(0);
+            types = 0;
+            total = 0;
+            zobrist = 0;
+            victory.clear();
+        }
+
+        CardCounts &operator+=(const CardCounts &other)
+        {
+            for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+                counts[index] += other.counts[index];
+            }
+            for ( size_t bit = 0; bit < detail::TYPE_BITS; ++bit ) {
+                type_counts[bit] += other.type_counts[bit];
+            }
+            types |= other.types;
+            total += other.total;
+            zobrist = computeHash();
+            victory += other.victory;
+            return *this;
+        }
+
+        friend CardCounts operator+(CardCounts lhs, const CardCounts &rhs) { return lhs += rhs; }
+
+    private:
+        static uint8_t typeBit(shared::CardType type)
+        {
+            return type < detail::TYPE_BIT.size() ? detail::TYPE_BIT[type] : detail::NO_TYPE_BIT;
+        }
+
+        std::array<count_t, shared::CARD_COUNT> counts{};
+        // the number of cards with each bit of shared::CardType, and the bits with at least one card
+        std::array<count_t, detail::TYPE_BITS> type_counts{};
+        unsigned int types = 0;
+        size_t total = 0;
+        uint64_t zobrist = 0;
+        VictoryTally victory;
+    };
+
+    /**
+     * @brief An ordered pile of cards (e.g. the hand of a player) together with its CardCounts.
+     *
+     * Every change of the pile goes through this class, so the counts are always in sync with the cards. Reordering
+     * the cards (sort, shuffle) does not touch the counts.
+     *
+     * The cards are copy-on-write: copying a pile (e.g. in GameState::fork()) shares the cards and the first change
+     * of either copy makes its own. The counts are a fixed-size array and always copied.
+     */
+    class CardPile
+    {
+    public:
+        using container_t = std::vector<shared::CardId>;
+
+        CardPile() = default;
+        CardPile(std::initializer_list<shared::CardId> cards) : CardPile(container_t(cards)) {}
+        CardPile(container_t cards) { *this = std::move(cards); }
+
+        CardPile &operator=(container_t new_cards)
+        {
+            cards = new_cards.empty() ? nullptr : std::make_shared<container_t>(std::move(new_cards));
+            recount();
+            return *this;
+        }
+
+        CardPile &operator=(std::initializer_list<shared::CardId> new_cards) { return *this = container_t(new_cards); }
+
+        const container_t &getCards() const { return cards ? *cards : EMPTY; }
+        const CardCounts &getCounts() const { return counts; }
+
+        size_t size() const { return counts.size(); }
+        bool empty() const { return size() == 0; }
+        auto begin() const { return getCards().begin(); }
+        auto end() const { return getCards().end(); }
+
+        bool contains(shared::CardId card_id) const { return counts.contains(card_id); }
+
+        template <typename Iterator>
+        void insert(container_t::const_iterator position, Iterator first, Iterator last)
+        {
+            // position points into the shared cards, which are not the ones that get changed
+            const auto offset = position - getCards().begin();
+            auto &owned = mutableCards();
+            std::for_each(first, last, [this](shared::CardId card_id) { counts.add(card_id); });
+            owned.insert(owned.begin() + offset, first, last);
+        }
+
+        /**
+         * @brief Removes the first copy of the card.
+         * @return false if there is no such card
+         */
+        bool remove(shared::CardId card_id)
+        {
+            if ( card_id.valid() && !counts.contains(card_id) ) {
+                return false;
+            }
+            const auto it = std::find(begin(), end(), card_id);
+            if ( it == end() ) {
+                return false;
+            }
+            const auto offset = it - begin();
+            auto &owned = mutableCards();
+            owned.erase(owned.begin() + offset);
+            counts.remove(card_id);
+            return true;
+        }
+
+        /**
+         * @brief Removes the cards in [first, last) and returns them in pile order.
+         */
+        container_t extract(container_t::const_iterator first, container_t::const_iterator last)
+        {
+            container_t extracted(first, last);
+            const auto offset = first - begin();
+            std::for_each(extracted.begin(), extracted.end(),
+                          [this](shared::CardId card_id) { counts.remove(card_id); });
+            auto &owned = mutableCards();
+            owned.erase(owned.begin() + offset, owned.begin() + offset + std::ssize(extracted));
+            return extracted;
+        }
+
+        void clear()
+        {
+            if ( cards.use_count() == 1 ) {
+                // keeps the capacity for the next cards
+                cards->clear();
+            } else {
+                cards = nullptr;
+            }
+            counts.clear();
+        }
+
+        /**
+         * @brief Inserts the cards into a pile that is sorted by `compare`, so that it stays sorted. Cards that
+         * compare equal keep their order, the new ones come last.
+         */
+        template <typename Iterator, typename Compare>
+        void insertSorted(Iterator first, Iterator last, Compare compare)
+        {
+            auto &owned = mutableCards();
+            const auto old_size = std::ssize(owned);
+            std::for_each(first, last, [this](shared::CardId card_id) { counts.add(card_id); });
+            owned.insert(owned.end(), first, last);
+            std::stable_sort(owned.begin() + old_size, owned.end(), compare);
+            std::inplace_merge(owned.begin(), owned.begin() + old_size, owned.end(), compare);
+        }
+
+        template <typename Compare>
+        void sort(Compare compare)
+        {
+            if ( !empty() ) {
+                auto &owned = mutableCards();
+                std::sort(owned.begin(), owned.end(), compare);
+            }
+        }
+
+        template <typename Generator>
+        void shuffle(Generator &generator)
+        {
+            if ( !empty() ) {
+                auto &owned = mutableCards();
+                std::shuffle(owned.begin(), owned.end(), generator);
+            }
+        }
+
+    private:
+        inline static const container_t EMPTY;
+
+        /**
+         * @brief The cards of this pile only, copies them if they are shared with another pile.
+         */
+        container_t &mutableCards()
+        {
+            if ( !cards ) {
+                cards = std::make_shared<container_t>();
+            } else if ( cards.use_count() > 1 ) {
+                cards = std::make_shared<container_t>(*cards);
+            }
+            return *cards;
+        }
+
+        void recount()
+        {
+            counts.clear();
+            std::for_each(begin(), end(), [this](shared::CardId card_id) { counts.add(card_id); });
+        }
+
+        // nullptr for an empty pile that never had cards
+        std::shared_ptr<container_t> cards;
+        CardCounts counts;
+    };
+
+    /**
+     * @brief The draw pile of a player. It is stored as a CardPile with the top card at the back, so drawing and
+     * putting cards on top only touch the moved cards.
+     *
+     * All functions use the order of the pile as seen by the player: top card first.
+     */
+    class DrawPile
+    {
+    public:
+        using container_t = CardPile::container_t;
+
+        DrawPile() = default;
+        DrawPile(std::initializer_list<shared::CardId> cards) : DrawPile(container_t(cards)) {}
+        DrawPile(container_t cards) : stack(reversed(std::move(cards))) {}
+
+        DrawPile &operator=(container_t new_cards)
+        {
+            stack = reversed(std::move(new_cards));
+            return *this;
+        }
+
+        DrawPile &operator=(std::initializer_list<shared::CardId> new_cards) { return *this = container_t(new_cards); }
+
+        /**
+         * @brief A view of the cards, top card first.
+         */
+        auto getCards() const { return std::views::reverse(stack.getCards()); }
+        const CardCounts &getCounts() const { return stack.getCounts(); }
+
+        size_t size() const { return stack.size(); }
+        bool empty() const { return stack.empty(); }
+
+        /**
+         * @brief Puts the cards on top of the pile, `first` ends up as the top card.
+         */
+        template <typename Iterator>
+        void putOnTop(Iterator first, Iterator last)
+        {
+            stack.insert(stack.end(), std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+        }
+
+        /**
+         * @brief Puts the cards below the pile, `last - 1` ends up as the bottom card.
+         */
+        template <typename Iterator>
+        void putAtBottom(Iterator first, Iterator last)
+        {
+            stack.insert(stack.begin(), std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+        }
+
+        /**
+         * @brief Removes the top n cards and returns them, top card first.
+         */
+        container_t takeTop(size_t n)
+        {
+            auto cards = stack.extract(stack.end() - static_cast<std::ptrdiff_t>(n), stack.end());
+            std::reverse(cards.begin(), cards.end());
+            return cards;
+        }
+
+        /**
+         * @brief Removes the bottom n cards and returns them in pile order (bottom card last).
+         */
+        container_t takeBottom(size_t n)
+        {
+            auto cards = stack.extract(stack.begin(), stack.begin() + static_cast<std::ptrdiff_t>(n));
+            std::reverse(cards.begin(), cards.end());
+            return cards;
+        }
+
+        template <typename Generator>
+        void shuffle(Generator &generator)
+        {
+            stack.shuffle(generator);
+        }
+
+    private:
+        static container_t reversed(container_t cards)
+        {
+            std::reverse(cards.begin(), cards.end());
+            return cards;
+        }
+
+        // bottom card first, top card last
+        CardPile stack;
+    };
+
+    /**
+     * @brief The hand of a player. It is always in the order it is shown in: actions, then treasures, then victory
+     * cards, each by cost and then by name (see detail::HAND_ORDER).
+     *
+     * Cards are inserted at their place, so the hand never has to be sorted as a whole.
+     */
+    class HandPile
+    {
+    public:
+        using container_t = CardPile::container_t;
+
+        HandPile() = default;
+        HandPile(std::initializer_list<shared::CardId> cards) : HandPile(container_t(cards)) {}
+        HandPile(container_t cards) : pile(sorted(std::move(cards))) {}
+
+        HandPile &operator=(container_t new_cards)
+        {
+            pile = sorted(std::move(new_cards));
+            return *this;
+        }
+
+        HandPile &operator=(std::initializer_list<shared::CardId> new_cards) { return *this = container_t(new_cards); }
+
+        const container_t &getCards() const { return pile.getCards(); }
+        const CardCounts &getCounts() const { return pile.getCounts(); }
+
+        size_t size() const { return pile.size(); }
+        bool empty() const { return pile.empty(); }
+        auto begin() const { return pile.begin(); }
+        auto end() const { return pile.end(); }
+
+        bool contains(shared::CardId card_id) const { return pile.contains(card_id); }
+
+        /**
+         * @brief Inserts each card at its place, after the copies that are already in the hand.
+         */
+        template <typename Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            pile.insertSorted(first, last, comesBefore);
+        }
+
+        bool remove(shared::CardId card_id) { return pile.remove(card_id); }
+
+        container_t extract(container_t::const_iterator first, container_t::const_iterator last)
+        {
+            return pile.extract(first, last);
+        }
+
+        void clear() { pile.clear(); }
+
+        /**
+         * @brief If card_a is shown before card_b.
+         */
+        static bool comesBefore(shared::CardId card_a, shared::CardId card_b) { return place(card_a) < place(card_b); }
+
+    private:
+        static uint8_t place(shared::CardId card_id)
+        {
+            return detail::HAND_ORDER[card_id.valid() ? card_id.index() : shared::CARD_COUNT];
+        }
+
+        static container_t sorted(container_t cards)
+        {
+            std::stable_sort(cards.begin(), cards.end(), comesBefore);
+            return cards;
+        }
+
+        CardPile pile;
+    };
+} // namespace server
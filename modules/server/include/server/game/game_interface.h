@@ -1,7 +1,11 @@
 #pragma once
 
+#include <new>
+#include <variant>
+
 #include <server/game/behaviour_chain.h>
 #include <server/game/game_state.h>
+#include <server/game/move_result.h>
 
 namespace server
 {
@@ -14,6 +18,10 @@ namespace server
     public:
         using ptr_t = std::unique_ptr<GameInterface>;
         using response_t = server::BehaviourChain::ret_t;
+        /**
+         * @brief The orders after a move, or why the move was rejected.
+         */
+        using result_t = std::variant<response_t, MoveResult>;
 
         GameInterface operator=(const GameInterface &other) = delete;
         GameInterface(const GameInterface &other) = delete;
@@ -35,15 +43,34 @@ namespace server
          */
         response_t handleMessage(std::unique_ptr<shared::ClientToServerMessage> &action_decision);
 
+        /**
+         * @brief Same as handleMessage, but a move that is not allowed (out of turn, in the wrong phase, can not
+         * afford the card, ...) is returned instead of thrown. A decision that a behaviour rejects and errors the game
+         * can not recover from are still thrown.
+         */
+        result_t handleMessage(std::unique_ptr<shared::ClientToServerMessage> &action_decision, std::nothrow_t);
+
+        inline auto getGameState(Player::seat_t seat) { return game_state->getReducedState(seat); }
+
         inline auto getGameState(const shared::PlayerBase::id_t &player_id)
         {
-            return game_state->getReducedState(player_id);
+            return game_state->getReducedState(game_state->getSeat(player_id));
         }
 
+        /**
+         * @brief The ids of the players by seat, the orders in a response_t are given by seat.
+         */
+        const std::vector<Player::id_t> &getPlayerIDs() const { return game_state->getAllPlayerIDs(); }
+
         response_t startGame() { return nextPhase(); }
 
         bool isGameOver() const { return game_state->isGameOver(); }
 
+        /**
+         * @brief From 0 at the start to 1 at the end of the game, cheap enough to be polled.
+         */
+        double getProgress() const { return game_state->getProgress(); }
+
         response_t terminate()
         {
             game_state->endTurn();
@@ -76,22 +103,20 @@ namespace server
 /**
  * @brief The handlers obviously handle the messages. The functions are specialised for certain decision types and
  * perform all required checks themselves. Each function will return an OrderResponse containing the necessary
- * information for the clients.
+ * information for the clients, or the MoveResult if the move was rejected.
  */
 #pragma region HANDLERS
 
-        response_t passToBehaviour(std::unique_ptr<shared::ActionDecisionMessage> &message);
+        result_t passToBehaviour(std::unique_ptr<shared::ActionDecisionMessage> &message, Player::seat_t requestor);
 
-        response_t playActionCardDecisionHandler(std::unique_ptr<shared::PlayActionCardDecision> decision,
-                                                 const Player::id_t &affected_player_id);
+        result_t playActionCardDecisionHandler(std::unique_ptr<shared::PlayActionCardDecision> decision,
+                                               Player::seat_t requestor);
 
-        response_t buyCardDecisionHandler(std::unique_ptr<shared::BuyCardDecision> decision,
-                                          const Player::id_t &affected_player_id);
+        result_t buyCardDecisionHandler(std::unique_ptr<shared::BuyCardDecision> decision, Player::seat_t requestor);
 
-        response_t endTurnDecisionHandler(std::unique_ptr<shared::EndTurnDecision> decision,
-                                          const Player::id_t &affected_player_id);
+        result_t endTurnDecisionHandler(std::unique_ptr<shared::EndTurnDecision> decision, Player::seat_t requestor);
 
-        response_t endActionPhaseDecisionHandler(std::unique_ptr<shared::EndActionPhaseDecision> decision,
-                                                 const Player::id_t &affected_player_id);
+        result_t endActionPhaseDecisionHandler(std::unique_ptr<shared::EndActionPhaseDecision> decision,
+                                               Player::seat_t requestor);
     }; // namespace server
 } // namespace server
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include <shared/game/cards/card_id.h>
+#include <shared/game/cards/card_table.h>
+#include <shared/game/game_state/board_base.h>
+#include <shared/utils/random.h>
+
+namespace server
+{
+    /**
+     * @brief The cards and stats of a player in a GameSnapshot.
+     *
+     * All piles share one array of card indices: the draw pile (top card first), the hand, the discard pile and the
+     * staged cards, one after the other. A player takes four cache lines.
+     */
+    struct PlayerSnapshot
+    {
+        static constexpr size_t MAX_CARDS = 214;
+
+        shared::Xoshiro256::state_t rng;
+        uint16_t actions;
+        uint16_t buys;
+        uint16_t treasure;
+        uint8_t draw_pile_size;
+        uint8_t hand_size;
+        uint8_t discard_pile_size;
+        uint8_t staged_size;
+        std::array<shared::CardId::index_t, MAX_CARDS> cards;
+
+        bool operator==(const PlayerSnapshot &other) const = default;
+    };
+
+    /**
+     * @brief The supply, trash and played cards in a GameSnapshot. The supply and the trash are counts per card
+     * index, the order of the trash is not kept.
+     */
+    struct BoardSnapshot
+    {
+        // at least 64, rounded up so that GameSnapshot has no padding
+        static constexpr size_t MAX_PLAYED_CARDS = 64 + (8 - (15 + 2 * shared::CARD_COUNT + 64) % 8) % 8;
+
+        std::array<shared::CardId::index_t, shared::board_config::KINGDOM_CARD_COUNT> kingdom;
+        std::array<uint8_t, shared::CARD_COUNT> supply;
+        std::array<uint8_t, shared::CARD_COUNT> trash;
+        uint8_t played_count;
+        std::array<shared::CardId::index_t, MAX_PLAYED_CARDS> played;
+
+        bool operator==(const BoardSnapshot &other) const = default;
+    };
+
+    /**
+     * @brief A running game in a fixed-size, trivially copyable struct (see GameState::snapshot()).
+     *
+     * A snapshot can be copied with memcpy, stored in bulk and sent to another process as it is. It has no padding
+     * and all unused entries are zero, so equal games have equal bytes and the bytes can be hashed directly.
+     *
+     * The ids of the players are not part of the snapshot, players are stored by seat (the order of the game). They
+     * have to be given back to GameState(const GameSnapshot &, ...).
+     */
+    struct GameSnapshot
+    {
+        shared::Xoshiro256::state_t rng;
+        uint64_t seed;
+        std::array<PlayerSnapshot, shared::board_config::MAX_PLAYER_COUNT> players;
+        BoardSnapshot board;
+        uint8_t player_count;
+        uint8_t current_player;
+        uint8_t phase;
+        uint8_t is_over;
+
+        bool operator==(const GameSnapshot &other) const = default;
+    };
+
+    /**
+     * @brief Checks that a snapshot describes a game that can be rebuilt: the counts fit into their arrays and every
+     * card index, the phase and the current seat exist. Snapshots may come from another process or from storage, so
+     * this is checked before anything is read through them.
+     * @throws exception::InvalidSnapshot if the snapshot is not valid
+     */
+    void validate(const GameSnapshot &snapshot);
+
+    static_assert(sizeof(PlayerSnapshot) == 256, "a player should take exactly four cache lines");
+    static_assert(std::is_trivially_copyable_v<GameSnapshot>, "snapshots are copied with memcpy");
+    static_assert(std::has_unique_object_representations_v<GameSnapshot>, "snapshots are hashed byte by byte");
+} // namespace server
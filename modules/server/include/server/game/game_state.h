@@ -1,9 +1,11 @@
 #pragma once
 
-#include <map>
 #include <memory>
+#include <new>
 #include <vector>
 
+#include <server/game/game_snapshot.h>
+#include <server/game/move_result.h>
 #include <server/game/server_board.h>
 #include <server/game/server_player.h>
 
@@ -14,6 +16,7 @@
 #include <shared/game/game_state/game_phase.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/random.h>
 
 namespace server
 {
@@ -21,22 +24,71 @@ namespace server
     /**
      * @brief This holds the complete game stae on the server.
      *
+     * The players are stored by seat. Messages name players by their id, the GameInterface resolves it to a seat once
+     * (see getSeat()) and the moves and behaviours work with seats from there on.
+     *
      * @see reduced::GameState
      */
     class GameState
     {
-        std::map<Player::id_t, Player::ptr_t> player_map;
+        // by seat, the order of the game
+        std::vector<Player> players;
         std::vector<Player::id_t> player_order;
-        unsigned int current_player_idx;
+        Player::seat_t current_player_idx;
         ServerBoard::ptr_t board;
         shared::GamePhase phase;
         bool is_actually_over = false;
+        // all randomness of the game comes from this seed, see getSeed()
+        uint64_t seed = 0;
+        shared::Xoshiro256 rng{0};
 
     public:
         GameState();
-        GameState(const std::vector<shared::CardBase::id_t> &play_cards, const std::vector<Player::id_t> &player_ids);
+        /**
+         * @param seed the same seed, players and actions give the same game
+         */
+        GameState(const std::vector<shared::CardBase::id_t> &play_cards, const std::vector<Player::id_t> &player_ids,
+                  uint64_t seed = shared::randomSeed());
         ~GameState();
-        GameState(GameState &&other);
+        GameState(GameState &&other) noexcept;
+        GameState &operator=(const GameState &) = delete;
+
+        /**
+         * @brief An independent copy of the game, e.g. to try out moves for a bot.
+         *
+         * The players, the board and the generators are copied, so the same moves give the same game in both
+         * copies. The cards of the players are copy-on-write (see CardPile), a fork only copies the piles that are
+         * changed afterwards.
+         */
+        GameState fork() const;
+
+        /**
+         * @brief Rebuilds a game from its snapshot.
+         * @param player_ids the ids of the players by seat, see GameSnapshot
+         * @throws exception::InvalidSnapshot if the snapshot is not valid, see validate()
+         * @throws exception::PlayerCountMismatch if there are not as many ids as players in the snapshot
+         */
+        GameState(const GameSnapshot &snapshot, const std::vector<Player::id_t> &player_ids);
+
+        /**
+         * @brief The game in a fixed-size, trivially copyable struct, see GameSnapshot.
+         * @throws std::length_error if a player has too many cards or too many cards are played
+         */
+        GameSnapshot snapshot() const;
+
+        /**
+         * @brief 64 bit Zobrist hash of the position: the cards in every pile (not their order), the stats of the
+         * players, the current player and the phase. The generators are not part of it.
+         *
+         * The piles keep their part of the hash up to date whenever a card is added, taken or moved, so this only
+         * puts a few words together. In debug builds it is checked against computeHash().
+         */
+        uint64_t hash() const;
+
+        /**
+         * @brief The same as hash(), but computed from the cards, e.g. to check the hash of a game.
+         */
+        uint64_t computeHash() const;
 
         void initialisePlayers(const std::vector<Player::id_t> &player_ids);
         void initialiseBoard(const std::vector<shared::CardBase::id_t> &selected_cards);
@@ -44,76 +96,100 @@ namespace server
 #pragma region TRY_FUNCTIONS
 
         /**
-         * @brief Ends the action phase if possible
-         * @throws exception::InvalidRequest, exception::OutOfPhase
+         * Every move has two versions: the one without std::nothrow throws the exception that corresponds to the
+         * MoveError, the one with std::nothrow returns the MoveError instead. A rejected move does not change the
+         * game.
          */
-        void tryEndActionPhase(const shared::PlayerBase::id_t &requestor_id);
 
-        inline void tryEndTurn(const shared::PlayerBase::id_t &requestor_id)
-        {
-            guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
-            guaranteeNotPhase(requestor_id, shared::GamePhase::PLAYING_ACTION_CARD, "Can not end turn", FUNC_NAME);
+        /**
+         * @brief Ends the action phase if possible
+         * @throws exception::NotYourTurn, exception::OutOfPhase
+         */
+        void tryEndActionPhase(Player::seat_t requestor);
+        MoveResult tryEndActionPhase(Player::seat_t requestor, std::nothrow_t);
 
-            endTurn();
-        }
+        /**
+         * @throws exception::NotYourTurn, exception::OutOfPhase
+         */
+        void tryEndTurn(Player::seat_t requestor);
+        MoveResult tryEndTurn(Player::seat_t requestor, std::nothrow_t);
 
         /**
          * @brief Buys a card from the board and adds it to the players discard pile.
-         * @throws exception::InvalidRequest, exception::OutOfPhase, exception::InsufficientFunds
+         * @throws exception::NotYourTurn, exception::OutOfPhase, exception::InsufficientFunds,
+         * exception::CardNotAvailable
          */
-        void tryBuy(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        void tryBuy(Player::seat_t requestor, shared::CardId card_id);
+        MoveResult tryBuy(Player::seat_t requestor, shared::CardId card_id, std::nothrow_t);
 
         /**
          * @brief Tries to play all treasures from a players hand.
          * @return All treasure cards in a players hand
          */
-        std::vector<shared::CardBase::id_t> tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id);
+        std::vector<shared::CardId> tryPlayAllTreasures(Player::seat_t requestor);
 
         /**
          * @brief Tries to play the given card_id from the specified pile.
+         * @throws exception::NotYourTurn, exception::OutOfPhase, exception::OutOfActions,
+         * exception::CardNotAvailable
          */
         template <enum shared::CardAccess FROM>
-        inline void tryPlay(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        inline void tryPlay(Player::seat_t requestor, shared::CardId card_id);
+        template <enum shared::CardAccess FROM>
+        inline MoveResult tryPlay(Player::seat_t requestor, shared::CardId card_id, std::nothrow_t);
 
         /**
          * @brief Tries to gain the given card_id to the given pile.
+         * @throws exception::OutOfPhase, exception::CardNotAvailable
          */
         template <enum shared::CardAccess TO>
-        inline void tryGain(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        inline void tryGain(Player::seat_t requestor, shared::CardId card_id);
+        template <enum shared::CardAccess TO>
+        inline MoveResult tryGain(Player::seat_t requestor, shared::CardId card_id, std::nothrow_t);
 
 #pragma region GETTERS / SETTERS
 
-        std::unique_ptr<reduced::GameState> getReducedState(const Player::id_t &affected_player);
+        std::unique_ptr<reduced::GameState> getReducedState(Player::seat_t target_player);
 
         shared::GamePhase getPhase() const { return phase; }
+        uint64_t getSeed() const { return seed; }
         ServerBoard::ptr_t getBoard() { return board; }
 
+        Player::seat_t getCurrentSeat() const { return current_player_idx; }
         const Player::id_t &getCurrentPlayerId() const { return player_order[current_player_idx]; }
-        Player &getCurrentPlayer() { return *player_map[getCurrentPlayerId()]; }
+        Player &getCurrentPlayer() { return players[current_player_idx]; }
 
-        Player &getPlayer(const Player::id_t &id) { return *player_map.at(id); }
-        const Player &getPlayer(const Player::id_t &id) const { return *player_map.at(id); }
+        size_t getPlayerCount() const { return players.size(); }
+        Player &getPlayer(Player::seat_t seat) { return players[seat]; }
+        const Player &getPlayer(Player::seat_t seat) const { return players[seat]; }
+
+        /**
+         * @brief The seat of the player with this id.
+         * @throws std::out_of_range if there is no such player
+         */
+        Player::seat_t getSeat(const Player::id_t &id) const;
+
+        Player &getPlayer(const Player::id_t &id) { return players[getSeat(id)]; }
+        const Player &getPlayer(const Player::id_t &id) const { return players[getSeat(id)]; }
 
         inline void setPhase(shared::GamePhase new_phase) { phase = new_phase; }
 
         void endTurn();
 
         /**
-         * @return vector containing all player ids
+         * @return vector containing all player ids, by seat
          */
         const std::vector<Player::id_t> &getAllPlayerIDs() const { return player_order; }
 
         /**
-         * @brief Returns a vector containing the enemies of the calling player_id. The enemies are provided in playing
-         * order.
-         * @return vector containing the enemies, where vector[0]=next player in sequence
+         * @return true; if the game is over
          */
-        std::vector<Player::id_t> getEnemyIDs(const Player::id_t &player_id) const;
+        bool isGameOver() const { return board->isGameOver() && (is_actually_over); }
 
         /**
-         * @return true; if the game is over
+         * @brief How close the game is to its end, from 0 to 1 (see ServerBoard::getProgress()).
          */
-        bool isGameOver() const { return board->isGameOver() && (is_actually_over); }
+        double getProgress() const { return board->getProgress(); }
 
         /**
          * @brief If the game has ended, this will return the results of the game.
@@ -137,31 +213,46 @@ namespace server
         void maybeSwitchPhase();
 
     private:
+        // see fork()
+        GameState(const GameState &other);
+
         /**
          * @brief Forces a phase switch. This is called if a player ends a phase early
          */
         void forceSwitchPhase();
 
         inline void resetPhase() { phase = shared::GamePhase::ACTION_PHASE; }
-        inline void switchPlayer() { current_player_idx = (current_player_idx + 1) % player_map.size(); }
+        inline void switchPlayer() { current_player_idx = (current_player_idx + 1) % players.size(); }
 
 #pragma region ASSERTION_HELPERS
-        void printSuccess(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name);
-        void guaranteePhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                            shared::GamePhase expected_phase, const std::string &error_msg,
-                            const std::string &function_name);
+        void printSuccess(Player::seat_t requestor, const std::string &function_name);
 
-        void guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                            const std::string &error_msg, const std::string &function_name);
+        /**
+         * @brief Logs why a move was rejected and throws the corresponding exception.
+         */
+        [[noreturn]] void rejectMove(const MoveResult &result, Player::seat_t requestor,
+                                     const std::string &function_name);
 
-        void guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                               shared::GamePhase expected_phase, const std::string &error_msg,
-                               const std::string &function_name);
+        MoveResult checkIsCurrentPlayer(Player::seat_t requestor) const
+        {
+            return requestor == current_player_idx ? MoveResult() : MoveError::NOT_YOUR_TURN;
+        }
 
-        void guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                               const std::string &error_msg, const std::string &function_name);
+        /**
+         * @param error_msg what the player tried to do, must be a string literal (see MoveResult)
+         */
+        MoveResult checkPhase(shared::GamePhase expected_phase, const char *error_msg) const
+        {
+            return phase == expected_phase ? MoveResult() : MoveResult(MoveError::OUT_OF_PHASE, error_msg, phase);
+        }
 
-        void guaranteeIsCurrentPlayer(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name);
+        /**
+         * @param error_msg what the player tried to do, must be a string literal (see MoveResult)
+         */
+        MoveResult checkNotPhase(shared::GamePhase unexpected_phase, const char *error_msg) const
+        {
+            return phase != unexpected_phase ? MoveResult() : MoveResult(MoveError::OUT_OF_PHASE, error_msg, phase);
+        }
     };
 
 #include "game_state.hpp"
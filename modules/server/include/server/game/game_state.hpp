@@ -3,65 +3,79 @@
 #include "game_state.h"
 
 template <enum shared::CardAccess FROM>
-inline void server::GameState::tryPlay(const shared::PlayerBase::id_t &requestor_id,
-                                       const shared::CardBase::id_t &card_id)
+inline void server::GameState::tryPlay(Player::seat_t requestor, shared::CardId card_id)
 {
-    if constexpr ( FROM != shared::CardAccess::HAND && FROM != shared::CardAccess::STAGED_CARDS ) {
-        LOG(ERROR) << "Cards can only be played from " << toString(shared::CardAccess::HAND) << " or from "
-                   << toString(shared::CardAccess::STAGED_CARDS) << ". " << toString(FROM) << " is not allowed!";
-        static_assert((FROM == shared::CardAccess::HAND || FROM == shared::CardAccess::STAGED_CARDS) &&
-                      "provided CardAccess is not allowed!"); // this is on purpose, this way this fails to
-                                                              // compile and the error can not go unnoticed
+    if ( auto result = tryPlay<FROM>(requestor, card_id, std::nothrow); !result ) {
+        LOG(WARN) << "Player \'" << getPlayer(requestor).getId() << "\' attempted to play card \'" << card_id
+                  << "\' from " << toString(FROM);
+        rejectMove(result, requestor, FUNC_NAME);
     }
+    printSuccess(requestor, FUNC_NAME);
+}
 
-    guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
+template <enum shared::CardAccess FROM>
+inline server::MoveResult server::GameState::tryPlay(Player::seat_t requestor, shared::CardId card_id,
+                                                     std::nothrow_t)
+{
+    static_assert((FROM == shared::CardAccess::HAND || FROM == shared::CardAccess::STAGED_CARDS) &&
+                  "provided CardAccess is not allowed!"); // this is on purpose, this way this fails to
+                                                          // compile and the error can not go unnoticed
 
-    if constexpr ( FROM == shared::CardAccess::HAND ) {
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::ACTION_PHASE, "You can not play a card", FUNC_NAME);
+    if ( auto result = checkIsCurrentPlayer(requestor); !result ) {
+        return result;
+    }
 
-        if ( getPlayer(requestor_id).getActions() == 0 ) {
-            LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card_id
-                      << "\' with no actions left.";
-            throw exception::OutOfActions();
+    auto &player = getPlayer(requestor);
+    if constexpr ( FROM == shared::CardAccess::HAND ) {
+        if ( auto result = checkPhase(shared::GamePhase::ACTION_PHASE, "You can not play a card"); !result ) {
+            return result;
+        }
+        if ( player.getActions() == 0 ) {
+            return MoveError::OUT_OF_ACTIONS;
         }
     } else if constexpr ( FROM == shared::CardAccess::STAGED_CARDS ) {
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::PLAYING_ACTION_CARD, "You can not play a card",
-                       FUNC_NAME);
+        if ( auto result = checkPhase(shared::GamePhase::PLAYING_ACTION_CARD, "You can not play a card"); !result ) {
+            return result;
+        }
     }
 
-    if ( !getPlayer(requestor_id).hasCard<FROM>(card_id) ) {
-        LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card_id << "\' not in "
-                  << toString(FROM);
-        throw exception::CardNotAvailable();
+    if ( !player.hasCard<FROM>(card_id) ) {
+        return MoveError::CARD_NOT_AVAILABLE;
     }
 
-    auto &player = getPlayer(requestor_id);
     player.take<FROM>(card_id);
     if constexpr ( FROM == shared::CardAccess::HAND ) {
         player.decActions();
     }
     board->addToPlayedCards(card_id);
-
-    printSuccess(requestor_id, FUNC_NAME);
+    return {};
 }
 
 template <enum shared::CardAccess TO>
-inline void server::GameState::tryGain(const shared::PlayerBase::id_t &requestor_id,
-                                       const shared::CardBase::id_t &card_id)
+inline void server::GameState::tryGain(Player::seat_t requestor, shared::CardId card_id)
 {
-    if constexpr ( TO != shared::HAND && TO != shared::DISCARD_PILE ) {
-        LOG(ERROR) << "Cards can only be gained to " << toString(shared::HAND) << " or to "
-                   << toString(shared::STAGED_CARDS) << ". " << toString(TO) << " is not allowed!";
-        static_assert((TO == shared::HAND || TO == shared::DISCARD_PILE) &&
-                      "CardAccess not allowed!"); // this is on purpose, this way this fails to
-                                                  // compile and the error can not go unnoticed
+    if ( auto result = tryGain<TO>(requestor, card_id, std::nothrow); !result ) {
+        LOG(WARN) << "Player \'" << getPlayer(requestor).getId() << "\' attempted to gain card \'" << card_id << "\'";
+        rejectMove(result, requestor, FUNC_NAME);
     }
+    printSuccess(requestor, FUNC_NAME);
+}
 
-    guaranteePhase(requestor_id, card_id, shared::GamePhase::PLAYING_ACTION_CARD, "You can not gain a card", FUNC_NAME);
+template <enum shared::CardAccess TO>
+inline server::MoveResult server::GameState::tryGain(Player::seat_t requestor, shared::CardId card_id,
+                                                     std::nothrow_t)
+{
+    static_assert((TO == shared::HAND || TO == shared::DISCARD_PILE) &&
+                  "CardAccess not allowed!"); // this is on purpose, this way this fails to
+                                              // compile and the error can not go unnoticed
 
-    board->tryTake(card_id);
-    auto &player = getPlayer(requestor_id);
-    player.add<TO>(card_id);
+    if ( auto result = checkPhase(shared::GamePhase::PLAYING_ACTION_CARD, "You can not gain a card"); !result ) {
+        return result;
+    }
+    if ( !board->tryTake(card_id, std::nothrow) ) {
+        return MoveError::CARD_NOT_AVAILABLE;
+    }
 
-    printSuccess(requestor_id, FUNC_NAME);
+    getPlayer(requestor).add<TO>(card_id);
+    return {};
 }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <shared/game/game_state/game_phase.h>
+
+namespace server
+{
+    /**
+     * @brief Why a move of a player was rejected. Every error corresponds to one of the exceptions in
+     * shared/utils/exception.h, see MoveResult::raise().
+     */
+    enum class MoveError : uint8_t
+    {
+        NONE,
+        NOT_YOUR_TURN,
+        OUT_OF_PHASE,
+        OUT_OF_ACTIONS,
+        INSUFFICIENT_FUNDS,
+        CARD_NOT_AVAILABLE,
+    };
+
+    /**
+     * @brief Result of a move that did not throw (see the std::nothrow overloads of GameState).
+     *
+     * Rejected moves are part of a normal game (and buggy bots make lots of them), so they are reported without
+     * unwinding. A result is cheap to create: the context of an OUT_OF_PHASE error is a string literal and the text
+     * for the player is only built by message().
+     */
+    class [[nodiscard]] MoveResult
+    {
+    public:
+        MoveResult() = default;
+        MoveResult(MoveError error) : error_code(error) {}
+        /**
+         * @param context what the player tried to do, e.g. "You can not buy a card", must be a string literal
+         */
+        MoveResult(MoveError error, const char *context, shared::GamePhase phase) :
+            error_code(error), context(context), phase(phase)
+        {}
+
+        bool ok() const { return error_code == MoveError::NONE; }
+        explicit operator bool() const { return ok(); }
+        MoveError error() const { return error_code; }
+
+        /**
+         * @brief The text of the exception that raise() would throw, meant to be sent to the player.
+         */
+        std::string message() const;
+
+        /**
+         * @brief Throws the exception that corresponds to the error.
+         * @throws exception::UnreachableCode if the move was successful
+         */
+        [[noreturn]] void raise() const;
+
+        void throwIfError() const
+        {
+            if ( !ok() ) {
+                raise();
+            }
+        }
+
+    private:
+        MoveError error_code = MoveError::NONE;
+        const char *context = "";
+        shared::GamePhase phase = shared::GamePhase::ACTION_PHASE;
+    };
+} // namespace server
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <new>
 #include <vector>
 
+#include <server/game/card_pile.h>
+#include <server/game/game_snapshot.h>
+#include <shared/game/cards/card_id.h>
 #include <shared/game/game_state/board_base.h>
 #include <shared/utils/assert.h>
 #include <shared/utils/logger.h>
@@ -30,6 +34,22 @@ namespace server
          */
         static ptr_t make(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count);
 
+        /**
+         * @brief Rebuilds a board from its snapshot.
+         * @pre the snapshot is valid, see validate(const GameSnapshot &)
+         */
+        static ptr_t make(const BoardSnapshot &snapshot, size_t player_count);
+
+        /**
+         * @brief An independent copy of the board, e.g. for GameState::fork().
+         */
+        ptr_t clone() const;
+
+        /**
+         * @throws std::length_error if more than BoardSnapshot::MAX_PLAYED_CARDS cards are played
+         */
+        BoardSnapshot snapshot() const;
+
         /**
          * @brief Returns the reduced representation of the board (exactly the same as this one, but with less
          * functions)
@@ -39,22 +59,49 @@ namespace server
         /**
          * @brief Throws if the card_id one wants to buy is not available.
          */
-        void tryTake(const shared::CardBase::id_t &card_id);
+        void tryTake(shared::CardId card_id);
+
+        /**
+         * @brief Takes the card if it is available.
+         * @return false if the card is not available, nothing is taken then
+         */
+        bool tryTake(shared::CardId card_id, std::nothrow_t);
 
         /**
          * @brief Checks if the card exists on the board.
          */
-        bool has(const shared::CardBase::id_t &card_id) const;
+        bool has(shared::CardId card_id) const;
+
+        /**
+         * @brief Also keeps the number of empty piles and the hash of the supply up to date.
+         */
+        void setPileCount(shared::CardId card_id, size_t count) override;
+
+        /**
+         * @brief The number of empty supply piles, kept up to date by take() and setPileCount().
+         */
+        size_t getEmptyPilesCount() const override { return empty_piles; }
+
+        /**
+         * @brief If the Province pile or board_config::MAX_NUM_EMPTY_PILES supply piles are empty, in constant time.
+         */
+        bool isGameOver() const override;
+
+        /**
+         * @brief How close the board is to ending the game, from 0 at the start to 1 once isGameOver(). It is the
+         * share of the Provinces that are gone or of the piles that have to be empty, whichever is further.
+         */
+        double getProgress() const;
 
         /**
          * @brief Adds the given card to the played_cards vector.
          */
-        void addToPlayedCards(const shared::CardBase::id_t &card_id);
+        void addToPlayedCards(shared::CardId card_id);
 
         /**
          * @brief Adds the given cards to the played_cards vector.
          */
-        void addToPlayedCards(const std::vector<shared::CardBase::id_t> &cards);
+        void addToPlayedCards(const std::vector<shared::CardId> &cards);
 
         /**
          * @brief Removes the given card from the played_cards vector
@@ -62,17 +109,31 @@ namespace server
          * @return true if the card was removed
          * @return false if the card was not found
          */
-        bool removeFromPlayedCards(const shared::CardBase::id_t &card_id);
+        bool removeFromPlayedCards(shared::CardId card_id);
 
         /**
          * @brief Adds the card_id to the trash
          */
-        void trashCard(const shared::CardBase::id_t &card_id);
+        void trashCard(shared::CardId card_id);
+
+        /**
+         * @brief Zobrist hash of the supply, the trash and the played cards, see GameState::hash().
+         */
+        uint64_t hash() const
+        {
+            return zobrist::place(supply_hash, zobrist::SUPPLY) ^ zobrist::place(trash_counts.hash(), zobrist::TRASH) ^
+                   zobrist::place(played_counts.hash(), zobrist::PLAYED_CARDS);
+        }
+
+        /**
+         * @brief The same as hash(), but computed from the cards.
+         */
+        uint64_t computeHash() const;
 
         /**
          * @brief Returns the played cards
          */
-        const std::vector<shared::CardBase::id_t> &getPlayedCards() const { return played_cards; }
+        const std::vector<shared::CardId> &getPlayedCards() const { return played_card_ids; }
 
         /**
          * @brief Clears the played cards
@@ -80,13 +141,19 @@ namespace server
          * The cards are voided, not trashed.
          * If you want to move them somewhere else, do it before calling this function.
          */
-        void clearPlayedCards() { played_cards.clear(); }
+        void clearPlayedCards()
+        {
+            played_cards.clear();
+            played_card_ids.clear();
+            played_counts.clear();
+        }
 
     protected:
         /**
          * @brief Construct a new Server Board object. This is protected to make testing easier and to enforce the use
          */
         ServerBoard(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count);
+        ServerBoard(const ServerBoard &other) = default;
 
         /**
          * @brief Tries to buy a card based on id.
@@ -95,7 +162,32 @@ namespace server
          * @return true successfully bought the card
          * @return false card_id can not be bought
          */
-        void take(const shared::CardBase::id_t &card_id);
+        void take(shared::CardId card_id);
+
+    private:
+        uint64_t computeSupplyHash() const;
+
+        const shared::Pile &getProvincePile() const { return *getPile(shared::CardId::of("Province")); }
+
+        /**
+         * @brief The supply pile of the card for take() and setPileCount(), nullptr if the card is not in the supply.
+         */
+        shared::Pile *getMutablePile(shared::CardId card_id)
+        {
+            return getPile(card_id) != nullptr ? &piles[pile_slots[card_id.index()]] : nullptr;
+        }
+
+        // same as shared::Board::played_cards, which only holds the names for the JSON representation
+        std::vector<shared::CardId> played_card_ids;
+
+        // kept up to date by take() and setPileCount()
+        size_t empty_piles;
+        size_t initial_provinces;
+
+        // kept up to date for hash()
+        uint64_t supply_hash;
+        CardCounts trash_counts;
+        CardCounts played_counts;
     };
 
 } // namespace server
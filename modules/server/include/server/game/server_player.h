@@ -1,13 +1,14 @@
 #pragma once
 
-#include <deque>
-#include <random>
 #include <vector>
 
+#include <server/game/card_pile.h>
+#include <server/game/game_snapshot.h>
 #include <shared/game/cards/card_base.h>
 #include <shared/game/cards/card_factory.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/random.h>
 
 #include <shared/utils/logger.h>
 
@@ -18,35 +19,91 @@ namespace server
      */
     class Player : public shared::PlayerBase
     {
-        std::vector<shared::CardBase::id_t> draw_pile;
-        std::vector<shared::CardBase::id_t> hand_cards;
+        DrawPile draw_pile;
+        HandPile hand_cards;
+        // shared::PlayerBase::discard_pile only holds the names for the reduced players, see syncDiscardPile()
+        CardPile discard_cards;
 
-        std::vector<shared::CardBase::id_t> staged_cards;
+        CardPile staged_cards;
+
+        // used for shuffling, seeded by the GameState so a game can be replayed
+        shared::Xoshiro256 rng;
+
+        // bumped whenever a pile is handed out for changes, see getMutable()
+        uint64_t cards_version = 0;
+
+        /**
+         * @brief What a reduced view of the player is built from. The view is only built again if this changed.
+         */
+        struct ViewKey
+        {
+            uint64_t cards_version;
+            unsigned int actions;
+            unsigned int buys;
+            unsigned int treasure;
+
+            bool operator==(const ViewKey &other) const = default;
+        };
+
+        // the views of the last getReducedPlayer() and getReducedEnemy(), shared with copies of the player
+        std::shared_ptr<const reduced::Player> player_view;
+        ViewKey player_view_key{};
+        std::shared_ptr<const reduced::Enemy> enemy_view;
+        ViewKey enemy_view_key{};
 
     public:
         using id_t = shared::PlayerBase::id_t;
+        using seat_t = shared::PlayerBase::seat_t;
         using ptr_t = std::unique_ptr<Player>;
-        using card_id = shared::CardBase::id_t;
+        using card_id = shared::CardId;
+
+        explicit Player(shared::PlayerBase::id_t id, uint64_t seed = shared::randomSeed()) :
+            shared::PlayerBase(id), rng(seed){};
 
-        explicit Player(shared::PlayerBase::id_t id) : shared::PlayerBase(id){};
+        /**
+         * @brief A copy of all cards, stats and the generator. Cheap, as the piles are copy-on-write.
+         */
+        Player(const Player &other) = default;
+        Player(Player &&other) noexcept = default;
 
-        Player(const Player &other) :
-            shared::PlayerBase(other), draw_pile(other.draw_pile), hand_cards(other.hand_cards)
-        {}
+        /**
+         * @brief Rebuilds a player from its snapshot.
+         * @pre the snapshot is valid, see validate(const GameSnapshot &)
+         */
+        Player(shared::PlayerBase::id_t id, const PlayerSnapshot &snapshot);
 
+        /**
+         * @throws std::length_error if the player has more than PlayerSnapshot::MAX_CARDS cards
+         */
+        PlayerSnapshot snapshot() const;
+
+        /**
+         * @brief Zobrist hash of the piles and stats of the player at the given seat, see GameState::hash().
+         */
+        uint64_t hash(size_t seat) const;
+
+        /**
+         * @brief The same as hash(), but computed from the cards.
+         */
+        uint64_t computeHash(size_t seat) const;
+
+        /**
+         * @brief The player as seen by itself and by the other players. The views are cached and only built again
+         * if the cards or the stats of the player changed since the last call, otherwise this is a copy.
+         */
         reduced::Player::ptr_t getReducedPlayer();
         reduced::Enemy::ptr_t getReducedEnemy();
 
         void playAvailableTreasureCards();
 
         template <enum shared::CardAccess PILE>
-        inline bool hasCard(const shared::CardBase::id_t &card_id) const;
+        inline bool hasCard(shared::CardId card_id) const;
 
         template <enum shared::CardAccess PILE>
         inline bool hasType(shared::CardType type) const;
 
         template <enum shared::CardAccess PILE>
-        inline std::vector<shared::CardBase::id_t> getType(shared::CardType type) const;
+        inline std::vector<shared::CardId> getType(shared::CardType type) const;
 
         inline bool canBuy(unsigned int cost) { return buys > 0 && treasure >= cost; }
         inline bool canBlock() const { return hasType<shared::CardAccess::HAND>(shared::CardType::REACTION); }
@@ -61,7 +118,7 @@ namespace server
         /**
          * @brief Adds a card to the discard_pile
          */
-        inline void gain(const shared::CardBase::id_t &card_id) { add<shared::DISCARD_PILE>(card_id); }
+        inline void gain(shared::CardId card_id) { add<shared::DISCARD_PILE>(card_id); }
 
         void addActions(unsigned int n) { actions += n; }
         void addBuys(unsigned int n) { buys += n; }
@@ -73,49 +130,63 @@ namespace server
         void endTurn();
 
         /**
-         * @brief Get the victory points of the player.
+         * @brief How many copies of each card are in the indicated pile.
+         */
+        template <enum shared::CardAccess PILE>
+        inline const CardCounts &getCounts() const;
+
+        /**
+         * @brief How many copies of each card are in the deck of the player.
          *
          * This includes the draw_pile, discard_pile and hand_cards.
          * This should only be called when staged_cards are empty.
          */
+        CardCounts getDeckCounts() const;
+
+        /**
+         * @brief Get the victory points of the player, in constant time.
+         *
+         * This includes the draw_pile, discard_pile, hand_cards and staged_cards. The piles keep their points up to
+         * date on every change (see VictoryTally), so this can be used for a live score.
+         */
         int getVictoryPoints() const;
 
         /**
-         * @return A const reference to the indicated pile.
+         * @return A const reference to the indicated pile, for the draw pile a view of it (top card first).
          * @warning Throws if we try to access the trash pile.
          */
         template <enum shared::CardAccess PILE>
-        inline const std::vector<shared::CardBase::id_t> &get() const;
+        inline decltype(auto) get() const;
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(std::vector<shared::CardBase::id_t> &&cards);
+        inline void add(std::vector<shared::CardId> &&cards);
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(const std::vector<shared::CardBase::id_t> &cards);
+        inline void add(const std::vector<shared::CardId> &cards);
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(const shared::CardBase::id_t &card_id);
+        inline void add(shared::CardId card_id);
 
         /**
          * @brief Moves the card ID from pile FROM to pile TO. Trashed cards are simply deleted.
          */
         template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-        inline void move(const shared::CardBase::id_t &card_id);
+        inline void move(shared::CardId card_id);
 
         /**
          * @brief Moves the card IDs from pile FROM to pile TO. Trashed cards are simply deleted.
          */
         template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-        inline void move(const std::vector<shared::CardBase::id_t> &cards);
+        inline void move(const std::vector<shared::CardId> &cards);
 
         /**
          * @brief Moves the first min(n, pile.size()) cards from pile FROM to pile TO.
@@ -129,7 +200,7 @@ namespace server
          * @warning Throws
          */
         template <enum shared::CardAccess FROM>
-        inline shared::CardBase::id_t take(const shared::CardBase::id_t &card_id);
+        inline shared::CardId take(shared::CardId card_id);
 
         /**
          * @brief Removes the card_ids 'cards' with card_id from the indicated pile.
@@ -137,17 +208,9 @@ namespace server
          * @warning Throws
          */
         template <enum shared::CardAccess FROM>
-        inline std::vector<shared::CardBase::id_t> take(const std::vector<shared::CardBase::id_t> &cards);
+        inline std::vector<shared::CardId> take(const std::vector<shared::CardId> &cards);
 
     protected:
-        /**
-         * @brief Get all cards in the deck of the player.
-         *
-         * This includes the draw_pile, discard_pile and hand_cards.
-         * This should only be called when staged_cards are empty.
-         */
-        std::vector<shared::CardBase::id_t> getDeck() const;
-
         /**
          * @brief Resets the 'stats' to:
          * - actions            1
@@ -157,11 +220,25 @@ namespace server
         void resetValues();
 
         /**
-         * @return A mutable reference to the indicated pile.
+         * @brief Writes the names of discard_cards to shared::PlayerBase::discard_pile, which is what gets serialised.
+         */
+        void syncDiscardPile();
+
+        ViewKey viewKey() const { return {cards_version, actions, buys, treasure}; }
+
+        /**
+         * @return A mutable reference to the indicated pile (a DrawPile for the draw pile, a HandPile for the hand,
+         * otherwise a CardPile).
          * @warning Throws if one tries to access the trash pile.
          */
         template <enum shared::CardAccess PILE>
-        inline std::vector<shared::CardBase::id_t> &getMutable();
+        inline auto &getMutable();
+
+        /**
+         * @return A const reference to the indicated pile, including its counts.
+         */
+        template <enum shared::CardAccess PILE>
+        inline const auto &getPile() const;
 
         /**
          * @brief Shuffles the indicated pile PILE
@@ -171,13 +248,18 @@ namespace server
 
         /**
          * @brief Adds the given cards to the specified TO pile.
-         * Will always perform a push_back, except for DRAW_PILE_BOTTOM
+         * Will always perform a push_back, except for DRAW_PILE_BOTTOM and the HAND, which stays in display order
          * @throw std::invalid_argument
          * @tparam TO pile to which we add to
          */
         template <enum shared::CardAccess TO, typename Iterator>
         inline void add(Iterator begin, Iterator end);
 
+        /**
+         * @brief The hash of the player, with the hashes of the piles given by `pile_hash`.
+         */
+        uint64_t hashWith(size_t seat, uint64_t (CardCounts::*pile_hash)() const) const;
+
 
         /**
          * @brief Removes min(n, pile.size()) cards from a pile. If n == 0, pile.size() cards are taken.
@@ -186,7 +268,7 @@ namespace server
          * @tparam FROM, a pile from which we want to take cards
          */
         template <enum shared::CardAccess FROM>
-        inline std::vector<shared::CardBase::id_t> take(unsigned int num_cards = 0);
+        inline std::vector<shared::CardId> take(unsigned int num_cards = 0);
     };
 
 #include "server_player.hpp"
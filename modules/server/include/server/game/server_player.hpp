@@ -2,11 +2,13 @@
 
 #pragma region UTILS
 template <enum shared::CardAccess PILE>
-inline std::vector<shared::CardBase::id_t> &server::Player::getMutable()
+inline auto &server::Player::getMutable()
 {
     static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
+    // the pile might change, the reduced views have to be built again
+    ++cards_version;
     if constexpr ( PILE == shared::DISCARD_PILE ) {
-        return discard_pile;
+        return discard_cards;
     } else if constexpr ( PILE == shared::HAND ) {
         return hand_cards;
     } else if constexpr ( PILE == shared::STAGED_CARDS ) {
@@ -23,12 +25,12 @@ inline std::vector<shared::CardBase::id_t> &server::Player::getMutable()
 }
 
 template <enum shared::CardAccess PILE>
-inline const std::vector<shared::CardBase::id_t> &server::Player::get() const
+inline const auto &server::Player::getPile() const
 {
     static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
 
     if constexpr ( PILE == shared::DISCARD_PILE ) {
-        return discard_pile;
+        return discard_cards;
     } else if constexpr ( PILE == shared::HAND ) {
         return hand_cards;
     } else if constexpr ( PILE == shared::STAGED_CARDS ) {
@@ -45,37 +47,47 @@ inline const std::vector<shared::CardBase::id_t> &server::Player::get() const
 }
 
 template <enum shared::CardAccess PILE>
-inline void server::Player::shuffle()
+inline decltype(auto) server::Player::get() const
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    return getPile<PILE>().getCards();
+}
 
-    auto &cards = getMutable<PILE>();
-    std::shuffle(cards.begin(), cards.end(), gen);
+template <enum shared::CardAccess PILE>
+inline const server::CardCounts &server::Player::getCounts() const
+{
+    return getPile<PILE>().getCounts();
 }
 
 template <enum shared::CardAccess PILE>
-inline bool server::Player::hasCard(const shared::CardBase::id_t &card_id) const
+inline void server::Player::shuffle()
 {
-    const auto &cards = get<PILE>();
-    return std::find_if(cards.begin(), cards.end(), [card_id](const auto &id) { return id == card_id; }) != cards.end();
+    getMutable<PILE>().shuffle(rng);
+}
+
+template <enum shared::CardAccess PILE>
+inline bool server::Player::hasCard(shared::CardId card_id) const
+{
+    return getCounts<PILE>().contains(card_id);
 }
 
 template <enum shared::CardAccess PILE>
 inline bool server::Player::hasType(shared::CardType type) const
 {
-    auto pile = get<PILE>();
-    return std::any_of(pile.begin(), pile.end(), [type](const auto &card_id)
-                       { return (shared::CardFactory::getCard(card_id).getType() & type) == type; });
+    return getCounts<PILE>().hasType(type);
 }
 
 template <enum shared::CardAccess PILE>
-inline std::vector<shared::CardBase::id_t> server::Player::getType(shared::CardType type) const
+inline std::vector<shared::CardId> server::Player::getType(shared::CardType type) const
 {
-    auto pile = get<PILE>();
-    std::vector<shared::CardBase::id_t> cards;
+    std::vector<shared::CardId> cards;
+    if ( !getCounts<PILE>().hasAnyType(type) ) {
+        return cards;
+    }
+    // the cards are returned in pile order
+    const auto &pile = get<PILE>();
     std::copy_if(pile.begin(), pile.end(), std::back_inserter(cards),
-                 [type](const auto &card_id) { return (shared::CardFactory::getCard(card_id).getType() & type) != 0; });
+                 [type](shared::CardId card_id)
+                 { return card_id.valid() && (shared::CARD_TABLE[card_id.index()].type & type) != 0; });
     return cards;
 }
 
@@ -88,26 +100,30 @@ inline void server::Player::add(Iterator begin, Iterator end)
 
     auto &pile = getMutable<TO>();
     if constexpr ( TO == shared::DRAW_PILE_TOP ) {
-        pile.insert(pile.begin(), begin, end);
+        pile.putOnTop(begin, end);
+    } else if constexpr ( TO == shared::DRAW_PILE_BOTTOM ) {
+        pile.putAtBottom(begin, end);
+    } else if constexpr ( TO == shared::HAND ) {
+        pile.insert(begin, end);
     } else {
         pile.insert(pile.end(), begin, end);
     }
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(std::vector<shared::CardBase::id_t> &&cards)
+inline void server::Player::add(std::vector<shared::CardId> &&cards)
 {
     add<TO>(std::make_move_iterator(cards.begin()), std::make_move_iterator(cards.end()));
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(const shared::CardBase::id_t &card_id)
+inline void server::Player::add(shared::CardId card_id)
 {
     add<TO>(&card_id, &card_id + 1); // cursed lol
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(const std::vector<shared::CardBase::id_t> &cards)
+inline void server::Player::add(const std::vector<shared::CardId> &cards)
 {
     add<TO>(cards.begin(), cards.end());
 }
@@ -115,7 +131,7 @@ inline void server::Player::add(const std::vector<shared::CardBase::id_t> &cards
 #pragma region MOVE
 
 template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-inline void server::Player::move(const shared::CardBase::id_t &card_id)
+inline void server::Player::move(shared::CardId card_id)
 {
     if constexpr ( TO == shared::TRASH ) {
         take<FROM>(card_id);
@@ -125,7 +141,7 @@ inline void server::Player::move(const shared::CardBase::id_t &card_id)
 }
 
 template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-inline void server::Player::move(const std::vector<shared::CardBase::id_t> &cards)
+inline void server::Player::move(const std::vector<shared::CardId> &cards)
 {
     if ( cards.empty() ) {
         LOG(WARN) << "Tried to move an empty set of cards from " << toString(FROM) << " to " << toString(TO);
@@ -148,35 +164,31 @@ inline void server::Player::move(unsigned int n)
 #pragma region TAKE
 
 template <enum shared::CardAccess FROM>
-inline shared::CardBase::id_t server::Player::take(const shared::CardBase::id_t &card_id)
+inline shared::CardId server::Player::take(shared::CardId card_id)
 {
     static_assert(FROM != shared::TRASH && "Can not take cards from the trash pile!");
     static_assert((FROM != shared::DRAW_PILE_TOP && FROM != shared::DRAW_PILE_BOTTOM) &&
                   "Can not take card from the draw pile by ID!");
 
-    auto &pile = getMutable<FROM>();
-    auto it = std::find(pile.begin(), pile.end(), card_id);
-
-    if ( it == pile.end() ) {
+    if ( !getMutable<FROM>().remove(card_id) ) {
         LOG(ERROR) << "Card \'" << card_id << "\' does not exist in the pile " << toString(FROM);
         throw exception::InvalidCardAccess();
     }
 
-    pile.erase(it);
     return card_id;
 }
 
 template <enum shared::CardAccess FROM>
-inline std::vector<shared::CardBase::id_t> server::Player::take(const std::vector<shared::CardBase::id_t> &cards)
+inline std::vector<shared::CardId> server::Player::take(const std::vector<shared::CardId> &cards)
 {
-    std::vector<shared::CardBase::id_t> taken_cards;
+    std::vector<shared::CardId> taken_cards;
     std::for_each(cards.begin(), cards.end(),
                   [&taken_cards, this](const auto &card_id) { taken_cards.push_back(this->take<FROM>(card_id)); });
     return taken_cards;
 }
 
 template <enum shared::CardAccess FROM>
-inline std::vector<shared::CardBase::id_t> server::Player::take(unsigned int n)
+inline std::vector<shared::CardId> server::Player::take(unsigned int n)
 {
     auto &pile = getMutable<FROM>();
 
@@ -198,18 +210,12 @@ inline std::vector<shared::CardBase::id_t> server::Player::take(unsigned int n)
         }
     }
 
-    std::vector<shared::CardBase::id_t> taken_cards;
-    taken_cards.reserve(n);
-
     if constexpr ( FROM == shared::DRAW_PILE_TOP ) {
-        // take from top
-        taken_cards.assign(std::make_move_iterator(pile.begin()), std::make_move_iterator(pile.begin() + n));
-        pile.erase(pile.begin(), pile.begin() + n);
+        return pile.takeTop(n);
+    } else if constexpr ( FROM == shared::DRAW_PILE_BOTTOM ) {
+        return pile.takeBottom(n);
     } else {
         // take from back
-        taken_cards.assign(std::make_move_iterator(pile.end() - n), std::make_move_iterator(pile.end()));
-        pile.erase(pile.end() - n, pile.end());
+        return pile.extract(pile.end() - n, pile.end());
     }
-
-    return taken_cards;
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include <shared/utils/random.h>
+
+namespace server
+{
+    /**
+     * @brief Zobrist keys for the hash of a game (see GameState::hash()).
+     *
+     * The cards of a pile are hashed as the XOR of key(card, count) over its cards, so moving a card only changes the
+     * keys of that card in the two piles: going from n to n + 1 copies is an XOR with step(card, n). The piles keep
+     * their hash up to date this way (see CardCounts) and the game hash puts them together with place(), which turns
+     * the keys of a pile into the keys of that pile in the game. Phase, current player and the stats of the players
+     * get their own keys.
+     */
+    namespace zobrist
+    {
+        /**
+         * @brief Where a pile is in the game, every place has its own keys.
+         */
+        enum Place : unsigned
+        {
+            // the piles of a player, placed at seat * PLAYER_PILES + pile
+            DRAW_PILE,
+            HAND,
+            DISCARD_PILE,
+            STAGED_CARDS,
+            PLAYER_PILES,
+
+            SUPPLY = PLAYER_PILES * 4,
+            TRASH,
+            PLAYED_CARDS,
+        };
+
+        /**
+         * @brief key(index, count) ^ key(index, count + 1)
+         */
+        constexpr uint64_t step(size_t index, size_t count)
+        {
+            return shared::splitmix64((static_cast<uint64_t>(index) << 32) | count);
+        }
+
+        /**
+         * @brief The key of `count` copies of the card with this index in a pile. No copies have the key 0.
+         */
+        constexpr uint64_t key(size_t index, size_t count)
+        {
+            uint64_t result = 0;
+            for ( size_t n = 0; n < count; ++n ) {
+                result ^= step(index, n);
+            }
+            return result;
+        }
+
+        /**
+         * @brief The hash of a pile at its place in the game.
+         */
+        constexpr uint64_t place(uint64_t pile_hash, unsigned place) { return std::rotl(pile_hash, 3 * place); }
+        static_assert(3 * PLAYED_CARDS < 64, "every place needs its own rotation");
+
+        // the salts of value(), the stats of the player at a seat use seat * PLAYER_PILES + 0, 1 and 2
+        inline constexpr uint64_t PHASE_SALT = 0x100;
+        inline constexpr uint64_t CURRENT_PLAYER_SALT = 0x101;
+
+        /**
+         * @brief Key of a single value, e.g. the phase, `salt` tells the values apart.
+         */
+        constexpr uint64_t value(uint64_t salt, uint64_t value)
+        {
+            return shared::splitmix64(shared::splitmix64(~salt) ^ value);
+        }
+    } // namespace zobrist
+} // namespace server
@@ -167,18 +167,19 @@ namespace server
                 return;
             }
 
-            std::for_each(players.begin(), players.end(),
-                          [&](const auto &player_id)
-                          {
-                              if ( orders.hasOrder(player_id) ) {
-                                  message_interface.send<shared::ActionOrderMessage>(
-                                          player_id, lobby_id, std::move(orders.getOrder(player_id)),
-                                          game_interface->getGameState(player_id));
-                              } else {
-                                  message_interface.send<shared::GameStateMessage>(
-                                          player_id, lobby_id, std::move(game_interface->getGameState(player_id)));
-                              }
-                          });
+            // the orders are given by seat
+            const auto &player_ids = game_interface->getPlayerIDs();
+            for ( Player::seat_t seat = 0; seat < player_ids.size(); ++seat ) {
+                const auto &player_id = player_ids[seat];
+                if ( orders.hasOrder(seat) ) {
+                    message_interface.send<shared::ActionOrderMessage>(player_id, lobby_id,
+                                                                       std::move(orders.getOrder(seat)),
+                                                                       game_interface->getGameState(seat));
+                } else {
+                    message_interface.send<shared::GameStateMessage>(player_id, lobby_id,
+                                                                     std::move(game_interface->getGameState(seat)));
+                }
+            }
         }
     };
 } // namespace server
@@ -1,13 +1,16 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <memory>
+#include <type_traits>
 
 #include <shared/action_order.h>
+#include <shared/game/game_state/board_base.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/player_result.h>
 
 /**
- * @brief This is just a wrapper for a map<player_id, action_order>
+ * @brief This is just a wrapper for the orders of the players, by seat (see server::GameState)
  *
  * Its the return type for all functions in game_interface and in all behaviours.
  * The lobby can use this to update send out orders to players.
@@ -25,12 +28,12 @@ class OrderResponse
     std::vector<shared::PlayerResult> _player_results;
 
     /**
-     * @brief Stores the orders for each player.
+     * @brief Stores the orders for each player, indexed by seat. Players without an order have a nullptr.
      *
-     * If `game_over` is true, this map will be empty.
-     * If `game_over` is false, this map will be filled with the orders for each player.
+     * If `game_over` is true, this array will be empty.
+     * If `game_over` is false, this array will be filled with the orders for each player.
      */
-    std::unordered_map<shared::PlayerBase::id_t, std::unique_ptr<shared::ActionOrder>> response_map;
+    std::array<std::unique_ptr<shared::ActionOrder>, shared::board_config::MAX_PLAYER_COUNT> orders;
 
 public:
     /**
@@ -47,11 +50,6 @@ public:
     OrderResponse &operator=(OrderResponse &&) noexcept = default;
     ~OrderResponse() = default;
 
-    auto begin() const { return response_map.begin(); }
-    auto begin() { return response_map.begin(); }
-    auto end() const { return response_map.end(); }
-    auto end() { return response_map.end(); }
-
     /**
      * @brief Check if the game is over.
      *
@@ -72,56 +70,57 @@ public:
      */
     void setGameOver(std::vector<shared::PlayerResult> results);
 
-    bool empty() const { return response_map.empty(); }
-    bool hasOrder(const shared::PlayerBase::id_t &player_id) const { return response_map.count(player_id) != 0; }
-    auto getOrder(const shared::PlayerBase::id_t &player_id) { return std::move(response_map.at(player_id)); }
+    bool empty() const;
+    bool hasOrder(shared::PlayerBase::seat_t seat) const { return seat < orders.size() && orders[seat] != nullptr; }
+    auto getOrder(shared::PlayerBase::seat_t seat) { return std::move(orders.at(seat)); }
 
     template <typename DerivedOrder>
-    void addOrder(const shared::PlayerBase::id_t &player_id, std::unique_ptr<DerivedOrder> order);
+    void addOrder(shared::PlayerBase::seat_t seat, std::unique_ptr<DerivedOrder> order);
 
 private:
-    void addOrder(const shared::PlayerBase::id_t &player_id, std::unique_ptr<shared::ActionOrder> order);
+    void addOrder(shared::PlayerBase::seat_t seat, std::unique_ptr<shared::ActionOrder> order);
 
     /**
      * @brief Unfolds the initializer_list received from the constructor and adds the orders.
      * This fucky stuff only exists because i wanted to be able to do:
      *
-     * return OrderResponse("id1", order1, "id2", order2);
+     * return OrderResponse(seat1, order1, seat2, order2);
      *
      * instead of
      *
      * OrderResponse response;
-     * response.add("id1", order1);
-     * response.add("id2", order2);
+     * response.add(seat1, order1);
+     * response.add(seat2, order2);
      */
     template <typename T1, typename T2, typename... Rest>
-    void addOrders(T1 &&player_id, T2 &&order, Rest &&...rest);
+    void addOrders(T1 &&seat, T2 &&order, Rest &&...rest);
 };
 
 
 template <typename... Args>
 inline OrderResponse::OrderResponse(Args &&...args)
 {
-    static_assert(sizeof...(args) % 2 == 0, "Must provide pairs of player ID and ActionOrder.");
+    static_assert(sizeof...(args) % 2 == 0, "Must provide pairs of seat and ActionOrder.");
     addOrders(std::forward<Args>(args)...);
 }
 
 template <typename DerivedOrder>
-inline void OrderResponse::addOrder(const shared::PlayerBase::id_t &player_id, std::unique_ptr<DerivedOrder> order)
+inline void OrderResponse::addOrder(shared::PlayerBase::seat_t seat, std::unique_ptr<DerivedOrder> order)
 {
     static_assert(std::is_base_of_v<shared::ActionOrder, DerivedOrder>,
                   "DerivedOrder must be derived from ActionOrder");
-    addOrder(player_id, std::unique_ptr<shared::ActionOrder>(std::move(order)));
+    addOrder(seat, std::unique_ptr<shared::ActionOrder>(std::move(order)));
 }
 
 template <typename T1, typename T2, typename... Rest>
-inline void OrderResponse::addOrders(T1 &&player_id, T2 &&order, Rest &&...rest)
+inline void OrderResponse::addOrders(T1 &&seat, T2 &&order, Rest &&...rest)
 {
-    static_assert(std::is_same_v<std::decay_t<T1>, shared::PlayerBase::id_t>, "Expected player_id to be a string.");
+    static_assert(std::is_integral_v<std::decay_t<T1>>, "Expected the seat of a player.");
     static_assert(std::is_base_of_v<shared::ActionOrder, typename std::decay_t<T2>::element_type>,
                   "Expected order to be derived from ActionOrder.");
 
-    addOrder(std::forward<T1>(player_id), std::unique_ptr<shared::ActionOrder>(std::forward<T2>(order)));
+    addOrder(static_cast<shared::PlayerBase::seat_t>(seat),
+             std::unique_ptr<shared::ActionOrder>(std::forward<T2>(order)));
 
     if constexpr ( sizeof...(Rest) > 0 ) {
         addOrders(std::forward<Rest>(rest)...);
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include <sockpp/stream_socket.h>
 #include <sockpp/tcp_socket.h>
 
+#include <server/network/framing.h>
+#include <server/network/socket_options.h>
+
 using addr_t = sockpp::tcp_socket::addr_t;
 using player_id_t = std::string;
 
@@ -16,12 +23,72 @@ namespace server
     {
         inline static std::unordered_map<player_id_t, std::string> _player_id_to_address;
         inline static std::unordered_map<player_id_t, std::string> _player_id_to_lobby_id;
-        inline static std::unordered_map<std::string, sockpp::tcp_socket> _address_to_socket;
+        /**
+         * @brief The socket a connection is written to.
+         *
+         * @details Several threads write to a multiplexed connection (every lobby sends from the thread of the player
+         * that triggered it), so a frame is written while holding write_mutex, which also guards the cork state.
+         * Senders keep the connection alive with the shared_ptr until they are done with it.
+         */
+        struct Connection
+        {
+            Connection(sockpp::stream_socket socket, bool corkable) : socket(std::move(socket)), corkable(corkable) {}
+
+            sockpp::stream_socket socket;
+            // TCP connections that get corked during a SendBatch
+            const bool corkable;
+            std::mutex write_mutex;
+            // SendBatches of any thread that corked the connection and did not end yet
+            size_t cork_count = 0;
+        };
+        inline static std::unordered_map<std::string, std::shared_ptr<Connection>> _address_to_connection;
         inline static std::unordered_map<std::string, player_id_t> _address_to_player_id;
 
+        // multiplexed connections: every channel gets its own address, which behaves like a connection of its own
+        struct ChannelEndpoint
+        {
+            std::string connection_address;
+            channel_id_t channel;
+        };
+        inline static std::unordered_map<std::string, ChannelEndpoint> _channel_address_to_endpoint;
+        inline static std::unordered_map<std::string, std::vector<std::string>> _connection_to_channel_addresses;
+
+        inline static SocketOptions _socket_options;
+
+        // connections corked by the SendBatch running on this thread
+        inline static thread_local size_t _batch_depth = 0;
+        inline static thread_local std::vector<std::shared_ptr<Connection>> _corked_connections;
+
         inline static std::shared_mutex _rw_lock;
 
     public:
+        /**
+         * @brief Groups all messages sent by this thread during its lifetime.
+         *
+         * @details With SocketOptions::tcp_cork every TCP connection written to is corked on its first write
+         * and uncorked (flushed) when the outermost batch ends, unless a batch of another thread still has it corked.
+         * Without it, this does nothing.
+         */
+        class SendBatch
+        {
+        public:
+            SendBatch();
+            ~SendBatch();
+            SendBatch(const SendBatch &) = delete;
+            SendBatch &operator=(const SendBatch &) = delete;
+        };
+
+        /**
+         * @brief Sets the options applied to connections added afterwards.
+         */
+        static void setSocketOptions(const SocketOptions &options);
+
+        /**
+         * @brief Removes the player at the given address.
+         * Disconnecting a multiplexed connection disconnects the players of all of its channels.
+         *
+         * @param address
+         */
         static void playerDisconnect(const std::string &address);
 
         /**
@@ -50,18 +117,37 @@ namespace server
                                        const std::string &address);
 
         /**
-         * @brief Maps a network address to a socket.
+         * @brief Maps a network address to a socket and applies the socket options to it.
+         * Works for any stream socket (TCP or Unix-domain), the address is only used as a key.
          *
          * @param address
          * @param socket
+         * @param is_tcp whether TCP specific options apply to the socket
+         */
+        static void addAddressToSocket(const std::string &address, sockpp::stream_socket socket, bool is_tcp = true);
+
+        /**
+         * @brief Opens a channel on a multiplexed connection.
+         * Messages sent to the returned address are tagged with the channel and written to the connection.
+         *
+         * @param address address of the connection, as passed to addAddressToSocket
+         * @param channel
+         * @return the address that identifies the channel
+         */
+        static std::string addChannel(const std::string &address, channel_id_t channel);
+
+        /**
+         * @brief Disconnects the player of a channel and forgets the channel, the connection stays open.
+         *
+         * @param channel_address as returned by addChannel
          */
-        static void addAddressToSocket(const std::string &address, sockpp::tcp_socket socket);
+        static void closeChannel(const std::string &channel_address);
 
     private:
         // DISCLAIMER: we assume the caller holds the neccessary locks here!
 
         static const std::string &getAddress(const player_id_t &player_id);
-        static sockpp::tcp_socket *getSocket(const std::string &address);
+        static std::shared_ptr<Connection> getConnection(const std::string &address);
         static bool isNewPlayer(const player_id_t &player_id);
     };
 } // namespace server
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace server
+{
+    /**
+     * @brief Identifies one player session on a multiplexed connection.
+     */
+    using channel_id_t = uint32_t;
+
+    /**
+     * @brief A single message received over a connection.
+     *
+     * @details On the wire a frame is "<length>:<payload>". Frames of a multiplexed connection
+     * additionally carry the channel they belong to: "<channel>/<length>:<payload>".
+     * Each channel carries exactly one player, replies to that player are sent back with the same channel.
+     * A multiplexed frame with an empty payload closes its channel.
+     */
+    struct Frame
+    {
+        std::optional<channel_id_t> channel;
+        std::string payload;
+    };
+
+    /**
+     * @brief Creates the wire representation of a frame.
+     */
+    std::string encodeFrame(const std::string &payload, std::optional<channel_id_t> channel = std::nullopt);
+
+    /**
+     * @brief Reassembles frames from a byte stream that may split or merge them arbitrarily.
+     */
+    class FrameParser
+    {
+    public:
+        // longest valid header: "<uint32>/<uint64>:"
+        static constexpr size_t MAX_HEADER_LENGTH = 32;
+        // longest accepted payload, a peer could make the buffer grow without limit otherwise
+        static constexpr size_t MAX_FRAME_LENGTH = size_t{1} << 20;
+
+        /**
+         * @brief Appends bytes read from the connection.
+         */
+        void append(const char *data, size_t size);
+
+        /**
+         * @brief Returns the next complete frame, if one is buffered.
+         *
+         * @throws exception::MalformedFrame if the buffered data does not start with a valid header or if the
+         * header announces a payload longer than MAX_FRAME_LENGTH.
+         * The parser can not resynchronize after that, call clear() before reusing it.
+         */
+        std::optional<Frame> next();
+
+        void clear();
+
+    private:
+        std::string _buffer;
+        // everything before this offset was already returned as frames
+        size_t _offset = 0;
+    };
+} // namespace server
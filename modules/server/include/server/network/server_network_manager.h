@@ -8,15 +8,20 @@
 
 
 #include <rapidjson/document.h>
+#include <sockpp/stream_socket.h>
 #include <sockpp/tcp_acceptor.h>
 #include <sockpp/tcp_socket.h>
+#include <sockpp/unix_acceptor.h>
+#include <sockpp/unix_connector.h>
 
 #include <server/lobbies/lobby_manager.h>
 #include <server/network/basic_network.h>
+#include <server/network/framing.h>
 #include <server/network/message_interface.h>
+#include <server/network/socket_options.h>
 #include <shared/message_types.h>
 
-using handler = std::function<void(const std::string &, const sockpp::tcp_socket::addr_t &)>;
+using handler = std::function<void(const std::string &, const std::string &)>;
 
 namespace server
 {
@@ -26,10 +31,19 @@ namespace server
     class ServerNetworkManager
     {
     public:
-        ServerNetworkManager();
+        explicit ServerNetworkManager(const SocketOptions &socket_options = {});
         ~ServerNetworkManager();
 
-        void run(const std::string &host = DEFAULT_SERVER_HOST, uint16_t port = DEFAULT_PORT);
+        /**
+         * @brief Starts accepting clients. Blocks for as long as the TCP listener is running.
+         *
+         * @param host
+         * @param port TCP port to listen on
+         * @param unix_socket_path if not empty, additionally listen on a Unix-domain stream socket at this path.
+         * Intended for clients (e.g. bots) running on the same host, which can skip the TCP loopback stack.
+         */
+        void run(const std::string &host = DEFAULT_SERVER_HOST, uint16_t port = DEFAULT_PORT,
+                 const std::string &unix_socket_path = "");
 
         // function to send via the BasicNetwork class
         static ssize_t sendMessage(std::unique_ptr<shared::ServerToClientMessage> message,
@@ -52,6 +66,8 @@ namespace server
 
         inline static std::shared_mutex _rw_lock;
         inline static sockpp::tcp_acceptor _acc;
+        inline static sockpp::unix_acceptor _unix_acc;
+        inline static SocketOptions _socket_options;
 
         // message interface gets passes to lobby manager etc. for the to send to clients later
         static std::shared_ptr<MessageInterface> _message_interface;
@@ -59,11 +75,20 @@ namespace server
         // connect new clients
         void connect(const uint16_t port);
 
+        // open the Unix-domain acceptor and start accepting on it in a background thread
+        void connectUnix(const std::string &path);
+        // removes the socket file at path if no server listens on it anymore, false if it must be kept
+        static bool removeStaleUnixSocket(const std::string &path);
+
         // function that listens to new clients
         static void listenerLoop();
-        static void readLoop(sockpp::tcp_socket socket, const handler &message_handler);
+        static void unixListenerLoop();
+
+        // registers a freshly accepted socket and hands it to a detached readLoop thread
+        static void startReading(sockpp::stream_socket socket, const std::string &address, bool is_tcp);
+        static void readLoop(sockpp::stream_socket socket, const std::string &address, const handler &message_handler);
 
         // might get removed later
-        static void handleMessage(const std::string & /*msg*/, const sockpp::tcp_socket::addr_t & /*peer_address*/);
+        static void handleMessage(const std::string & /*msg*/, const std::string & /*address*/);
     };
 } // namespace server
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <sockpp/acceptor.h>
+#include <sockpp/stream_socket.h>
+
+namespace server
+{
+    /**
+     * @brief Socket level tuning of client connections, all options default to the OS behaviour.
+     *
+     * @details Options that only make sense for TCP are skipped for Unix-domain connections.
+     */
+    struct SocketOptions
+    {
+        // disable Nagle's algorithm, small frames are sent immediately
+        bool tcp_nodelay = false;
+        // SO_SNDBUF / SO_RCVBUF in bytes, 0 keeps the OS default
+        unsigned int send_buffer_size = 0;
+        unsigned int receive_buffer_size = 0;
+        // cork the socket while a request is handled, so all replies leave in as few segments as possible
+        bool tcp_cork = false;
+        // SO_BUSY_POLL in microseconds, 0 disables busy polling
+        unsigned int busy_poll_us = 0;
+        // queue size of pending connections of the listeners
+        int listen_backlog = sockpp::acceptor::DFLT_QUE_SIZE;
+    };
+
+    /**
+     * @brief Applies the options to a freshly accepted connection. Failures are logged, but not fatal.
+     */
+    void applySocketOptions(sockpp::stream_socket &socket, const SocketOptions &options, bool is_tcp);
+
+    /**
+     * @brief Enables or disables TCP_CORK, does nothing on platforms without it.
+     */
+    void setCork(sockpp::stream_socket &socket, bool corked);
+} // namespace server
@@ -25,8 +25,8 @@ int main(int argc, char *argv[])
     // This is not a problem, since the server is not supposed to crash in the first place
     while ( true ) {
         try {
-            server::ServerNetworkManager server;
-            server.run(server::DEFAULT_SERVER_HOST, args.getPort());
+            server::ServerNetworkManager server(args.getSocketOptions());
+            server.run(server::DEFAULT_SERVER_HOST, args.getPort(), args.getUnixSocket());
         } catch ( const std::exception &e ) {
             LOG(ERROR) << "Unhandled exception: " << e.what();
             LOG(DEBUG) << "Restarting server...";
@@ -11,7 +11,16 @@ namespace server
         std::string logFile = option("log-file", 'f', "Log file") = "";
         std::string logLevel = option("log-level", 'l', "Log level") = "warn";
         uint16_t port = option("port", 'p', "Port") = DEFAULT_PORT;
+        std::string unixSocket = option("unix-socket", 'u', "Also listen on a Unix-domain socket at this path") = "";
         bool debug = (option("debug", 'D', "Enable debug mode") = false);
+        // socket tuning, defaults keep the OS behaviour
+        bool tcpNodelay = (option("tcp-nodelay", '\0', "Disable Nagle's algorithm on client connections") = false);
+        unsigned int sendBuffer = option("send-buffer", '\0', "SO_SNDBUF of client connections in bytes") = 0;
+        unsigned int receiveBuffer = option("receive-buffer", '\0', "SO_RCVBUF of client connections in bytes") = 0;
+        bool tcpCork = (option("tcp-cork", '\0', "Cork connections while a request is handled") = false);
+        unsigned int busyPoll = option("busy-poll", '\0', "SO_BUSY_POLL of client connections in microseconds") = 0;
+        int listenBacklog = option("listen-backlog", '\0', "Queue size of pending connections") =
+                sockpp::acceptor::DFLT_QUE_SIZE;
     };
 
     void die(const std::string &message)
@@ -32,6 +41,13 @@ namespace server
                 die("Invalid log level");
             }
             _port = impl.port;
+            _unixSocket = impl.unixSocket;
+            _socketOptions.tcp_nodelay = impl.tcpNodelay;
+            _socketOptions.send_buffer_size = impl.sendBuffer;
+            _socketOptions.receive_buffer_size = impl.receiveBuffer;
+            _socketOptions.tcp_cork = impl.tcpCork;
+            _socketOptions.busy_poll_us = impl.busyPoll;
+            _socketOptions.listen_backlog = impl.listenBacklog;
             _debug = impl.debug;
         } catch ( const QuickArgParserInternals::ArgumentError &e ) {
             die(e.what());
@@ -44,5 +60,9 @@ namespace server
 
     uint16_t ServerArgs::getPort() { return _port; }
 
+    std::string ServerArgs::getUnixSocket() { return _unixSocket; }
+
+    SocketOptions ServerArgs::getSocketOptions() { return _socketOptions; }
+
     bool ServerArgs::isDebug() { return _debug; }
 } // namespace server
@@ -2,12 +2,13 @@
 #include <shared/utils/logger.h>
 
 server::BehaviourChain::BehaviourChain() :
-    current_card(""), behaviour_idx(0), behaviour_registry(std::make_unique<BehaviourRegistry>())
+    behaviour_idx(0), behaviour_registry(std::make_unique<BehaviourRegistry>()),
+    arena(arena_buffer.data(), arena_buffer.size()), behaviour_list(&arena)
 {
     LOG(DEBUG) << "Created a new BehaviourChain";
 }
 
-void server::BehaviourChain::loadBehaviours(const std::string &card_id)
+void server::BehaviourChain::loadBehaviours(shared::CardId card_id)
 {
     if ( !empty() ) {
         LOG(ERROR) << "BehaviourList is already in use for card: \'" << card_id << "\'.Error in " << FUNC_NAME;
@@ -17,7 +18,10 @@ void server::BehaviourChain::loadBehaviours(const std::string &card_id)
     LOG(DEBUG) << "Loading Behaviours for card \'" << card_id << "\'";
     behaviour_idx = 0;
     current_card = card_id;
-    behaviour_list = behaviour_registry->getBehaviours(card_id);
+    static_behaviours = behaviour_registry->getStaticBehaviours(card_id);
+    if ( static_behaviours == nullptr ) {
+        behaviour_list = behaviour_registry->getBehaviours(card_id, &arena);
+    }
 }
 
 void server::BehaviourChain::resetBehaviours()
@@ -30,8 +34,21 @@ void server::BehaviourChain::resetBehaviours()
     LOG(DEBUG) << "Clearing behaviours for card \'" << current_card << "\'";
 
     behaviour_idx = 0;
-    current_card.clear();
+    current_card = shared::CardId::invalid();
     behaviour_list.clear();
+    static_behaviours = nullptr;
+}
+
+void server::BehaviourChain::resetArena()
+{
+    if ( !empty() ) {
+        LOG(ERROR) << "Tried to reset the arena while card \'" << current_card << "\' is played. Error in " << FUNC_NAME;
+        throw exception::UnreachableCode();
+    }
+
+    // the list has to let go of its buffer before the buffer is gone
+    behaviour_list = BehaviourRegistry::behaviour_list_t(&arena);
+    arena.release();
 }
 
 server::BehaviourChain::ret_t server::BehaviourChain::startChain(server::GameState &game_state)
@@ -47,8 +64,15 @@ server::BehaviourChain::ret_t server::BehaviourChain::startChain(server::GameSta
 server::BehaviourChain::ret_t server::BehaviourChain::runBehaviourChain(server::GameState &game_state)
 {
     LOG(INFO) << "Called " << FUNC_NAME << "for card \'" << current_card << "\'";
+    if ( static_behaviours != nullptr ) {
+        // one-shot behaviours never return an order
+        static_behaviours(game_state, game_state.getCurrentSeat());
+        resetBehaviours();
+        return OrderResponse();
+    }
+
     while ( hasNext() ) {
-        auto action_order = currentBehaviour().apply(game_state, game_state.getCurrentPlayerId(), std::nullopt);
+        auto action_order = currentBehaviour().apply(game_state, game_state.getCurrentSeat(), std::nullopt);
 
         if ( currentBehaviour().isDone() ) {
             advance();
@@ -64,7 +88,7 @@ server::BehaviourChain::ret_t server::BehaviourChain::runBehaviourChain(server::
 }
 
 server::BehaviourChain::ret_t
-server::BehaviourChain::continueChain(server::GameState &game_state, const shared::PlayerBase::id_t &player_id,
+server::BehaviourChain::continueChain(server::GameState &game_state, shared::PlayerBase::seat_t player,
                                       std::unique_ptr<shared::ActionDecision> &action_decision)
 {
     LOG(INFO) << "Called " << FUNC_NAME << "for card \'" << current_card << "\'";
@@ -73,7 +97,7 @@ server::BehaviourChain::continueChain(server::GameState &game_state, const share
         throw exception::UnreachableCode();
     }
 
-    auto action_order = currentBehaviour().apply(game_state, player_id, std::move(action_decision));
+    auto action_order = currentBehaviour().apply(game_state, player, std::move(action_decision));
 
     if ( !currentBehaviour().isDone() ) {
         // can be an empty OrderResponse as well
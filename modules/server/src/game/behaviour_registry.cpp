@@ -1,29 +1,26 @@
 
 #include <server/debug_mode.h>
 #include <server/game/behaviour_registry.h>
-#include <server/game/victory_card_behaviours.h>
 #include <shared/game/cards/card_factory.h>
 
-std::vector<std::unique_ptr<server::base::Behaviour>>
-server::BehaviourRegistry::getBehaviours(const std::string &card_id)
+server::BehaviourRegistry::behaviour_list_t server::BehaviourRegistry::getBehaviours(shared::CardId card_id,
+                                                                                     std::pmr::memory_resource *resource)
 {
-    auto it = _map.find(card_id);
-    if ( it == _map.end() ) {
+    if ( card_id.index() >= _map.size() || !_map[card_id.index()] ) {
         LOG(ERROR) << "Requested card \'" << card_id << "\' not registered in the BehaviourRegistry!";
-        throw exception::CardNotAvailable("card not found: " + card_id);
+        throw exception::CardNotAvailable("card not found: " + card_id.name());
     }
-    return it->second();
+    return _map[card_id.index()](resource);
 }
 
-server::VictoryCardBehaviour &
-server::BehaviourRegistry::getVictoryBehaviour(const shared::CardBase::id_t &card_id) const
+server::BehaviourRegistry::static_behaviours_t
+server::BehaviourRegistry::getStaticBehaviours(shared::CardId card_id) const
 {
-    auto it = _victory_map.find(card_id);
-    if ( it == _victory_map.end() ) {
-        LOG(WARN) << "Requested victory card \'" << card_id << "\' not registered in the BehaviourRegistry!";
-        throw exception::CardNotAvailable("Requested card not found in the victory card registry: " + card_id);
+    if ( card_id.index() >= _map.size() || !_map[card_id.index()] ) {
+        LOG(ERROR) << "Requested card \'" << card_id << "\' not registered in the BehaviourRegistry!";
+        throw exception::CardNotAvailable("card not found: " + card_id.name());
     }
-    return *it->second;
+    return _static_map[card_id.index()];
 }
 
 server::BehaviourRegistry::BehaviourRegistry()
@@ -35,6 +32,8 @@ server::BehaviourRegistry::BehaviourRegistry()
 
     LOG(INFO) << "Initialising BehaviourRegistry";
 
+    _map.resize(shared::CardFactory::getCardCount());
+    _static_map.resize(shared::CardFactory::getCardCount());
     initialiseBehaviours();
 
     _is_initialised = true;
@@ -66,11 +65,11 @@ void server::BehaviourRegistry::initialiseBehaviours()
     insert<GainCoins<2>>("Silver");
     insert<GainCoins<3>>("Gold");
 
-    // victory cards
-    insertVictory<ConstantVictoryPoints<1>>("Estate");
-    insertVictory<ConstantVictoryPoints<3>>("Duchy");
-    insertVictory<ConstantVictoryPoints<6>>("Province");
-    insertVictory<ConstantVictoryPoints<-1>>("Curse");
+    // victory cards (their victory points are in the shared::CARD_TABLE)
+    insert<>("Estate");
+    insert<>("Duchy");
+    insert<>("Province");
+    insert<>("Curse");
 
     // kingdom cards
     insert<DrawCards<3>>("Smithy");
@@ -81,7 +80,7 @@ void server::BehaviourRegistry::initialiseBehaviours()
 
     insert<DrawCards<1>, GainActions<2>, GainBuys<1>>("Workers_Village");
     insert<SeaHag>("Sea_Hag");
-    insertVictory<ConstantVictoryPoints<1>, DrawCards<1>, GainActions<1>>("Great_Hall");
+    insert<DrawCards<1>, GainActions<1>>("Great_Hall");
     insert<TreasureMap>("Treasure_Map");
     insert<Remodel>("Remodel");
 
@@ -109,16 +108,9 @@ void server::BehaviourRegistry::initialiseBehaviours()
     // discard a card per empty supply pile
     insert<DrawCards<1>, GainActions<1>, GainCoins<1>, Poacher>("Poacher");
 
-    auto gardens_filter = [](const shared::CardBase::id_t & /*card*/) -> bool { return true; };
-    insertVictory<VictoryPointsPerNCards<1, 10, gardens_filter>>("Gardens");
-
-    auto duke_filter = [](const shared::CardBase::id_t &card) -> bool { return card == "Duchy"; };
-    insertVictory<VictoryPointsPerNCards<1, 1, duke_filter>>("Duke");
-
-    auto silk_road_filter = [](const shared::CardBase::id_t &card) -> bool
-    { return shared::CardFactory::isVictory(card); };
-    insertVictory<VictoryPointsPerNCards<1, 4, silk_road_filter>>("Silk_Road");
-
+    insert<>("Gardens");
+    insert<>("Duke");
+    insert<>("Silk_Road");
 
     /*
     UNSURE
@@ -13,54 +13,64 @@ namespace server
 
     GameInterface::response_t GameInterface::handleMessage(std::unique_ptr<shared::ClientToServerMessage> &message)
     {
-        auto casted_msg = std::unique_ptr<shared::ActionDecisionMessage>(
-                static_cast<shared::ActionDecisionMessage *>(message.release()));
+        auto result = handleMessage(message, std::nothrow);
+        if ( const auto *rejected = std::get_if<MoveResult>(&result) ) {
+            LOG(DEBUG) << "Rejected a move in " << FUNC_NAME << ": " << rejected->message();
+            rejected->raise();
+        }
+        return std::move(std::get<response_t>(result));
+    }
 
-        if ( casted_msg == nullptr ) {
+    GameInterface::result_t GameInterface::handleMessage(std::unique_ptr<shared::ClientToServerMessage> &message,
+                                                         std::nothrow_t)
+    {
+        if ( message == nullptr || message->getKind() != shared::MessageKind::ACTION_DECISION ) {
             LOG(ERROR) << "Received a non shared::ActionDecisionMessage in " << FUNC_NAME;
             throw exception::UnreachableCode();
         }
 
-        if ( dynamic_cast<shared::PlayActionCardDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return playActionCardDecisionHandler(
-                    std::unique_ptr<shared::PlayActionCardDecision>(
-                            static_cast<shared::PlayActionCardDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::BuyCardDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return buyCardDecisionHandler(
-                    std::unique_ptr<shared::BuyCardDecision>(
-                            static_cast<shared::BuyCardDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::EndTurnDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return endTurnDecisionHandler(
-                    std::unique_ptr<shared::EndTurnDecision>(
-                            static_cast<shared::EndTurnDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::EndActionPhaseDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return endActionPhaseDecisionHandler(
-                    std::unique_ptr<shared::EndActionPhaseDecision>(
-                            static_cast<shared::EndActionPhaseDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else {
-            return passToBehaviour(casted_msg);
+        auto casted_msg = std::unique_ptr<shared::ActionDecisionMessage>(
+                static_cast<shared::ActionDecisionMessage *>(message.release()));
+        // the only place where the id of a player is looked up, everything behind works with the seat
+        const auto requestor = game_state->getSeat(casted_msg->player_id);
+
+        switch ( casted_msg->decision->getKind() ) {
+            case shared::DecisionKind::PLAY_ACTION_CARD:
+                return playActionCardDecisionHandler(
+                        std::unique_ptr<shared::PlayActionCardDecision>(
+                                static_cast<shared::PlayActionCardDecision *>(casted_msg->decision.release())),
+                        requestor);
+            case shared::DecisionKind::BUY_CARD:
+                return buyCardDecisionHandler(
+                        std::unique_ptr<shared::BuyCardDecision>(
+                                static_cast<shared::BuyCardDecision *>(casted_msg->decision.release())),
+                        requestor);
+            case shared::DecisionKind::END_TURN:
+                return endTurnDecisionHandler(
+                        std::unique_ptr<shared::EndTurnDecision>(
+                                static_cast<shared::EndTurnDecision *>(casted_msg->decision.release())),
+                        requestor);
+            case shared::DecisionKind::END_ACTION_PHASE:
+                return endActionPhaseDecisionHandler(
+                        std::unique_ptr<shared::EndActionPhaseDecision>(
+                                static_cast<shared::EndActionPhaseDecision *>(casted_msg->decision.release())),
+                        requestor);
+            default:
+                return passToBehaviour(casted_msg, requestor);
         }
     }
 
-    GameInterface::response_t
+    GameInterface::result_t
     GameInterface::playActionCardDecisionHandler(std::unique_ptr<shared::PlayActionCardDecision> action_decision,
-                                                 const Player::id_t &requestor_id)
+                                                 Player::seat_t requestor)
     {
-        try {
-            game_state->tryPlay<shared::CardAccess::HAND>(requestor_id, action_decision->card_id);
-            // phase is only set if we successfully played a card
-            game_state->setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
-        } catch ( exception::UnreachableCode &e ) {
-            LOG(ERROR) << "Received unresolvable Error in " << FUNC_NAME << " aborting.";
-            throw e;
-        } catch ( std::exception &e ) {
-            LOG(DEBUG) << "Failed to play card for player \'" << requestor_id << "\'. Error: " << e.what();
-            throw e;
+        if ( auto result = game_state->tryPlay<shared::CardAccess::HAND>(requestor, action_decision->card_id,
+                                                                          std::nothrow);
+             !result ) {
+            return result;
         }
+        // phase is only set if we successfully played a card
+        game_state->setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
 
         behaviour_chain->loadBehaviours(action_decision->card_id);
         auto response = behaviour_chain->startChain(*game_state);
@@ -72,36 +82,25 @@ namespace server
         return response;
     }
 
-    GameInterface::response_t
+    GameInterface::result_t
     GameInterface::buyCardDecisionHandler(std::unique_ptr<shared::BuyCardDecision> action_decision,
-                                          const Player::id_t &requestor_id)
+                                          Player::seat_t requestor)
     {
-        try {
-            game_state->tryBuy(requestor_id, action_decision->card);
-        } catch ( exception::UnreachableCode &e ) {
-            LOG(ERROR) << "Received unresolvable Error in " << FUNC_NAME << " aborting.";
-            throw e;
-        } catch ( std::exception &e ) {
-            LOG(DEBUG) << "Failed to buy card for player \'" << requestor_id << "\'. Error: " << e.what();
-            throw e;
+        if ( auto result = game_state->tryBuy(requestor, action_decision->card, std::nothrow); !result ) {
+            return result;
         }
 
         return nextPhase();
     }
 
-    GameInterface::response_t
-    GameInterface::endTurnDecisionHandler(std::unique_ptr<shared::EndTurnDecision> action_decision,
-                                          const Player::id_t &requestor_id)
+    GameInterface::result_t
+    GameInterface::endTurnDecisionHandler(std::unique_ptr<shared::EndTurnDecision> /*action_decision*/,
+                                          Player::seat_t requestor)
     {
-        try {
-            game_state->tryEndTurn(requestor_id);
-        } catch ( exception::UnreachableCode &e ) {
-            LOG(ERROR) << "Somehow reached unreachable code in " << FUNC_NAME << ". Aborting.";
-            throw e;
-        } catch ( std::exception &e ) {
-            LOG(WARN) << "Failed to end turn: " << e.what();
-            throw e;
+        if ( auto result = game_state->tryEndTurn(requestor, std::nothrow); !result ) {
+            return result;
         }
+        behaviour_chain->resetArena();
 
         if ( game_state->isGameOver() ) {
             return endGame();
@@ -114,26 +113,24 @@ namespace server
      * @brief This function is used for ActionDecisionMessages that are not handled by other handlers. Those are assumed
      * to be expected by an ongoing behaviour.
      */
-    GameInterface::response_t GameInterface::passToBehaviour(std::unique_ptr<shared::ActionDecisionMessage> &message)
+    GameInterface::result_t GameInterface::passToBehaviour(std::unique_ptr<shared::ActionDecisionMessage> &message,
+                                                           Player::seat_t requestor)
     {
         // we expect to be in this state because the behaviour chain needs to be initialised
         // -> implying we are playing a card
         if ( game_state->getPhase() != shared::GamePhase::PLAYING_ACTION_CARD ) {
-            LOG(WARN) << "Player: \'" << message->player_id << "\' called " << FUNC_NAME << ". Expected to be in \'"
-                      << toString(shared::GamePhase::PLAYING_ACTION_CARD) << "\', but current phase is \'"
-                      << toString(game_state->getPhase());
-            throw exception::OutOfPhase("You can not do this while being in " + toString(game_state->getPhase()));
+            return MoveResult(MoveError::OUT_OF_PHASE, "You can not do this", game_state->getPhase());
         }
 
         auto decision = std::move(message->decision);
 
-        if ( (dynamic_cast<shared::DeckChoiceDecision *>(decision.get()) == nullptr) &&
-             (dynamic_cast<shared::GainFromBoardDecision *>(decision.get()) == nullptr) ) {
+        if ( decision->getKind() != shared::DecisionKind::DECK_CHOICE &&
+             decision->getKind() != shared::DecisionKind::GAIN_FROM_BOARD ) {
             LOG(ERROR) << "Unreachable code: received some unexpected decision type in: " << FUNC_NAME;
             throw exception::UnreachableCode();
         }
 
-        auto response = behaviour_chain->continueChain(*game_state, message->player_id, decision);
+        auto response = behaviour_chain->continueChain(*game_state, requestor, decision);
 
         if ( behaviour_chain->empty() ) {
             return finishedPlayingCard();
@@ -142,18 +139,12 @@ namespace server
         return response;
     }
 
-    GameInterface::response_t
-    GameInterface::endActionPhaseDecisionHandler(std::unique_ptr<shared::EndActionPhaseDecision> decision,
-                                                 const Player::id_t &requestor_id)
+    GameInterface::result_t
+    GameInterface::endActionPhaseDecisionHandler(std::unique_ptr<shared::EndActionPhaseDecision> /*decision*/,
+                                                 Player::seat_t requestor)
     {
-        try {
-            game_state->tryEndActionPhase(requestor_id);
-        } catch ( exception::UnreachableCode &e ) {
-            LOG(ERROR) << "Somehow reached unreachable code in " << FUNC_NAME << ". Aborting.";
-            throw e;
-        } catch ( std::exception &e ) {
-            LOG(WARN) << "Failed to end action phase: " << e.what();
-            throw e;
+        if ( auto result = game_state->tryEndActionPhase(requestor, std::nothrow); !result ) {
+            return result;
         }
 
         return nextPhase();
@@ -170,25 +161,28 @@ namespace server
 
     GameInterface::response_t GameInterface::nextPhase()
     {
-        auto current_player_id = game_state->getCurrentPlayerId();
+        auto current_player = game_state->getCurrentSeat();
         game_state->maybeSwitchPhase();
-        if ( current_player_id != game_state->getCurrentPlayerId() && game_state->isGameOver() ) {
-            // the player has changed in switchPhase and the game is over, hence the game has ended
-            return endGame();
+        if ( current_player != game_state->getCurrentSeat() ) {
+            behaviour_chain->resetArena();
+            if ( game_state->isGameOver() ) {
+                // the player has changed in switchPhase and the game is over, hence the game has ended
+                return endGame();
+            }
         }
 
-        current_player_id = game_state->getCurrentPlayerId();
+        current_player = game_state->getCurrentSeat();
         switch ( game_state->getPhase() ) {
             case shared::GamePhase::ACTION_PHASE:
-                return {current_player_id, std::make_unique<shared::ActionPhaseOrder>()};
+                return {current_player, std::make_unique<shared::ActionPhaseOrder>()};
             case shared::GamePhase::BUY_PHASE:
                 {
-                    for ( const auto &card_id : game_state->tryPlayAllTreasures(current_player_id) ) {
+                    for ( const auto &card_id : game_state->tryPlayAllTreasures(current_player) ) {
                         behaviour_chain->loadBehaviours(card_id);
                         behaviour_chain->startChain(*game_state);
                     }
 
-                    return {current_player_id, std::make_unique<shared::BuyPhaseOrder>()};
+                    return {current_player, std::make_unique<shared::BuyPhaseOrder>()};
                 }
             case shared::GamePhase::PLAYING_ACTION_CARD:
             default:
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <string>
+
+#include <server/game/game_snapshot.h>
+#include <shared/game/game_state/game_phase.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        [[noreturn]] void invalid(const std::string &reason)
+        {
+            LOG(ERROR) << "Invalid game snapshot: " << reason;
+            throw exception::InvalidSnapshot("Invalid game snapshot: " + reason);
+        }
+
+        bool validCards(const shared::CardId::index_t *begin, size_t count)
+        {
+            return std::all_of(begin, begin + count,
+                               [](shared::CardId::index_t index) { return index < shared::CARD_COUNT; });
+        }
+
+        void validate(const PlayerSnapshot &player, size_t seat)
+        {
+            const size_t card_count = static_cast<size_t>(player.draw_pile_size) + player.hand_size +
+                                      player.discard_pile_size + player.staged_size;
+            if ( card_count > PlayerSnapshot::MAX_CARDS ) {
+                invalid("player " + std::to_string(seat) + " has " + std::to_string(card_count) + " cards");
+            }
+            if ( !validCards(player.cards.data(), card_count) ) {
+                invalid("player " + std::to_string(seat) + " has an unknown card");
+            }
+        }
+
+        void validate(const BoardSnapshot &board)
+        {
+            for ( auto it = board.kingdom.begin(); it != board.kingdom.end(); ++it ) {
+                const auto index = *it;
+                if ( index >= shared::CARD_COUNT ||
+                     (shared::CARD_TABLE[index].type & shared::CardType::KINGDOM) != shared::CardType::KINGDOM ) {
+                    invalid("kingdom card " + std::to_string(index) + " is not a kingdom card");
+                }
+                if ( std::find(board.kingdom.begin(), it, index) != it ) {
+                    invalid("kingdom card " + std::to_string(index) + " appears twice");
+                }
+            }
+            if ( board.played_count > BoardSnapshot::MAX_PLAYED_CARDS ) {
+                invalid(std::to_string(board.played_count) + " played cards");
+            }
+            if ( !validCards(board.played.data(), board.played_count) ) {
+                invalid("an unknown card is played");
+            }
+        }
+    } // namespace
+
+    void validate(const GameSnapshot &snapshot)
+    {
+        if ( !shared::board_config::validatePlayerCount(snapshot.player_count) ) {
+            invalid(std::to_string(snapshot.player_count) + " players");
+        }
+        if ( snapshot.current_player >= snapshot.player_count ) {
+            invalid("the current player " + std::to_string(snapshot.current_player) + " has no seat");
+        }
+        if ( snapshot.phase > static_cast<uint8_t>(shared::GamePhase::PLAYING_ACTION_CARD) ) {
+            invalid("unknown phase " + std::to_string(snapshot.phase));
+        }
+        for ( size_t seat = 0; seat < snapshot.player_count; ++seat ) {
+            validate(snapshot.players[seat], seat);
+        }
+        validate(snapshot.board);
+    }
+} // namespace server
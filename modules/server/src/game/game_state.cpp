@@ -13,9 +13,9 @@ using shared::GamePhase;
 namespace server
 {
     GameState::GameState(const std::vector<shared::CardBase::id_t> &play_cards,
-                         const std::vector<Player::id_t> &player_ids) :
+                         const std::vector<Player::id_t> &player_ids, uint64_t seed) :
         current_player_idx(0),
-        phase(GamePhase::ACTION_PHASE)
+        phase(GamePhase::ACTION_PHASE), seed(seed), rng(seed)
     {
         if ( player_ids.size() < 2 || player_ids.size() > 4 ) {
             LOG(ERROR) << "Invalid number of players: expected 2-4, got " << player_ids.size() << " in " << FUNC_NAME
@@ -23,6 +23,7 @@ namespace server
             throw exception::UnreachableCode();
         }
 
+        LOG(INFO) << "Starting a game with seed " << seed;
         initialisePlayers(player_ids);
         initialiseBoard(play_cards);
     }
@@ -30,26 +31,85 @@ namespace server
     GameState::GameState() = default;
     GameState::~GameState() = default;
 
-    GameState::GameState(GameState &&other) :
-        player_order(other.player_order), current_player_idx(other.current_player_idx)
+    GameState::GameState(GameState &&other) noexcept = default;
+
+    GameState::GameState(const GameState &other) :
+        players(other.players), player_order(other.player_order), current_player_idx(other.current_player_idx),
+        phase(other.phase), is_actually_over(other.is_actually_over), seed(other.seed), rng(other.rng)
     {
-        for ( const auto &pair : other.player_map ) {
-            player_map[pair.first] = std::make_unique<Player>(*pair.second);
+        if ( other.board ) {
+            board = other.board->clone();
         }
+    }
 
-        if ( other.board ) {
-            board = other.board;
+    GameState GameState::fork() const { return GameState(*this); }
+
+    GameState::GameState(const GameSnapshot &snapshot, const std::vector<Player::id_t> &player_ids) :
+        player_order(player_ids), current_player_idx(snapshot.current_player),
+        phase(static_cast<GamePhase>(snapshot.phase)), is_actually_over(snapshot.is_over != 0), seed(snapshot.seed),
+        rng(shared::Xoshiro256::fromState(snapshot.rng))
+    {
+        validate(snapshot);
+        if ( player_ids.size() != snapshot.player_count ) {
+            LOG(ERROR) << "Got " << player_ids.size() << " player ids for a snapshot of " << +snapshot.player_count
+                       << " players";
+            throw exception::PlayerCountMismatch();
+        }
+
+        players.reserve(player_ids.size());
+        for ( size_t seat = 0; seat < player_ids.size(); ++seat ) {
+            players.emplace_back(player_ids[seat], snapshot.players[seat]);
+        }
+        board = ServerBoard::make(snapshot.board, player_ids.size());
+    }
+
+    GameSnapshot GameState::snapshot() const
+    {
+        GameSnapshot snapshot{};
+        snapshot.rng = rng.getState();
+        snapshot.seed = seed;
+        for ( size_t seat = 0; seat < players.size(); ++seat ) {
+            snapshot.players[seat] = players[seat].snapshot();
+        }
+        snapshot.board = board->snapshot();
+        snapshot.player_count = static_cast<uint8_t>(players.size());
+        snapshot.current_player = static_cast<uint8_t>(current_player_idx);
+        snapshot.phase = static_cast<uint8_t>(phase);
+        snapshot.is_over = static_cast<uint8_t>(is_actually_over);
+        return snapshot;
+    }
+
+    uint64_t GameState::hash() const
+    {
+        uint64_t result = board->hash() ^ zobrist::value(zobrist::PHASE_SALT, static_cast<uint64_t>(phase)) ^
+                          zobrist::value(zobrist::CURRENT_PLAYER_SALT, current_player_idx);
+        for ( size_t seat = 0; seat < players.size(); ++seat ) {
+            result ^= players[seat].hash(seat);
+        }
+#ifndef NDEBUG
+        // the arguments of _ASSERT_EQ are evaluated in release builds as well
+        _ASSERT_EQ(result, computeHash(), "The hash of the game is out of date");
+#endif
+        return result;
+    }
+
+    uint64_t GameState::computeHash() const
+    {
+        uint64_t result = board->computeHash() ^ zobrist::value(zobrist::PHASE_SALT, static_cast<uint64_t>(phase)) ^
+                          zobrist::value(zobrist::CURRENT_PLAYER_SALT, current_player_idx);
+        for ( size_t seat = 0; seat < players.size(); ++seat ) {
+            result ^= players[seat].computeHash(seat);
         }
+        return result;
     }
 
     std::vector<shared::PlayerResult> GameState::getResults() const
     {
         std::vector<shared::PlayerResult> results;
         // Get results of each player
-        for ( const auto &pair : player_map ) {
-            const auto &player = pair.second;
-            int victory_points = player->getVictoryPoints();
-            shared::PlayerResult result(player->getId(), victory_points);
+        for ( const auto &player : players ) {
+            int victory_points = player.getVictoryPoints();
+            shared::PlayerResult result(player.getId(), victory_points);
             results.emplace_back(result);
         }
         // and sort them by score
@@ -61,23 +121,25 @@ namespace server
     void GameState::initialisePlayers(const std::vector<Player::id_t> &player_ids)
     {
         player_order = player_ids;
+        players.reserve(player_ids.size());
         for ( const auto &id : player_ids ) {
-            if ( player_map.count(id) != 0u ) {
+            if ( std::count(player_ids.begin(), player_ids.end(), id) != 1 ) {
                 LOG(ERROR) << "Duplicate player ID: " << id << " in " << FUNC_NAME
                            << ". This should have been checked implicitly by the lobby!";
                 throw exception::UnreachableCode();
             }
 
-            player_map[id] = std::make_unique<Player>(id);
+            // every player shuffles with its own generator, derived from the seed of the game
+            auto &player = players.emplace_back(id, rng());
 
             for ( unsigned i = 0; i < 7; i++ ) {
                 if ( i < 3 ) {
-                    player_map[id]->gain("Estate");
+                    player.gain(shared::CardId::of("Estate"));
                 }
-                player_map[id]->gain("Copper");
+                player.gain(shared::CardId::of("Copper"));
             }
 
-            player_map[id]->draw(5);
+            player.draw(5);
         }
     }
 
@@ -87,19 +149,29 @@ namespace server
             LOG(ERROR) << "Invalid number of kingdom cards: expected 10, got " << selected_cards.size();
             throw exception::WrongCardCount("Incorrect number of kingdom cards!");
         }
-        board = server::ServerBoard::make(selected_cards, player_map.size());
+        board = server::ServerBoard::make(selected_cards, players.size());
     }
 
-    std::unique_ptr<reduced::GameState> GameState::getReducedState(const Player::id_t &target_player)
+    Player::seat_t GameState::getSeat(const Player::id_t &id) const
+    {
+        // at most four players, a linear search is as fast as it gets
+        const auto it = std::find(player_order.begin(), player_order.end(), id);
+        if ( it == player_order.end() ) {
+            LOG(WARN) << "There is no player with id \'" << id << "\' in this game";
+            throw std::out_of_range("Unknown player id: " + id);
+        }
+        return static_cast<Player::seat_t>(std::distance(player_order.begin(), it));
+    }
+
+    std::unique_ptr<reduced::GameState> GameState::getReducedState(Player::seat_t target_player)
     {
         std::vector<reduced::Enemy::ptr_t> reduced_enemies;
-        std::for_each(player_map.begin(), player_map.end(),
-                      [&](auto &entry)
-                      {
-                          if ( auto &[player_id, player_ptr] = entry; player_id != target_player ) {
-                              reduced_enemies.emplace_back(player_ptr->getReducedEnemy());
-                          }
-                      });
+        reduced_enemies.reserve(players.size() - 1);
+        for ( size_t seat = 0; seat < players.size(); ++seat ) {
+            if ( seat != target_player ) {
+                reduced_enemies.emplace_back(players[seat].getReducedEnemy());
+            }
+        }
 
         auto reduced_player = getPlayer(target_player).getReducedPlayer();
         Player::id_t active_player_id = getCurrentPlayerId();
@@ -112,7 +184,7 @@ namespace server
     void GameState::endTurn()
     {
         auto &current_player = getCurrentPlayer();
-        const std::vector<shared::CardBase::id_t> &played_cards = board->getPlayedCards();
+        const std::vector<shared::CardId> &played_cards = board->getPlayedCards();
         for ( const auto &card_id : played_cards ) {
             current_player.add<shared::CardAccess::DISCARD_PILE>(card_id);
         }
@@ -128,23 +200,6 @@ namespace server
         maybeSwitchPhase(); // a player might not have any action cards at the beginning of the action phase
     }
 
-    std::vector<Player::id_t> GameState::getEnemyIDs(const Player::id_t &player_id) const
-    {
-        const size_t num_players = player_order.size();
-        const size_t num_enemies = num_players - 1;
-
-        const size_t attacker_index =
-                std::distance(player_order.begin(), std::find(player_order.begin(), player_order.end(), player_id));
-
-        std::vector<Player::id_t> enemies(num_enemies);
-        for ( size_t i = 1; i < num_players; ++i ) {
-            const size_t enemy_index = (i + attacker_index) % num_players;
-            enemies[i - 1] = player_order[enemy_index];
-        }
-
-        return enemies;
-    }
-
     void GameState::forceSwitchPhase()
     {
         switch ( phase ) {
@@ -202,113 +257,114 @@ namespace server
 
 #pragma region ASSERTION_HELPERS
 
-    void GameState::guaranteePhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                                   shared::GamePhase expected_phase, const std::string &error_msg,
-                                   const std::string &function_name)
+    void GameState::rejectMove(const MoveResult &result, Player::seat_t requestor, const std::string &function_name)
     {
-        if ( this->phase != expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card_id
-                      << "\'. Expected to be in \'" << toString(expected_phase) << "\', but current phase is \'"
-                      << toString(this->phase);
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
-        }
+        LOG(WARN) << "Player: \'" << getPlayer(requestor).getId() << "\' called " << function_name << ", but "
+                  << result.message();
+        result.raise();
     }
 
-    void GameState::guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                                   const std::string &error_msg, const std::string &function_name)
+    void GameState::printSuccess(Player::seat_t requestor, const std::string &function_name)
     {
-        if ( this->phase != expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << ". Expected to be in \'"
-                      << toString(expected_phase) << "\', but current phase is \'" << toString(this->phase);
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
-        }
+        LOG(DEBUG) << "Player: \'" << getPlayer(requestor).getId() << "\' successfully finished \'" << function_name;
     }
 
-    void GameState::guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id,
-                                      const shared::CardBase::id_t &card_id, shared::GamePhase expected_phase,
-                                      const std::string &error_msg, const std::string &function_name)
-    {
-        if ( this->phase == expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card_id
-                      << "\'. Expected to not be in \'" << toString(expected_phase) << "\'";
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
-        }
-    }
+#pragma region TRY_FUNCTIONS
 
-    void GameState::guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                                      const std::string &error_msg, const std::string &function_name)
+    std::vector<shared::CardId> GameState::tryPlayAllTreasures(Player::seat_t requestor)
     {
-        if ( this->phase == expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << ". Expected to not be in \'"
-                      << toString(expected_phase) << "\'";
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
+        MoveResult result = checkIsCurrentPlayer(requestor);
+        if ( result ) {
+            result = checkPhase(shared::GamePhase::BUY_PHASE, "You can not play all treasures");
         }
-    }
-
-    void GameState::guaranteeIsCurrentPlayer(const shared::PlayerBase::id_t &requestor_id,
-                                             const std::string &function_name)
-    {
-        if ( requestor_id != getCurrentPlayerId() ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' attempted to call " << function_name << " out of turn.";
-            throw exception::NotYourTurn();
+        if ( !result ) {
+            rejectMove(result, requestor, FUNC_NAME);
         }
-    }
-
-    void GameState::printSuccess(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name)
-    {
-        LOG(DEBUG) << "Player: \'" << requestor_id << "\' successfully finished \'" << function_name;
-    }
-
-#pragma region TRY_FUNCTIONS
-
-    std::vector<shared::CardBase::id_t> GameState::tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id)
-    {
-        guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
-        guaranteePhase(requestor_id, shared::GamePhase::BUY_PHASE, "You can not play all treasures", FUNC_NAME);
 
-        auto &player = getPlayer(requestor_id);
+        auto &player = getPlayer(requestor);
 
         auto treasure_cards = player.getType<shared::CardAccess::HAND>(shared::CardType::TREASURE);
         player.take<shared::HAND>(treasure_cards);
         board->addToPlayedCards(treasure_cards);
 
-        printSuccess(requestor_id, FUNC_NAME);
+        printSuccess(requestor, FUNC_NAME);
         return treasure_cards;
     }
 
-    void GameState::tryEndActionPhase(const shared::PlayerBase::id_t &requestor_id)
+    void GameState::tryEndActionPhase(Player::seat_t requestor)
     {
-        guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
+        if ( auto result = tryEndActionPhase(requestor, std::nothrow); !result ) {
+            rejectMove(result, requestor, FUNC_NAME);
+        }
+        printSuccess(requestor, FUNC_NAME);
+    }
 
-        guaranteePhase(requestor_id, shared::GamePhase::ACTION_PHASE,
-                       "You can not end " + toString(shared::GamePhase::ACTION_PHASE), FUNC_NAME);
+    MoveResult GameState::tryEndActionPhase(Player::seat_t requestor, std::nothrow_t)
+    {
+        if ( auto result = checkIsCurrentPlayer(requestor); !result ) {
+            return result;
+        }
+        if ( auto result = checkPhase(shared::GamePhase::ACTION_PHASE, "You can not end action_phase"); !result ) {
+            return result;
+        }
 
         forceSwitchPhase();
-        printSuccess(requestor_id, FUNC_NAME);
+        return {};
     }
 
-    void GameState::tryBuy(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id)
+    void GameState::tryEndTurn(Player::seat_t requestor)
     {
-        guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::BUY_PHASE, "You can not buy a card", FUNC_NAME);
+        if ( auto result = tryEndTurn(requestor, std::nothrow); !result ) {
+            rejectMove(result, requestor, FUNC_NAME);
+        }
+    }
 
-        const auto card_cost = shared::CardFactory::getCard(card_id).getCost();
+    MoveResult GameState::tryEndTurn(Player::seat_t requestor, std::nothrow_t)
+    {
+        if ( auto result = checkIsCurrentPlayer(requestor); !result ) {
+            return result;
+        }
+        if ( auto result = checkNotPhase(shared::GamePhase::PLAYING_ACTION_CARD, "Can not end turn"); !result ) {
+            return result;
+        }
+
+        endTurn();
+        return {};
+    }
 
-        if ( !getPlayer(requestor_id).canBuy(card_cost) ) {
-            LOG(WARN) << "Player \'" << requestor_id << "\' cannot afford card \'" << card_id
-                      << "\' (cost: " << card_cost << ", treasure: " << getPlayer(requestor_id).getTreasure()
-                      << ", buys: " << getPlayer(requestor_id).getBuys() << ").";
-            throw exception::InsufficientFunds();
+    void GameState::tryBuy(Player::seat_t requestor, shared::CardId card_id)
+    {
+        if ( auto result = tryBuy(requestor, card_id, std::nothrow); !result ) {
+            rejectMove(result, requestor, FUNC_NAME);
         }
+        printSuccess(requestor, FUNC_NAME);
+    }
 
-        board->tryTake(card_id);
+    MoveResult GameState::tryBuy(Player::seat_t requestor, shared::CardId card_id, std::nothrow_t)
+    {
+        if ( auto result = checkIsCurrentPlayer(requestor); !result ) {
+            return result;
+        }
+        if ( auto result = checkPhase(shared::GamePhase::BUY_PHASE, "You can not buy a card"); !result ) {
+            return result;
+        }
 
+        if ( !card_id.valid() ) {
+            return MoveError::CARD_NOT_AVAILABLE;
+        }
+        const auto card_cost = shared::CardFactory::getCost(card_id);
         auto &player = getCurrentPlayer();
+        if ( !player.canBuy(card_cost) ) {
+            return MoveError::INSUFFICIENT_FUNDS;
+        }
+        if ( !board->tryTake(card_id, std::nothrow) ) {
+            return MoveError::CARD_NOT_AVAILABLE;
+        }
+
         player.decTreasure(card_cost);
         player.decBuys();
         player.gain(card_id);
-
-        printSuccess(requestor_id, FUNC_NAME);
+        return {};
     }
 
 } // namespace server
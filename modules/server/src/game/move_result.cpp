@@ -0,0 +1,48 @@
+#include <server/game/move_result.h>
+
+#include <shared/utils/exception.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    std::string MoveResult::message() const
+    {
+        switch ( error_code ) {
+            case MoveError::NONE:
+                return "";
+            case MoveError::NOT_YOUR_TURN:
+                return exception::NotYourTurn().what();
+            case MoveError::OUT_OF_PHASE:
+                return context + std::string(" while in ") + toString(phase);
+            case MoveError::OUT_OF_ACTIONS:
+                return exception::OutOfActions().what();
+            case MoveError::INSUFFICIENT_FUNDS:
+                return exception::InsufficientFunds().what();
+            case MoveError::CARD_NOT_AVAILABLE:
+                return exception::CardNotAvailable().what();
+            default:
+                LOG(ERROR) << "Unknown MoveError: " << static_cast<int>(error_code);
+                throw exception::UnreachableCode();
+        }
+    }
+
+    void MoveResult::raise() const
+    {
+        switch ( error_code ) {
+            case MoveError::NOT_YOUR_TURN:
+                throw exception::NotYourTurn();
+            case MoveError::OUT_OF_PHASE:
+                throw exception::OutOfPhase(message());
+            case MoveError::OUT_OF_ACTIONS:
+                throw exception::OutOfActions();
+            case MoveError::INSUFFICIENT_FUNDS:
+                throw exception::InsufficientFunds();
+            case MoveError::CARD_NOT_AVAILABLE:
+                throw exception::CardNotAvailable();
+            case MoveError::NONE:
+            default:
+                LOG(ERROR) << "Tried to raise a MoveError that is not an error: " << static_cast<int>(error_code);
+                throw exception::UnreachableCode();
+        }
+    }
+} // namespace server
@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <stdexcept>
+
 #include <server/game/server_board.h>
+#include <shared/game/cards/card_factory.h>
 #include <shared/utils/assert.h>
 
 namespace server
@@ -10,33 +14,119 @@ namespace server
     }
 
     ServerBoard::ServerBoard(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count) :
-        shared::Board(kingdom_cards, player_count)
+        shared::Board(kingdom_cards, player_count), empty_piles(shared::Board::getEmptyPilesCount()),
+        initial_provinces(getProvincePile().count), supply_hash(computeSupplyHash())
     {}
 
+    ServerBoard::ptr_t ServerBoard::make(const BoardSnapshot &snapshot, size_t player_count)
+    {
+        std::vector<shared::CardBase::id_t> kingdom_cards;
+        kingdom_cards.reserve(snapshot.kingdom.size());
+        for ( const auto index : snapshot.kingdom ) {
+            kingdom_cards.push_back(shared::CardId::fromIndex(index).name());
+        }
+        auto board = make(kingdom_cards, player_count);
+
+        for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+            if ( board->pile_slots[index] != NO_SLOT ) {
+                board->piles[board->pile_slots[index]].count = snapshot.supply[index];
+            }
+            for ( size_t n = 0; n < snapshot.trash[index]; ++n ) {
+                board->trashCard(shared::CardId::fromIndex(static_cast<shared::CardId::index_t>(index)));
+            }
+        }
+        board->empty_piles = board->shared::Board::getEmptyPilesCount();
+        board->supply_hash = board->computeSupplyHash();
+        for ( size_t i = 0; i < snapshot.played_count; ++i ) {
+            board->addToPlayedCards(shared::CardId::fromIndex(snapshot.played[i]));
+        }
+        return board;
+    }
+
+    ServerBoard::ptr_t ServerBoard::clone() const { return ptr_t(new ServerBoard(*this)); }
+
+    BoardSnapshot ServerBoard::snapshot() const
+    {
+        if ( played_card_ids.size() > BoardSnapshot::MAX_PLAYED_CARDS ) {
+            LOG(ERROR) << played_card_ids.size() << " played cards do not fit into a snapshot";
+            throw std::length_error("Too many played cards for a snapshot");
+        }
+
+        BoardSnapshot snapshot{};
+        const auto kingdom = getKingdomCards();
+        for ( size_t i = 0; i < kingdom.size(); ++i ) {
+            snapshot.kingdom[i] = shared::CardId(kingdom[i].card_id).index();
+        }
+        for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+            if ( pile_slots[index] != NO_SLOT ) {
+                snapshot.supply[index] = static_cast<uint8_t>(piles[pile_slots[index]].count);
+            }
+            snapshot.trash[index] = static_cast<uint8_t>(
+                    trash_counts.count(shared::CardId::fromIndex(static_cast<shared::CardId::index_t>(index))));
+        }
+        snapshot.played_count = static_cast<uint8_t>(played_card_ids.size());
+        std::transform(played_card_ids.begin(), played_card_ids.end(), snapshot.played.begin(),
+                       [](shared::CardId card_id) { return card_id.index(); });
+        return snapshot;
+    }
+
+    uint64_t ServerBoard::computeHash() const
+    {
+        CardCounts trash_from_names;
+        for ( const auto &card_name : trash ) {
+            trash_from_names.add(card_name);
+        }
+        CardCounts played_from_ids;
+        for ( const auto card_id : played_card_ids ) {
+            played_from_ids.add(card_id);
+        }
+        return zobrist::place(computeSupplyHash(), zobrist::SUPPLY) ^
+               zobrist::place(trash_from_names.computeHash(), zobrist::TRASH) ^
+               zobrist::place(played_from_ids.computeHash(), zobrist::PLAYED_CARDS);
+    }
+
+    uint64_t ServerBoard::computeSupplyHash() const
+    {
+        uint64_t result = 0;
+        for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+            if ( pile_slots[index] != NO_SLOT ) {
+                result ^= zobrist::key(index, piles[pile_slots[index]].count);
+            }
+        }
+        return result;
+    }
+
     shared::Board::ptr_t ServerBoard::getReduced()
     {
         return std::static_pointer_cast<shared::Board>(shared_from_this());
     }
 
-    void ServerBoard::addToPlayedCards(const shared::CardBase::id_t &card_id) { played_cards.push_back(card_id); }
+    void ServerBoard::addToPlayedCards(shared::CardId card_id)
+    {
+        played_cards.push_back(card_id.name());
+        played_card_ids.push_back(card_id);
+        played_counts.add(card_id);
+    }
 
-    void ServerBoard::addToPlayedCards(const std::vector<shared::CardBase::id_t> &cards)
+    void ServerBoard::addToPlayedCards(const std::vector<shared::CardId> &cards)
     {
-        std::for_each(cards.begin(), cards.end(), [&](const auto &card_id) { played_cards.push_back(card_id); });
+        std::for_each(cards.begin(), cards.end(), [&](const auto &card_id) { addToPlayedCards(card_id); });
     }
 
-    bool ServerBoard::removeFromPlayedCards(const shared::CardBase::id_t &card_id)
+    bool ServerBoard::removeFromPlayedCards(shared::CardId card_id)
     {
-        auto it = std::find(played_cards.begin(), played_cards.end(), card_id);
-        if ( it != played_cards.end() ) {
-            played_cards.erase(it);
+        auto it = std::find(played_card_ids.begin(), played_card_ids.end(), card_id);
+        if ( it != played_card_ids.end() ) {
+            played_cards.erase(played_cards.begin() + std::distance(played_card_ids.begin(), it));
+            played_card_ids.erase(it);
+            played_counts.remove(card_id);
             return true;
         } else {
             return false;
         }
     }
 
-    void ServerBoard::tryTake(const shared::CardBase::id_t &card_id)
+    void ServerBoard::tryTake(shared::CardId card_id)
     {
         if ( !has(card_id) ) {
             LOG(WARN) << "tried to buy card: " << card_id << " but its not available";
@@ -46,39 +136,66 @@ namespace server
         take(card_id);
     }
 
-    bool ServerBoard::has(const shared::CardBase::id_t &card_id) const
+    bool ServerBoard::tryTake(shared::CardId card_id, std::nothrow_t)
     {
-        auto has_card = [card_id](const auto &pile)
-        {
-            if ( pile.find(card_id) != pile.end() ) {
-                return pile.find(card_id)->count > 0;
-            } else {
-                return false;
-            }
-        };
+        if ( !has(card_id) ) {
+            return false;
+        }
+        take(card_id);
+        return true;
+    }
 
-        return (curse_card_pile.card_id == card_id && curse_card_pile.count > 0) || has_card(treasure_cards) ||
-                has_card(victory_cards) || has_card(kingdom_cards);
+    bool ServerBoard::has(shared::CardId card_id) const
+    {
+        const shared::Pile *pile = getPile(card_id);
+        return pile != nullptr && pile->count > 0;
     }
 
-    void ServerBoard::take(const shared::CardBase::id_t &card_id)
+    bool ServerBoard::isGameOver() const
     {
-        if ( card_id == curse_card_pile.card_id ) {
-            --curse_card_pile.count;
+        return getProvincePile().empty() || empty_piles >= shared::board_config::MAX_NUM_EMPTY_PILES;
+    }
+
+    double ServerBoard::getProgress() const
+    {
+        if ( isGameOver() ) {
+            return 1.0;
         }
+        const double provinces = 1.0 - static_cast<double>(getProvincePile().count) / initial_provinces;
+        const double piles = static_cast<double>(empty_piles) / shared::board_config::MAX_NUM_EMPTY_PILES;
+        return std::max(provinces, piles);
+    }
 
-        // helper to search the card in each pile
-        auto buy_if_found = [card_id](auto &card_piles)
-        {
-            if ( card_piles.find(card_id) != card_piles.end() ) {
-                --card_piles.find(card_id)->count;
+    void ServerBoard::take(shared::CardId card_id)
+    {
+        if ( shared::Pile *pile = getMutablePile(card_id) ) {
+            --pile->count;
+            supply_hash ^= zobrist::step(card_id.index(), pile->count);
+            if ( pile->empty() ) {
+                ++empty_piles;
             }
-        };
+        }
+    }
 
-        buy_if_found(treasure_cards);
-        buy_if_found(victory_cards);
-        buy_if_found(kingdom_cards);
+    void ServerBoard::setPileCount(shared::CardId card_id, size_t count)
+    {
+        shared::Pile *pile = getMutablePile(card_id);
+        if ( pile == nullptr ) {
+            return;
+        }
+        if ( pile->empty() ) {
+            --empty_piles;
+        }
+        supply_hash ^= zobrist::key(card_id.index(), pile->count) ^ zobrist::key(card_id.index(), count);
+        pile->count = count;
+        if ( pile->empty() ) {
+            ++empty_piles;
+        }
     }
 
-    void ServerBoard::trashCard(const shared::CardBase::id_t &card) { this->trash.push_back(card); }
+    void ServerBoard::trashCard(shared::CardId card_id)
+    {
+        this->trash.push_back(card_id.name());
+        trash_counts.add(card_id);
+    }
 } // namespace server
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <random>
 #include <ranges>
+#include <stdexcept>
 
 #include <server/game/behaviour_registry.h>
 #include <server/game/server_player.h>
@@ -8,70 +9,107 @@
 
 namespace server
 {
+    Player::Player(shared::PlayerBase::id_t id, const PlayerSnapshot &snapshot) :
+        shared::PlayerBase(id), rng(shared::Xoshiro256::fromState(snapshot.rng))
+    {
+        actions = snapshot.actions;
+        buys = snapshot.buys;
+        treasure = snapshot.treasure;
+
+        auto next = snapshot.cards.begin();
+        auto takeCards = [&](size_t size)
+        {
+            CardPile::container_t cards(size);
+            std::transform(next, next + static_cast<std::ptrdiff_t>(size), cards.begin(),
+                           [](shared::CardId::index_t index) { return shared::CardId::fromIndex(index); });
+            next += static_cast<std::ptrdiff_t>(size);
+            return cards;
+        };
+        draw_pile = takeCards(snapshot.draw_pile_size);
+        hand_cards = takeCards(snapshot.hand_size);
+        discard_cards = takeCards(snapshot.discard_pile_size);
+        staged_cards = takeCards(snapshot.staged_size);
+    }
+
+    PlayerSnapshot Player::snapshot() const
+    {
+        const size_t card_count = draw_pile.size() + hand_cards.size() + discard_cards.size() + staged_cards.size();
+        if ( card_count > PlayerSnapshot::MAX_CARDS ) {
+            LOG(ERROR) << "Player " << player_id << " has " << card_count << " cards, too many for a snapshot";
+            throw std::length_error("Too many cards for a snapshot");
+        }
+
+        PlayerSnapshot snapshot{};
+        snapshot.rng = rng.getState();
+        snapshot.actions = static_cast<uint16_t>(actions);
+        snapshot.buys = static_cast<uint16_t>(buys);
+        snapshot.treasure = static_cast<uint16_t>(treasure);
+        snapshot.draw_pile_size = static_cast<uint8_t>(draw_pile.size());
+        snapshot.hand_size = static_cast<uint8_t>(hand_cards.size());
+        snapshot.discard_pile_size = static_cast<uint8_t>(discard_cards.size());
+        snapshot.staged_size = static_cast<uint8_t>(staged_cards.size());
+
+        auto toIndex = [](shared::CardId card_id) { return card_id.index(); };
+        auto next = std::ranges::transform(draw_pile.getCards(), snapshot.cards.begin(), toIndex).out;
+        next = std::ranges::transform(hand_cards, next, toIndex).out;
+        next = std::ranges::transform(discard_cards, next, toIndex).out;
+        std::ranges::transform(staged_cards, next, toIndex);
+        return snapshot;
+    }
+
+    uint64_t Player::hash(size_t seat) const { return hashWith(seat, &CardCounts::hash); }
+
+    uint64_t Player::computeHash(size_t seat) const { return hashWith(seat, &CardCounts::computeHash); }
+
+    uint64_t Player::hashWith(size_t seat, uint64_t (CardCounts::*pile_hash)() const) const
+    {
+        const auto first = static_cast<unsigned>(seat * zobrist::PLAYER_PILES);
+        return zobrist::place((draw_pile.getCounts().*pile_hash)(), first + zobrist::DRAW_PILE) ^
+               zobrist::place((hand_cards.getCounts().*pile_hash)(), first + zobrist::HAND) ^
+               zobrist::place((discard_cards.getCounts().*pile_hash)(), first + zobrist::DISCARD_PILE) ^
+               zobrist::place((staged_cards.getCounts().*pile_hash)(), first + zobrist::STAGED_CARDS) ^
+               zobrist::value(first + 0, actions) ^ zobrist::value(first + 1, buys) ^
+               zobrist::value(first + 2, treasure);
+    }
+
     reduced::Player::ptr_t Player::getReducedPlayer()
     {
-        std::sort(this->hand_cards.begin(), this->hand_cards.end(),
-                  [](const auto &id_a, const auto &id_b)
-                  {
-                      const auto type_a = shared::CardFactory::getType(id_a);
-                      const auto type_b = shared::CardFactory::getType(id_b);
-
-                      // custom order
-                      auto getCustomOrder = [](shared::CardType type)
-                      {
-                          if ( (type & shared::CardType::ACTION) != 0 ) {
-                              return 1;
-                          } else if ( (type & shared::CardType::TREASURE) != 0 ) {
-                              return 2;
-                          } else if ( (type & shared::CardType::VICTORY) != 0 ) {
-                              return 3;
-                          } else {
-                              return 4;
-                          }
-                      };
-
-                      int order_a = getCustomOrder(type_a);
-                      int order_b = getCustomOrder(type_b);
-
-                      if ( order_a != order_b ) {
-                          return order_a < order_b;
-                      }
-
-                      const auto cost_a = shared::CardFactory::getCost(id_a);
-                      const auto cost_b = shared::CardFactory::getCost(id_b);
-
-                      if ( cost_a != cost_b ) {
-                          return cost_a < cost_b; // lowest cost first
-                      }
-
-                      // sort by name if same category and same cost
-                      return id_a < id_b;
-                  });
+        if ( player_view != nullptr && player_view_key == viewKey() ) {
+            return std::make_unique<reduced::Player>(*player_view);
+        }
+
+        // the hand is kept in display order, see HandPile
+        std::vector<shared::CardBase::id_t> hand_card_names;
+        hand_card_names.reserve(hand_cards.size());
+        std::transform(hand_cards.begin(), hand_cards.end(), std::back_inserter(hand_card_names),
+                       [](const auto &card_id) { return card_id.name(); });
 
         this->draw_pile_size = draw_pile.size();
-        return reduced::Player::make(static_cast<shared::PlayerBase>(*this), hand_cards);
+        syncDiscardPile();
+        player_view = reduced::Player::make(static_cast<shared::PlayerBase>(*this), std::move(hand_card_names));
+        player_view_key = viewKey();
+        return std::make_unique<reduced::Player>(*player_view);
     }
 
     reduced::Enemy::ptr_t Player::getReducedEnemy()
     {
-        this->draw_pile_size = draw_pile.size();
-        return reduced::Enemy::make(static_cast<shared::PlayerBase>(*this), hand_cards.size());
+        if ( enemy_view == nullptr || enemy_view_key != viewKey() ) {
+            this->draw_pile_size = draw_pile.size();
+            syncDiscardPile();
+            enemy_view = reduced::Enemy::make(static_cast<shared::PlayerBase>(*this), hand_cards.size());
+            enemy_view_key = viewKey();
+        }
+        return std::make_unique<reduced::Enemy>(*enemy_view);
     }
 
-    std::vector<shared::CardBase::id_t> Player::getDeck() const
+    CardCounts Player::getDeckCounts() const
     {
         if ( !staged_cards.empty() ) {
             LOG(ERROR) << "staged cards should be empty when getting deck";
             throw exception::OutOfPhase("You can not get your deck while you are playing a card!");
         }
 
-        std::vector<shared::CardBase::id_t> deck;
-        deck.reserve(draw_pile.size() + discard_pile.size() + hand_cards.size());
-        deck.insert(deck.end(), draw_pile.begin(), draw_pile.end());
-        deck.insert(deck.end(), discard_pile.begin(), discard_pile.end());
-        deck.insert(deck.end(), hand_cards.begin(), hand_cards.end());
-
-        return deck;
+        return draw_pile.getCounts() + discard_cards.getCounts() + hand_cards.getCounts();
     }
 
     void Player::resetValues()
@@ -81,6 +119,13 @@ namespace server
         treasure = 0;
     }
 
+    void Player::syncDiscardPile()
+    {
+        discard_pile.resize(discard_cards.size());
+        std::transform(discard_cards.begin(), discard_cards.end(), discard_pile.begin(),
+                       [](const auto &card_id) { return card_id.name(); });
+    }
+
     void Player::endTurn()
     {
         if ( !staged_cards.empty() ) {
@@ -104,13 +149,9 @@ namespace server
 
     int Player::getVictoryPoints() const
     {
-        std::vector<shared::CardBase::id_t> deck = getDeck();
-        int victory_points = 0;
-        for ( const auto &card_id : deck ) {
-            VictoryCardBehaviour &behaviour = BehaviourRegistry().getVictoryBehaviour(card_id);
-            victory_points += behaviour.getVictoryPoints(deck);
-        }
-        return victory_points;
+        return (draw_pile.getCounts().victoryTally() + hand_cards.getCounts().victoryTally() +
+                discard_cards.getCounts().victoryTally() + staged_cards.getCounts().victoryTally())
+                .points();
     }
 
 } // namespace server
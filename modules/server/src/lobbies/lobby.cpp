@@ -31,18 +31,25 @@ namespace server
     {
         // NOLINTBEGIN(bugprone-macro-parentheses)
 #define HANDLE(message_type, handler_func)                                                                             \
-    if ( dynamic_cast<shared::message_type *>(message.get()) ) {                                                       \
-        LOG(INFO) << "Trying to handle: " << #message_type;                                                            \
-        std::unique_ptr<shared::message_type> casted_message(static_cast<shared::message_type *>(message.release()));  \
-        handler_func(message_interface, casted_message);                                                               \
-        return;                                                                                                        \
-    }
+    case shared::message_type::KIND:                                                                                   \
+        {                                                                                                              \
+            LOG(INFO) << "Trying to handle: " << #message_type;                                                        \
+            std::unique_ptr<shared::message_type> casted_message(                                                      \
+                    static_cast<shared::message_type *>(message.release()));                                           \
+            handler_func(message_interface, casted_message);                                                           \
+            return;                                                                                                    \
+        }
         // NOLINTEND(bugprone-macro-parentheses)
 
         // handle messages the lobby is responsible for
-        HANDLE(JoinLobbyRequestMessage, addPlayer);
-        HANDLE(StartGameRequestMessage, startGame);
-        HANDLE(GameStateRequestMessage, getGameState);
+        switch ( message->getKind() ) {
+            HANDLE(JoinLobbyRequestMessage, addPlayer);
+            HANDLE(StartGameRequestMessage, startGame);
+            HANDLE(GameStateRequestMessage, getGameState);
+            default:
+                break;
+        }
+#undef HANDLE
 
         const auto requestor_id = message->player_id;
 
@@ -65,7 +72,16 @@ namespace server
         const auto message_id = message->message_id;
         try {
             // ISSUE: 166
-            order_response = game_interface->handleMessage(message);
+            // rejected moves are returned, only behaviours and errors we can not recover from throw
+            auto result = game_interface->handleMessage(message, std::nothrow);
+            if ( const auto *rejected = std::get_if<MoveResult>(&result) ) {
+                const std::string reason = rejected->message();
+                LOG(DEBUG) << "Rejected a move of player " << requestor_id << ": " << reason;
+                message_interface.send<shared::ResultResponseMessage>(requestor_id, lobby_id, false, message_id,
+                                                                      reason);
+                return;
+            }
+            order_response = std::move(std::get<OrderResponse>(result));
         } catch ( exception::UnreachableCode &e ) {
             LOG(ERROR) << "Unrecoverable error received from game_interface. Error: " << e.what();
             throw e;
@@ -12,7 +12,7 @@ namespace server
         }
 
         // handle create lobby
-        if ( dynamic_cast<shared::CreateLobbyRequestMessage *>(message.get()) != nullptr ) {
+        if ( message->getKind() == shared::MessageKind::CREATE_LOBBY_REQUEST ) {
             LOG(INFO) << "Trying to handle: CreateLobbyRequestMessage";
             std::unique_ptr<shared::CreateLobbyRequestMessage> unique_CreateLobbyRequestMessage(
                     static_cast<shared::CreateLobbyRequestMessage *>(message.release()));
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <server/message/order_response.h>
 #include <shared/utils/logger.h>
 
@@ -17,11 +19,20 @@ void OrderResponse::setGameOver(std::vector<shared::PlayerResult> results)
     _player_results = std::move(results);
 }
 
-void OrderResponse::addOrder(const shared::PlayerBase::id_t &player_id, std::unique_ptr<shared::ActionOrder> order)
+bool OrderResponse::empty() const
 {
-    if ( hasOrder(player_id) ) {
-        LOG(ERROR) << "Tried to give player " + player_id + " two orders at once";
-        throw std::runtime_error("Tried to give player " + player_id + " two orders at once");
+    return std::all_of(orders.begin(), orders.end(), [](const auto &order) { return order == nullptr; });
+}
+
+void OrderResponse::addOrder(shared::PlayerBase::seat_t seat, std::unique_ptr<shared::ActionOrder> order)
+{
+    if ( seat >= orders.size() ) {
+        LOG(ERROR) << "Tried to give an order to seat " << seat << ", but there are only " << orders.size();
+        throw std::out_of_range("Tried to give an order to seat " + std::to_string(seat));
+    }
+    if ( hasOrder(seat) ) {
+        LOG(ERROR) << "Tried to give the player at seat " << seat << " two orders at once";
+        throw std::runtime_error("Tried to give the player at seat " + std::to_string(seat) + " two orders at once");
     }
-    response_map.emplace(player_id, std::move(order));
+    orders[seat] = std::move(order);
 }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <server/network/basic_network.h>
 #include <shared/utils/logger.h>
 #include <string>
@@ -12,21 +13,38 @@ namespace server
     {
         LOG(INFO) << "Sending Message: " << message << " to Address: " << address;
         try {
-            sockpp::tcp_socket *socket;
+            std::shared_ptr<Connection> connection;
+            std::optional<channel_id_t> channel;
 
             {
                 std::shared_lock<std::shared_mutex> lock(_rw_lock);
-                socket = getSocket(address);
+                const std::string *connection_address = &address;
+                auto channel_it = _channel_address_to_endpoint.find(address);
+                if ( channel_it != _channel_address_to_endpoint.end() ) {
+                    channel = channel_it->second.channel;
+                    connection_address = &channel_it->second.connection_address;
+                }
+                connection = getConnection(*connection_address);
             }
 
-            if ( socket == nullptr ) {
+            if ( connection == nullptr ) {
                 LOG(ERROR) << "Failed to get socket for address: " << address;
                 return ssize_t(-1);
             }
 
-            std::stringstream ss_msg;
-            ss_msg << std::to_string(message.size()) << ':' << message; // prepend message length
-            sockpp::result<size_t> res = socket->write(ss_msg.str()); // TODO: make this thread safe (wrapper class)
+            const std::string frame = encodeFrame(message, channel); // prepend message length (and channel)
+
+            // the frames of different threads must not interleave on the connection
+            std::lock_guard<std::mutex> write_lock(connection->write_mutex);
+            if ( _batch_depth > 0 && connection->corkable &&
+                 std::find(_corked_connections.begin(), _corked_connections.end(), connection) ==
+                         _corked_connections.end() ) {
+                _corked_connections.push_back(connection);
+                if ( connection->cork_count++ == 0 ) {
+                    setCork(connection->socket, true);
+                }
+            }
+            sockpp::result<size_t> res = connection->socket.write(frame);
             if ( res.is_error() ) {
                 LOG(ERROR) << "Failed to send message to address: " << address
                            << ". Socket error: " << res.error_message();
@@ -94,24 +112,97 @@ namespace server
         return true;
     }
 
-    void BasicNetwork::addAddressToSocket(const std::string &address, const sockpp::tcp_socket socket)
+    void BasicNetwork::addAddressToSocket(const std::string &address, sockpp::stream_socket socket, bool is_tcp)
     {
         std::unique_lock<std::shared_mutex> lock(_rw_lock);
 
-        if ( _address_to_socket.count(address) != 0 ) {
+        if ( _address_to_connection.count(address) != 0 ) {
             LOG(ERROR) << "Address is already connected: " << address;
         } else {
             LOG(DEBUG) << "Adding address: " << address;
-            _address_to_socket.emplace(address, socket.clone());
+            applySocketOptions(socket, _socket_options, is_tcp);
+            _address_to_connection.emplace(
+                    address, std::make_shared<Connection>(std::move(socket), is_tcp && _socket_options.tcp_cork));
         }
     }
 
+    void BasicNetwork::setSocketOptions(const SocketOptions &options)
+    {
+        std::unique_lock<std::shared_mutex> lock(_rw_lock);
+        _socket_options = options;
+    }
+
+    BasicNetwork::SendBatch::SendBatch() { ++_batch_depth; }
+
+    BasicNetwork::SendBatch::~SendBatch()
+    {
+        if ( --_batch_depth > 0 ) {
+            return;
+        }
+
+        for ( const auto &connection : _corked_connections ) {
+            // a batch of another thread might still be sending to the connection
+            std::lock_guard<std::mutex> write_lock(connection->write_mutex);
+            if ( --connection->cork_count == 0 ) {
+                setCork(connection->socket, false);
+            }
+        }
+        _corked_connections.clear();
+    }
+
+    std::string BasicNetwork::addChannel(const std::string &address, channel_id_t channel)
+    {
+        std::string channel_address = address + "/" + std::to_string(channel);
+
+        std::unique_lock<std::shared_mutex> lock(_rw_lock);
+        if ( _channel_address_to_endpoint.count(channel_address) != 0 ) {
+            LOG(ERROR) << "Channel is already open: " << channel_address;
+        } else {
+            LOG(DEBUG) << "Opening channel: " << channel_address;
+            _channel_address_to_endpoint.emplace(channel_address, ChannelEndpoint{address, channel});
+            _connection_to_channel_addresses[address].push_back(channel_address);
+        }
+        return channel_address;
+    }
+
+    void BasicNetwork::closeChannel(const std::string &channel_address)
+    {
+        playerDisconnect(channel_address);
+
+        std::unique_lock<std::shared_mutex> lock(_rw_lock);
+        auto it = _channel_address_to_endpoint.find(channel_address);
+        if ( it == _channel_address_to_endpoint.end() ) {
+            return;
+        }
+        auto &siblings = _connection_to_channel_addresses[it->second.connection_address];
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), channel_address), siblings.end());
+        _channel_address_to_endpoint.erase(it);
+    }
+
     void BasicNetwork::playerDisconnect(const std::string &address)
     {
         LOG(INFO) << "Disconnecting Address: " << address;
+
+        // a multiplexed connection takes all of its channels down with it
+        std::vector<std::string> channel_addresses;
+        {
+            std::unique_lock<std::shared_mutex> lock(_rw_lock);
+            auto it = _connection_to_channel_addresses.find(address);
+            if ( it != _connection_to_channel_addresses.end() ) {
+                channel_addresses = std::move(it->second);
+                _connection_to_channel_addresses.erase(it);
+            }
+        }
+        for ( const auto &channel_address : channel_addresses ) {
+            playerDisconnect(channel_address);
+            std::unique_lock<std::shared_mutex> lock(_rw_lock);
+            _channel_address_to_endpoint.erase(channel_address);
+        }
+
         std::unique_lock<std::shared_mutex> lock(_rw_lock);
 
-        if ( _address_to_player_id.find(address) != _address_to_player_id.end() ) {
+        const bool has_player = _address_to_player_id.find(address) != _address_to_player_id.end();
+        if ( has_player ) {
             player_id_t player_id = _address_to_player_id.find(address)->second;
             lock.unlock();
             ServerNetworkManager::removePlayer(_player_id_to_lobby_id.find(player_id)->second, player_id);
@@ -119,9 +210,15 @@ namespace server
             _player_id_to_lobby_id.erase(player_id);
             _player_id_to_address.erase(player_id);
             _address_to_player_id.erase(address);
-            _address_to_socket.erase(address);
             LOG(INFO) << "Player with Address " << address << " disconnected and resources released.";
-        } else {
+        }
+
+        // readLoop disconnects every connection exactly once, also the ones that never registered a player or whose
+        // channels were all closed before
+        const bool was_connected = _address_to_connection.erase(address) != 0;
+        if ( !has_player && was_connected ) {
+            LOG(INFO) << "Connection " << address << " closed with " << channel_addresses.size() << " open channels.";
+        } else if ( !has_player ) {
             LOG(WARN) << "Attempted to disconnect player with Address " << address << ", but it was not found.";
         }
     }
@@ -137,12 +234,12 @@ namespace server
         return _player_id_to_address.find(player_id) == _player_id_to_address.end();
     }
 
-    sockpp::tcp_socket *BasicNetwork::getSocket(const std::string &address)
+    std::shared_ptr<BasicNetwork::Connection> BasicNetwork::getConnection(const std::string &address)
     {
         // ASSUMING CALLER HOLDS THE LOCK!
-        auto it = _address_to_socket.find(address);
-        if ( it != _address_to_socket.end() ) {
-            return &(it->second);
+        auto it = _address_to_connection.find(address);
+        if ( it != _address_to_connection.end() ) {
+            return it->second;
         } else {
             LOG(ERROR) << "Cannot find socket for address: " << address;
             return nullptr;
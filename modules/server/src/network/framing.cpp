@@ -0,0 +1,94 @@
+#include <server/network/framing.h>
+
+#include <charconv>
+
+#include <shared/utils/exception.h>
+
+namespace server
+{
+    namespace
+    {
+        template <typename T>
+        T parseNumber(const char *begin, const char *end)
+        {
+            T value{};
+            auto [ptr, ec] = std::from_chars(begin, end, value);
+            if ( begin == end || ec != std::errc() || ptr != end ) {
+                throw exception::MalformedFrame("Invalid number in frame header: " + std::string(begin, end));
+            }
+            return value;
+        }
+    } // namespace
+
+    std::string encodeFrame(const std::string &payload, std::optional<channel_id_t> channel)
+    {
+        std::string frame;
+        frame.reserve(payload.size() + 16);
+        if ( channel.has_value() ) {
+            frame += std::to_string(channel.value());
+            frame += '/';
+        }
+        frame += std::to_string(payload.size());
+        frame += ':';
+        frame += payload;
+        return frame;
+    }
+
+    void FrameParser::append(const char *data, size_t size)
+    {
+        // drop consumed frames before growing the buffer
+        if ( _offset > 0 ) {
+            _buffer.erase(0, _offset);
+            _offset = 0;
+        }
+        _buffer.append(data, size);
+    }
+
+    std::optional<Frame> FrameParser::next()
+    {
+        const size_t available = _buffer.size() - _offset;
+        const size_t separator_pos = _buffer.find(':', _offset);
+        if ( separator_pos == std::string::npos ) {
+            if ( available > MAX_HEADER_LENGTH ) {
+                throw exception::MalformedFrame("Missing length separator ':'");
+            }
+            return std::nullopt;
+        }
+        if ( separator_pos - _offset > MAX_HEADER_LENGTH ) {
+            throw exception::MalformedFrame("Frame header too long");
+        }
+
+        const char *header_begin = _buffer.data() + _offset;
+        const char *header_end = _buffer.data() + separator_pos;
+
+        Frame frame;
+        const char *length_begin = header_begin;
+        for ( const char *it = header_begin; it != header_end; ++it ) {
+            if ( *it == '/' ) {
+                frame.channel = parseNumber<channel_id_t>(header_begin, it);
+                length_begin = it + 1;
+                break;
+            }
+        }
+        const size_t length = parseNumber<size_t>(length_begin, header_end);
+        if ( length > MAX_FRAME_LENGTH ) {
+            throw exception::MalformedFrame("Frame payload too long: " + std::to_string(length) + " bytes");
+        }
+
+        const size_t payload_begin = separator_pos + 1;
+        if ( _buffer.size() - payload_begin < length ) {
+            // wait for the rest of the payload
+            return std::nullopt;
+        }
+
+        frame.payload.assign(_buffer, payload_begin, length);
+        _offset = payload_begin + length;
+        return frame;
+    }
+
+    void FrameParser::clear()
+    {
+        _buffer.clear();
+        _offset = 0;
+    }
+} // namespace server
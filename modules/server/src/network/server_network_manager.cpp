@@ -1,19 +1,20 @@
 
+#include <atomic>
+#include <filesystem>
 #include <iostream>
 #include <sstream>
 
 #include <server/network/server_network_manager.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/logger.h>
 #include "server/network/basic_network.h"
 
-using handler = std::function<void(const std::string &, const sockpp::tcp_socket::addr_t &)>;
-
 namespace server
 {
     std::shared_ptr<MessageInterface> ServerNetworkManager::_message_interface;
     LobbyManager ServerNetworkManager::_lobby_manager(ServerNetworkManager::_message_interface);
 
-    ServerNetworkManager::ServerNetworkManager()
+    ServerNetworkManager::ServerNetworkManager(const SocketOptions &socket_options)
     {
         // @matthieu, should this be singleton?
         if ( _instance == nullptr ) {
@@ -21,12 +22,17 @@ namespace server
         }
         _message_interface = std::make_shared<ImplementedMessageInterface>();
         _lobby_manager = LobbyManager(_message_interface);
+        _socket_options = socket_options;
+        BasicNetwork::setSocketOptions(socket_options);
     }
 
-    void ServerNetworkManager::run(const std::string &host, uint16_t port)
+    void ServerNetworkManager::run(const std::string &host, uint16_t port, const std::string &unix_socket_path)
     {
         LOG(INFO) << "Running the server on " << host << ":" << port;
         sockpp::socket_initializer::initialize(); // Required to initialise sockpp
+        if ( !unix_socket_path.empty() ) {
+            this->connectUnix(unix_socket_path);
+        }
         this->connect(port);
     }
 
@@ -35,7 +41,7 @@ namespace server
     void ServerNetworkManager::connect(const uint16_t port)
     {
         try {
-            this->_acc = sockpp::tcp_acceptor(port);
+            this->_acc = sockpp::tcp_acceptor(port, _socket_options.listen_backlog);
         } catch ( const std::system_error &e ) {
             LOG(ERROR) << "Error creating the acceptor: " << e.what();
             return;
@@ -45,6 +51,60 @@ namespace server
         listenerLoop();
     }
 
+    void ServerNetworkManager::connectUnix(const std::string &path)
+    {
+        // the server gets restarted after a crash, the unix listener survives that
+        if ( _unix_acc.is_open() ) {
+            return;
+        }
+
+        try {
+            if ( !removeStaleUnixSocket(path) ) {
+                return;
+            }
+            sockpp::result<> result = _unix_acc.open(sockpp::unix_address(path), _socket_options.listen_backlog);
+            if ( result.is_error() ) {
+                LOG(ERROR) << "Error creating the unix acceptor: " << result.error_message();
+                return;
+            }
+        } catch ( const std::exception &e ) {
+            // thrown by unix_address for invalid paths
+            LOG(ERROR) << "Error creating the unix acceptor: " << e.what();
+            return;
+        }
+
+        LOG(INFO) << "Awaiting connections on unix socket " << path;
+        std::thread listener(unixListenerLoop);
+        listener.detach();
+    }
+
+    bool ServerNetworkManager::removeStaleUnixSocket(const std::string &path)
+    {
+        std::error_code error;
+        const std::filesystem::file_status status = std::filesystem::symlink_status(path, error);
+        if ( status.type() == std::filesystem::file_type::not_found ) {
+            return true;
+        }
+        if ( !std::filesystem::is_socket(status) ) {
+            LOG(ERROR) << "Not creating the unix acceptor, " << path << " exists and is not a socket";
+            return false;
+        }
+
+        // a socket file is stale if no server is listening on it anymore
+        sockpp::unix_connector probe;
+        if ( probe.connect(sockpp::unix_address(path)) ) {
+            LOG(ERROR) << "Not creating the unix acceptor, another server is listening on " << path;
+            return false;
+        }
+
+        // a stale socket file from a previous run would make bind() fail
+        if ( !std::filesystem::remove(path, error) && error ) {
+            LOG(ERROR) << "Error removing the stale unix socket " << path << ": " << error.message();
+            return false;
+        }
+        return true;
+    }
+
     void ServerNetworkManager::listenerLoop()
     {
         LOG(INFO) << "Starting a new listener loop";
@@ -64,18 +124,47 @@ namespace server
             auto sock = result.release();
 
             const std::string address = sock.peer_address().to_string();
-            BasicNetwork::addAddressToSocket(address, sock.clone());
+            startReading(std::move(sock), address, true);
+        }
+    }
+
+    void ServerNetworkManager::unixListenerLoop()
+    {
+        LOG(INFO) << "Starting a new unix listener loop";
+        // unix peers are (almost always) unnamed, so we hand out our own unique addresses
+        static std::atomic<uint64_t> connection_counter = 0;
+
+        // intentional endless loop
+        while ( true ) {
+            sockpp::result<sockpp::unix_socket> result = _unix_acc.accept();
 
-            // Create a listener thread and transfer the new stream to it.
-            // Incoming messages will be passed to handle_message().
-            std::thread listener(readLoop, std::move(sock), handleMessage);
-            listener.detach();
+            if ( result.is_error() ) {
+                LOG(ERROR) << "Error accepting incoming unix connection: " << result.error_message();
+                return;
+            }
+
+            // e.g. "unix:/tmp/dominion.sock#3", can never clash with a TCP peer address
+            const std::string address =
+                    _unix_acc.address().to_string() + "#" + std::to_string(connection_counter++);
+            LOG(DEBUG) << "Received a unix connection request, assigned address " << address;
+            startReading(result.release(), address, false);
         }
     }
 
+    void ServerNetworkManager::startReading(sockpp::stream_socket socket, const std::string &address, bool is_tcp)
+    {
+        BasicNetwork::addAddressToSocket(address, socket.clone(), is_tcp);
+
+        // Create a listener thread and transfer the new stream to it.
+        // Incoming messages will be passed to handle_message().
+        std::thread listener(readLoop, std::move(socket), address, handleMessage);
+        listener.detach();
+    }
+
     // Runs in a thread and reads anything coming in on the 'socket'.
     // Once a message is fully received, the string is passed on to the 'handle_message()' function
-    void ServerNetworkManager::readLoop(sockpp::tcp_socket socket, const handler &message_handler)
+    void ServerNetworkManager::readLoop(sockpp::stream_socket socket, const std::string &address,
+                                        const handler &message_handler)
     {
         sockpp::socket_initializer::initialize(); // initializes socket framework
 
@@ -83,47 +172,40 @@ namespace server
         std::string buffer(BUFFER_SIZE, '\0');
         sockpp::result<size_t> result;
 
+        // a single read may contain several frames (e.g. from a multiplexed connection) or only part of one
+        FrameParser parser;
+        // addresses of the channels opened on this connection, only used by multiplexed connections
+        std::unordered_map<channel_id_t, std::string> channel_addresses;
+
         while ( (result = socket.read(buffer.data(), buffer.size())).is_ok() && result.value() != 0 ) {
+            parser.append(buffer.data(), result.value());
             try {
-                std::string_view read_data(buffer.data(), result.value());
-                size_t separator_pos = read_data.find(':');
-
-                if ( separator_pos == std::string_view::npos ) {
-                    LOG(ERROR) << "Malformed message: Missing length separator ':'";
-                    continue;
-                }
-
-                size_t msg_length = std::stoul(std::string(read_data.substr(0, separator_pos)));
-                LOG(INFO) << "Expecting message of length " << msg_length;
-
-                // accumulate the message payload
-                std::string message;
-                message.reserve(msg_length);
-                message.append(read_data.substr(separator_pos + 1));
-                size_t msg_bytes_read = message.size();
-
-                // read the remaining packages
-                while ( msg_bytes_read < msg_length ) {
-                    result = socket.read(buffer.data(), buffer.size());
-                    if ( result.is_error() || result.value() == 0 ) {
-                        break; // end of stream or error
+                while ( std::optional<Frame> frame = parser.next() ) {
+                    LOG(INFO) << "Received Message: " << frame->payload;
+                    if ( !frame->channel.has_value() ) {
+                        message_handler(frame->payload, address);
+                        continue;
                     }
 
-                    size_t count = result.value();
-
-                    message.append(buffer.data(), count);
-                    msg_bytes_read += count;
-                }
-
-                if ( msg_bytes_read == msg_length ) {
-                    LOG(INFO) << "Received Message: " << message;
-                    message_handler(message, socket.peer_address());
-                } else {
-                    LOG(ERROR) << "Incomplete message. Expected " << msg_length << " bytes, but received "
-                               << msg_bytes_read;
+                    const channel_id_t channel = frame->channel.value();
+                    auto channel_it = channel_addresses.find(channel);
+                    if ( frame->payload.empty() ) {
+                        // an empty frame closes the channel
+                        if ( channel_it != channel_addresses.end() ) {
+                            BasicNetwork::closeChannel(channel_it->second);
+                            channel_addresses.erase(channel_it);
+                        }
+                        continue;
+                    }
+                    if ( channel_it == channel_addresses.end() ) {
+                        channel_it = channel_addresses.emplace(channel, BasicNetwork::addChannel(address, channel)).first;
+                    }
+                    message_handler(frame->payload, channel_it->second);
                 }
-            } catch ( const std::exception &e ) {
-                LOG(ERROR) << "Error while reading message from " << socket.peer_address() << ": " << e.what();
+            } catch ( const exception::MalformedFrame &e ) {
+                // the start of the next frame can not be found anymore, so the rest of the stream is useless
+                LOG(ERROR) << "Closing connection to " << address << " after a malformed frame: " << e.what();
+                break;
             }
         }
 
@@ -131,12 +213,12 @@ namespace server
             LOG(ERROR) << "Read error: " << result.error_message();
         }
 
-        LOG(DEBUG) << "Closing connection to " << socket.peer_address();
-        BasicNetwork::playerDisconnect(socket.peer_address().to_string());
+        LOG(DEBUG) << "Closing connection to " << address;
+        BasicNetwork::playerDisconnect(address);
         socket.shutdown();
     }
 
-    void ServerNetworkManager::handleMessage(const std::string &msg, const sockpp::tcp_socket::addr_t &peer_address)
+    void ServerNetworkManager::handleMessage(const std::string &msg, const std::string &address)
     {
         try {
             // try to parse a client_request from msg
@@ -149,9 +231,11 @@ namespace server
             }
 
             // check if this is a connection to a new player
-            if ( BasicNetwork::addPlayerToAddress(req->player_id, req->game_id, peer_address.to_string()) ) {
+            if ( BasicNetwork::addPlayerToAddress(req->player_id, req->game_id, address) ) {
                 LOG(INFO) << "Handling request from player(" << req->player_id << "): " << msg;
 
+                // all replies to this request are flushed together
+                BasicNetwork::SendBatch batch;
                 _lobby_manager.handleMessage(req);
             }
         } catch ( const std::exception &e ) {
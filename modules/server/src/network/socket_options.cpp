@@ -0,0 +1,52 @@
+#include <server/network/socket_options.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        void logIfFailed(const sockpp::result<> &result, const std::string &option)
+        {
+            if ( result.is_error() ) {
+                LOG(WARN) << "Failed to set socket option " << option << ": " << result.error_message();
+            }
+        }
+    } // namespace
+
+    void applySocketOptions(sockpp::stream_socket &socket, const SocketOptions &options, bool is_tcp)
+    {
+        if ( is_tcp && options.tcp_nodelay ) {
+            logIfFailed(socket.nodelay(true), "TCP_NODELAY");
+        }
+        if ( options.send_buffer_size != 0 ) {
+            logIfFailed(socket.send_buffer_size(options.send_buffer_size), "SO_SNDBUF");
+        }
+        if ( options.receive_buffer_size != 0 ) {
+            logIfFailed(socket.recv_buffer_size(options.receive_buffer_size), "SO_RCVBUF");
+        }
+        if ( options.busy_poll_us != 0 ) {
+#ifdef SO_BUSY_POLL
+            // raising it above net.core.busy_read needs CAP_NET_ADMIN
+            logIfFailed(socket.set_option(SOL_SOCKET, SO_BUSY_POLL, static_cast<int>(options.busy_poll_us)),
+                        "SO_BUSY_POLL");
+#else
+            LOG(WARN) << "SO_BUSY_POLL is not supported on this platform";
+#endif
+        }
+    }
+
+    void setCork(sockpp::stream_socket &socket, bool corked)
+    {
+#ifdef TCP_CORK
+        logIfFailed(socket.set_option(IPPROTO_TCP, TCP_CORK, static_cast<int>(corked)), "TCP_CORK");
+#else
+        (void)socket;
+        (void)corked;
+#endif
+    }
+} // namespace server
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
@@ -8,6 +9,20 @@
 #include "shared/action_order.h"
 namespace shared
 {
+    /**
+     * @brief Which subclass an ActionDecision is. Every subclass passes its KIND to the base constructor, so the tag
+     * is set as soon as a decision is created or parsed and decisions can be dispatched with a switch.
+     */
+    enum class DecisionKind : uint8_t
+    {
+        PLAY_ACTION_CARD,
+        BUY_CARD,
+        END_ACTION_PHASE,
+        END_TURN,
+        DECK_CHOICE,
+        GAIN_FROM_BOARD,
+    };
+
     class ActionDecision
     {
     public:
@@ -15,18 +30,38 @@ namespace shared
         bool operator==(const ActionDecision &other) const;
         bool operator!=(const ActionDecision &other) const;
 
+        DecisionKind getKind() const { return kind; }
+
     protected:
+        explicit ActionDecision(DecisionKind kind) : kind(kind) {}
+
         virtual bool equals(const ActionDecision &other) const = 0;
+
+    private:
+        DecisionKind kind;
     };
 
+    /**
+     * @brief Downcast checked by the kind tag instead of RTTI.
+     * @return nullptr if decision is nullptr or of another type
+     */
+    template <typename DecisionType>
+    DecisionType *decisionCast(ActionDecision *decision)
+    {
+        return decision != nullptr && decision->getKind() == DecisionType::KIND ? static_cast<DecisionType *>(decision)
+                                                                                : nullptr;
+    }
+
     class PlayActionCardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::PLAY_ACTION_CARD;
+
         bool operator==(const PlayActionCardDecision &other) const;
         bool operator!=(const PlayActionCardDecision &other) const;
         PlayActionCardDecision(shared::CardBase::id_t card_id,
                                shared::CardAccess from_pile = shared::CardAccess::HAND) :
-            card_id(card_id),
+            ActionDecision(KIND), card_id(card_id),
             from(from_pile)
         {}
 
@@ -40,9 +75,11 @@ namespace shared
     class BuyCardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::BUY_CARD;
+
         bool operator==(const BuyCardDecision &other) const;
         bool operator!=(const BuyCardDecision &other) const;
-        BuyCardDecision(CardBase::id_t card) : card(card) {}
+        BuyCardDecision(CardBase::id_t card) : ActionDecision(KIND), card(card) {}
         CardBase::id_t card;
 
     protected:
@@ -52,9 +89,11 @@ namespace shared
     class EndActionPhaseDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::END_ACTION_PHASE;
+
         bool operator==(const EndActionPhaseDecision &other) const;
         bool operator!=(const EndActionPhaseDecision &other) const;
-        EndActionPhaseDecision() = default;
+        EndActionPhaseDecision() : ActionDecision(KIND) {}
 
     protected:
         bool equals(const ActionDecision &other) const override;
@@ -63,9 +102,11 @@ namespace shared
     class EndTurnDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::END_TURN;
+
         bool operator==(const EndTurnDecision &other) const;
         bool operator!=(const EndTurnDecision &other) const;
-        EndTurnDecision() = default;
+        EndTurnDecision() : ActionDecision(KIND) {}
 
     protected:
         bool equals(const ActionDecision &other) const override;
@@ -74,12 +115,14 @@ namespace shared
     class DeckChoiceDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::DECK_CHOICE;
+
         std::vector<shared::CardBase::id_t> cards;
         std::vector<ChooseFromOrder::AllowedChoice> choices;
 
         DeckChoiceDecision(std::vector<shared::CardBase::id_t> cards,
                            std::vector<ChooseFromOrder::AllowedChoice> choices) :
-            cards(cards),
+            ActionDecision(KIND), cards(cards),
             choices(choices)
         {}
 
@@ -93,8 +136,10 @@ namespace shared
     class GainFromBoardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionKind KIND = DecisionKind::GAIN_FROM_BOARD;
+
         shared::CardBase::id_t chosen_card;
-        GainFromBoardDecision(shared::CardBase::id_t chosen_card) : chosen_card(chosen_card) {}
+        GainFromBoardDecision(shared::CardBase::id_t chosen_card) : ActionDecision(KIND), chosen_card(chosen_card) {}
         bool operator==(const GainFromBoardDecision &other) const;
         bool operator!=(const GainFromBoardDecision &other) const;
 
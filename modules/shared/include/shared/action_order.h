@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <shared/game/cards/card_base.h>
 #include <shared/game/game_state/player_base.h>
 
@@ -46,6 +48,10 @@ namespace shared
          * @brief Convert this order to a JSON object.
          */
         rapidjson::Document toJson() const;
+        /**
+         * @brief Write this order to `writer`, gives the same JSON as toJson() without building a document.
+         */
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
 
     protected:
         /**
@@ -29,7 +29,7 @@ namespace shared
 
         unsigned int getCost() const { return cost; }
         CardType getType() const { return type; }
-        id_t getId() const { return id; }
+        const id_t &getId() const { return id; }
 
         bool isAction() const { return (type & ACTION) == ACTION; }
         bool isAttack() const { return (type & ATTACK) == ATTACK; }
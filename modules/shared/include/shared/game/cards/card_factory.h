@@ -1,39 +1,70 @@
 #pragma once
 
 #include <algorithm>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_id.h>
+#include <shared/game/cards/card_table.h>
 #include <shared/utils/logger.h>
 
 namespace shared
 {
+    /**
+     * @brief Gives access to the cards of the CARD_TABLE.
+     *
+     * All the lookups taking a CardId index the constexpr CARD_TABLE directly. The CardBase objects and the lookups by
+     * name are built on first use, so they do not depend on the order of static initialisation.
+     */
     class CardFactory
     {
     public:
         using map_t = std::unordered_map<CardBase::id_t, std::unique_ptr<CardBase>>;
         using sorted_t = std::vector<CardBase::id_t>;
 
-        static void insert(const CardBase::id_t &card_id, CardType type, unsigned int cost);
-        static bool has(const CardBase::id_t &card_id) { return _map.count(card_id) > 0; }
+        static bool has(const CardBase::id_t &card_id) { return getCardId(card_id).valid(); }
 
-        static const map_t &getAll() { return _map; }
+        /**
+         * @brief Returns the interned id of the card, CardId::invalid() if there is no such card.
+         */
+        static CardId getCardId(const CardBase::id_t &card_id);
+        /**
+         * @brief Number of cards, all valid CardIds are smaller than this.
+         */
+        static constexpr size_t getCardCount() { return CARD_COUNT; }
+
+        static const map_t &getAll() { return storage().map; }
         static sorted_t getKingdomSortedByCost();
-        static const CardBase &getCard(const CardBase::id_t &card_id);
-        static unsigned int getCost(const CardBase::id_t &card_id);
-        static CardType getType(const CardBase::id_t &card_id);
-        static CardBase::id_t getId(const CardBase::id_t &card_id);
-
-        static bool isAction(const CardBase::id_t &card_id);
-        static bool isAttack(const CardBase::id_t &card_id);
-        static bool isReaction(const CardBase::id_t &card_id);
-        static bool isTreasure(const CardBase::id_t &card_id);
-        static bool isVictory(const CardBase::id_t &card_id);
-        static bool isCurse(const CardBase::id_t &card_id);
+        static const CardBase &getCard(CardId card_id);
+        static const CardDescriptor &getDescriptor(CardId card_id);
+        static unsigned int getCost(CardId card_id);
+        static CardType getType(CardId card_id);
+        static CardBase::id_t getId(CardId card_id);
+
+        static bool isAction(CardId card_id);
+        static bool isAttack(CardId card_id);
+        static bool isReaction(CardId card_id);
+        static bool isTreasure(CardId card_id);
+        static bool isVictory(CardId card_id);
+        static bool isCurse(CardId card_id);
 
     private:
-        static map_t _map;
+        struct Storage
+        {
+            map_t map;
+            // indexed by CardId::index()
+            std::vector<const CardBase *> cards;
+            std::unordered_map<CardBase::id_t, CardId> ids;
+        };
+
+        /**
+         * @brief Builds the CardBase objects from the CARD_TABLE the first time it is called.
+         */
+        static const Storage &storage();
+
+        static bool hasType(CardId card_id, CardType type) { return (CARD_TABLE[card_id.index()].type & type) == type; }
     };
 
 } // namespace shared
@@ -41,97 +72,109 @@ namespace shared
 // function implementations
 namespace shared
 {
-    inline void shared::CardFactory::insert(const shared::CardBase::id_t &card_id, shared::CardType type,
-                                            unsigned int cost)
+    inline shared::CardId shared::CardFactory::getCardId(const shared::CardBase::id_t &card_id)
+    {
+        const auto &ids = storage().ids;
+        auto it = ids.find(card_id);
+        return it != ids.end() ? it->second : CardId::invalid();
+    }
+
+    inline const shared::CardBase &shared::CardFactory::getCard(shared::CardId card_id)
     {
-        _map.emplace(card_id, std::make_unique<CardBase>(card_id, type, cost));
+        if ( !card_id.valid() ) {
+            throw std::out_of_range("card does not exist");
+        }
+        return *storage().cards[card_id.index()];
     }
 
-    inline const shared::CardBase &shared::CardFactory::getCard(const shared::CardBase::id_t &card_id)
+    inline const shared::CardDescriptor &shared::CardFactory::getDescriptor(shared::CardId card_id)
     {
-        return *_map.at(card_id).get();
+        if ( !card_id.valid() ) {
+            throw std::out_of_range("card does not exist");
+        }
+        return CARD_TABLE[card_id.index()];
     }
 
-    inline unsigned int shared::CardFactory::getCost(const shared::CardBase::id_t &card_id)
+    inline unsigned int shared::CardFactory::getCost(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to access card: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
 
-        return CardFactory::getCard(card_id).getCost();
+        return CARD_TABLE[card_id.index()].cost;
     }
 
-    inline shared::CardType shared::CardFactory::getType(const shared::CardBase::id_t &card_id)
+    inline shared::CardType shared::CardFactory::getType(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to access card type for: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).getType();
+        return CARD_TABLE[card_id.index()].type;
     }
 
-    inline shared::CardBase::id_t shared::CardFactory::getId(const shared::CardBase::id_t &card_id)
+    inline shared::CardBase::id_t shared::CardFactory::getId(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to access card ID for: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).getId();
+        return card_id.name();
     }
 
-    inline bool shared::CardFactory::isAction(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isAction(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is action: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isAction();
+        return hasType(card_id, CardType::ACTION);
     }
 
-    inline bool shared::CardFactory::isAttack(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isAttack(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is attack: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isAttack();
+        return hasType(card_id, CardType::ATTACK);
     }
 
-    inline bool shared::CardFactory::isReaction(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isReaction(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is reaction: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isReaction();
+        return hasType(card_id, CardType::REACTION);
     }
 
-    inline bool shared::CardFactory::isTreasure(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isTreasure(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is treasure: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isTreasure();
+        return hasType(card_id, CardType::TREASURE);
     }
 
-    inline bool shared::CardFactory::isVictory(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isVictory(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is victory: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isVictory();
+        return hasType(card_id, CardType::VICTORY);
     }
 
-    inline bool shared::CardFactory::isCurse(const shared::CardBase::id_t &card_id)
+    inline bool shared::CardFactory::isCurse(shared::CardId card_id)
     {
-        if ( !has(card_id) ) {
+        if ( !card_id.valid() ) {
             LOG(ERROR) << "Tried to check if card is curse: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+            throw std::invalid_argument("card_id: " + card_id.name() + " does not exist");
         }
-        return getCard(card_id).isCurse();
+        return hasType(card_id, CardType::CURSE);
     }
 
     inline shared::CardFactory::sorted_t shared::CardFactory::getKingdomSortedByCost()
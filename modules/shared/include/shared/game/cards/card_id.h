@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <shared/game/cards/card_table.h>
+
+namespace shared
+{
+    /**
+     * @brief Interned card identifier.
+     *
+     * A CardId is the position of the card in the CARD_TABLE. The game engine passes cards around as this index, so
+     * comparing, hashing and copying a card is as cheap as for a small integer. Card names are only needed at the JSON
+     * boundary, which is why a CardId converts implicitly from a name (e.g. a card_id received in a message) and back
+     * via name(). Card names that are known at compile time should use CardId::of, which does the lookup at compile
+     * time.
+     *
+     * Names that are not in the CARD_TABLE are mapped to CardId::invalid().
+     */
+    class CardId
+    {
+    public:
+        using index_t = uint8_t;
+
+        static constexpr index_t INVALID_INDEX = std::numeric_limits<index_t>::max();
+
+        constexpr CardId() = default;
+        CardId(const std::string &name);
+        CardId(const char *name);
+
+        static constexpr CardId fromIndex(index_t index)
+        {
+            CardId card_id;
+            card_id._index = index;
+            return card_id;
+        }
+        static constexpr CardId invalid() { return {}; }
+
+        /**
+         * @brief Looks up a card at compile time, does not compile if there is no such card.
+         */
+        static consteval CardId of(std::string_view name)
+        {
+            const auto index = findCardIndex(name);
+            if ( !index ) {
+                throw "unknown card name";
+            }
+            return fromIndex(static_cast<index_t>(*index));
+        }
+
+        constexpr index_t index() const { return _index; }
+        constexpr bool valid() const { return _index < CARD_COUNT; }
+
+        /**
+         * @brief The registered name of the card, or "<invalid card>" for CardId::invalid().
+         */
+        const std::string &name() const;
+
+        friend constexpr bool operator==(const CardId &lhs, const CardId &rhs) = default;
+        friend std::ostream &operator<<(std::ostream &os, const CardId &card_id) { return os << card_id.name(); }
+
+    private:
+        index_t _index = INVALID_INDEX;
+    };
+
+    static_assert(CARD_COUNT < CardId::INVALID_INDEX, "too many cards for CardId::index_t");
+} // namespace shared
+
+template <>
+struct std::hash<shared::CardId>
+{
+    size_t operator()(const shared::CardId &card_id) const noexcept { return card_id.index(); }
+};
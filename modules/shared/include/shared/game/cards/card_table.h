@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+
+#include <shared/game/cards/card_base.h>
+
+namespace shared
+{
+    /**
+     * @brief How many victory points a card is worth at the end of the game.
+     *
+     * A card is worth `points`, or if `per_n` is set, `points` for every `per_n` counted cards in the deck. Counted are
+     * the copies of `counted_card` if it is set, otherwise all cards whose type contains `counted_type` (0 counts
+     * every card).
+     */
+    struct VictoryRule
+    {
+        int points = 0;
+        unsigned int per_n = 0;
+        uint16_t counted_type = 0;
+        std::string_view counted_card = {};
+    };
+
+    /**
+     * @brief Everything that is known about a card at compile time.
+     */
+    struct CardDescriptor
+    {
+        std::string_view name;
+        CardType type;
+        unsigned int cost;
+        VictoryRule victory = {};
+    };
+
+// victory is optional
+#define CARD(card_id, card_type, card_cost, ...)                                                                       \
+    CardDescriptor { #card_id, static_cast<CardType>(card_type), card_cost, __VA_ARGS__ }
+
+    /**
+     * @brief All cards of the game. The position of a card in this table is its CardId.
+     */
+    inline constexpr CardDescriptor CARD_TABLE[] = {
+            /*
+            SUPPLY CARDS
+             */
+
+            // treasure
+            CARD(Copper, CardType::TREASURE, 0),
+            CARD(Silver, CardType::TREASURE, 3),
+            CARD(Gold, CardType::TREASURE, 6),
+
+            // victory
+            CARD(Estate, CardType::VICTORY, 2, {.points = 1}),
+            CARD(Duchy, CardType::VICTORY, 5, {.points = 3}),
+            CARD(Province, CardType::VICTORY, 8, {.points = 6}),
+
+            // curse
+            CARD(Curse, CardType::CURSE, 0, {.points = -1}),
+
+            /*
+            KINGDOM CARDS
+            */
+
+            // CARD(Merchant, CardType::ACTION, 3), // conditional effect, how?
+            // CARD(Throne_Room, CardType::ACTION, 4), // how do we keep this active?
+
+            // God Mode (for testing only)
+            CARD(God_Mode, CardType::ACTION, 0),
+
+            // non-interactive
+            CARD(Village, CardType::ACTION, 3),
+            CARD(Smithy, CardType::ACTION, 4),
+            CARD(Festival, CardType::ACTION, 5),
+            CARD(Market, CardType::ACTION, 5),
+            CARD(Laboratory, CardType::ACTION, 5),
+            CARD(Council_Room, CardType::ACTION, 5),
+            CARD(Witch, CardType::ACTION | CardType::ATTACK, 5),
+            CARD(Workers_Village, CardType::ACTION, 4),
+            CARD(Great_Hall, CardType::ACTION | CardType::VICTORY, 3, {.points = 1}),
+            CARD(Treasure_Map, CardType::ACTION, 4),
+            CARD(Sea_Hag, CardType::ACTION | CardType::ATTACK, 4),
+
+            // victory cards
+            CARD(Gardens, CardType::KINGDOM | CardType::VICTORY, 4, {.points = 1, .per_n = 10}),
+            CARD(Duke, CardType::KINGDOM | CardType::VICTORY, 5, {.points = 1, .per_n = 1, .counted_card = "Duchy"}),
+            CARD(Silk_Road, CardType::KINGDOM | CardType::VICTORY, 4,
+                 {.points = 1, .per_n = 4, .counted_type = CardType::VICTORY}),
+
+            // treasure cards
+            CARD(Treasure_Trove, CardType::KINGDOM | CardType::TREASURE, 5),
+
+            // reaction cards
+            CARD(Moat, CardType::ACTION | CardType::REACTION, 2),
+
+            // interactive
+            CARD(Remodel, CardType::ACTION, 4),
+            CARD(Poacher, CardType::ACTION, 4),
+            CARD(Moneylender, CardType::ACTION, 4),
+            CARD(Mine, CardType::ACTION, 5),
+            CARD(Artisan, CardType::ACTION, 6),
+            CARD(Cellar, CardType::ACTION, 2),
+            CARD(Chapel, CardType::ACTION, 2),
+            CARD(Workshop, CardType::ACTION, 3),
+            // CARD(Vassal, CardType::ACTION, 3),
+            // CARD(Harbinger, CardType::ACTION, 3),
+            CARD(Militia, CardType::ACTION | CardType::ATTACK, 4),
+            // CARD(Bureaucrat, CardType::ACTION | CardType::ATTACK, 4),
+            // CARD(Sentry, CardType::ACTION, 5),
+            // CARD(Library, CardType::ACTION, 5),
+            // CARD(Bandit, CardType::ACTION | CardType::ATTACK, 5),
+    };
+
+#undef CARD
+
+    inline constexpr size_t CARD_COUNT = std::size(CARD_TABLE);
+
+    /**
+     * @brief Linear search for a card in the CARD_TABLE, meant for constant evaluation (see CardId::of).
+     */
+    constexpr std::optional<size_t> findCardIndex(std::string_view name)
+    {
+        for ( size_t i = 0; i < CARD_COUNT; ++i ) {
+            if ( CARD_TABLE[i].name == name ) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+} // namespace shared
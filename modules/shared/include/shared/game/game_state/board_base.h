@@ -1,14 +1,19 @@
 
 #pragma once
 
-#include <set>
+#include <array>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
 #include <shared/game/cards/card_factory.h>
+#include <shared/game/cards/card_id.h>
 #include <shared/utils/assert.h>
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 namespace shared
 {
@@ -46,7 +51,7 @@ namespace shared
     struct Pile
     {
         shared::CardBase::id_t card_id;
-        mutable size_t count; // `mutable` allows modification const contexts
+        size_t count;
 
         /**
          * @brief Creates a new card pile with size the given size
@@ -60,6 +65,7 @@ namespace shared
         bool operator!=(const Pile &other) const;
 
         rapidjson::Document toJson() const;
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         static std::unique_ptr<Pile> fromJson(const rapidjson::Value &json);
 
         /**
@@ -71,30 +77,6 @@ namespace shared
         static Pile makeKingdomCard(const shared::CardBase::id_t &kingdom_card_id);
 
         bool empty() const { return count == 0; }
-
-        struct PileComparator
-        {
-            using is_transparent = void; // enables heterogeneous lookup
-
-            inline bool operator()(const Pile &a, const Pile &b) const
-            {
-                return (CardFactory::getCost(a.card_id) < CardFactory::getCost(b.card_id)) ||
-                        ((CardFactory::getCost(a.card_id) == CardFactory::getCost(b.card_id)) &&
-                         (a.card_id < b.card_id));
-            }
-
-            inline bool operator()(const Pile &a, const shared::CardBase::id_t &key) const
-            {
-                return (CardFactory::getCost(a.card_id) < CardFactory::getCost(key)) ||
-                        ((CardFactory::getCost(a.card_id) == CardFactory::getCost(key)) && (a.card_id < key));
-            }
-
-            inline bool operator()(const shared::CardBase::id_t &key, const Pile &b) const
-            {
-                return (CardFactory::getCost(key) < CardFactory::getCost(b.card_id)) ||
-                        ((CardFactory::getCost(key) == CardFactory::getCost(b.card_id)) && (key < b.card_id));
-            }
-        };
     };
 
     class Board
@@ -105,7 +87,10 @@ namespace shared
          * have exactly the same contents. This way we dont copy the contents each time we create a message.
          */
         using ptr_t = std::shared_ptr<Board>;
-        using pile_container_t = std::set<Pile, Pile::PileComparator>;
+        /**
+         * @brief A group of supply piles, ordered by cost and then by name.
+         */
+        using pile_container_t = std::span<const Pile>;
 
         /**
          * @brief Constructs a shared_ptr on a ServerBoard for a given number of players and 10 kingdom cards.
@@ -119,6 +104,10 @@ namespace shared
         bool operator!=(const Board &other) const;
 
         rapidjson::Document toJson() const;
+        /**
+         * @brief Same JSON as toJson(), but written straight to `writer`.
+         */
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         static ptr_t fromJson(const rapidjson::Value &json);
 
         virtual ~Board() = default;
@@ -127,25 +116,55 @@ namespace shared
         Board(Board &&) noexcept = default;
         Board &operator=(Board &&) noexcept = default;
 
-        // disable copy constructor and assignment
-        Board(const Board &) = delete;
+        // disable copy assignment, copies have to be asked for (see ServerBoard::clone())
         Board &operator=(const Board &) = delete;
 
-        bool isGameOver() const;
-        size_t getEmptyPilesCount() const;
+        /**
+         * @brief If the Province pile or board_config::MAX_NUM_EMPTY_PILES supply piles are empty.
+         */
+        virtual bool isGameOver() const;
+        virtual size_t getEmptyPilesCount() const;
 
-        pile_container_t &getVictoryCards() { return victory_cards; }
-        pile_container_t &getTreasureCards() { return treasure_cards; }
-        pile_container_t &getKingdomCards() { return kingdom_cards; }
-        Pile &getCurseCardPile() { return curse_card_pile; }
+        pile_container_t getVictoryCards() const { return getPiles(0, treasure_begin); }
+        pile_container_t getTreasureCards() const { return getPiles(treasure_begin, kingdom_begin); }
+        pile_container_t getKingdomCards() const { return getPiles(kingdom_begin, curse_slot); }
+        const Pile &getCurseCardPile() const { return piles[curse_slot]; }
         auto &getPlayedCards() { return played_cards; }
 
+        /**
+         * @brief Returns the supply pile of the card, nullptr if the card is not in the supply.
+         */
+        const Pile *getPile(CardId card_id) const
+        {
+            if ( !card_id.valid() || pile_slots[card_id.index()] == NO_SLOT ) {
+                return nullptr;
+            }
+            return &piles[pile_slots[card_id.index()]];
+        }
+
+        /**
+         * @brief Sets the number of cards left in the supply pile of the card, does nothing if the card is not in the
+         * supply.
+         * @warning Only meant to set up a position, e.g. in tests. During a game the supply changes through
+         * ServerBoard::tryTake().
+         */
+        virtual void setPileCount(CardId card_id, size_t count);
 
     protected:
-        pile_container_t victory_cards;
-        pile_container_t treasure_cards;
-        pile_container_t kingdom_cards;
-        Pile curse_card_pile;
+        Board(const Board &) = default;
+
+        static constexpr uint8_t NO_SLOT = std::numeric_limits<uint8_t>::max();
+
+        /**
+         * @brief All supply piles in one array: the victory, treasure and kingdom piles (each ordered by cost, then by
+         * name) followed by the curse pile. The array is never resized after construction.
+         */
+        std::vector<Pile> piles;
+        // position of the pile of each card in `piles`, indexed by CardId::index()
+        std::array<uint8_t, CARD_COUNT> pile_slots;
+        size_t treasure_begin;
+        size_t kingdom_begin;
+        size_t curse_slot;
         std::vector<shared::CardBase::id_t> trash;
 
         std::vector<shared::CardBase::id_t> played_cards;
@@ -170,7 +189,7 @@ namespace shared
          *
          * @param player_count
          */
-        static pile_container_t initialiseTreasureCards(size_t player_count);
+        static std::vector<Pile> initialiseTreasureCards(size_t player_count);
 
         /**
          * @brief Initialised the victory cards as follows:
@@ -181,7 +200,7 @@ namespace shared
          *
          * @param player_count
          */
-        static pile_container_t initialiseVictoryCards(size_t player_count);
+        static std::vector<Pile> initialiseVictoryCards(size_t player_count);
 
         /**
          * @brief Initialises the curse pile as:
@@ -193,13 +212,11 @@ namespace shared
         static Pile initialiseCursePile(size_t player_count);
 
     private:
-        Board(pile_container_t victory_cards, pile_container_t treasure_cards, pile_container_t kingdom_cards,
+        Board(std::vector<Pile> victory_cards, std::vector<Pile> treasure_cards, std::vector<Pile> kingdom_cards,
               Pile curse_card_pile, std::vector<shared::CardBase::id_t> trash,
-              std::vector<shared::CardBase::id_t> played_cards) :
-            victory_cards(victory_cards),
-            treasure_cards(treasure_cards), kingdom_cards(kingdom_cards), curse_card_pile(curse_card_pile),
-            trash(trash), played_cards(played_cards)
-        {}
+              std::vector<shared::CardBase::id_t> played_cards);
+
+        pile_container_t getPiles(size_t begin, size_t end) const { return {piles.data() + begin, end - begin}; }
     };
 
 } // namespace shared
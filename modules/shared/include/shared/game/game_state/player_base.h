@@ -8,6 +8,8 @@
 #include <memory>
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <shared/game/cards/card_base.h>
 
 namespace shared
@@ -29,6 +31,8 @@ namespace shared
     {
     public:
         using id_t = std::string;
+        // the place of a player in the order of the game, the first player sits at 0
+        using seat_t = size_t;
 
         PlayerBase(id_t player_id);
         PlayerBase(const PlayerBase &other);
@@ -83,6 +87,10 @@ namespace shared
          * @brief Convert the player to a `rapidjson::Document` JSON object.
          */
         rapidjson::Document toJson() const;
+        /**
+         * @brief Write the members of toJson() to `writer`, the derived players write the object around them.
+         */
+        void writeJsonMembers(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         /**
          * @brief Initialize a player from a `rapidjson::Value` JSON object.
          */
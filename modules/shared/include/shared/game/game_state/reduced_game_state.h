@@ -34,6 +34,10 @@ namespace reduced
          * @brief Serialize the GameState to a JSON object.
          */
         rapidjson::Document toJson() const;
+        /**
+         * @brief Serialize the GameState straight to `writer`, the output is the same as the one of toJson().
+         */
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         /**
          * @brief Deserialize a GameState from a JSON object.
          */
@@ -11,9 +11,11 @@ namespace reduced
 
         static ptr_t make(const PlayerBase &player, unsigned int hand_size);
 
+        Enemy(const Enemy &other) = default;
         Enemy(Enemy &&other) noexcept : PlayerBase(std::move(other)), hand_size(other.hand_size) {}
 
         rapidjson::Document toJson() const;
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         static std::unique_ptr<Enemy> fromJson(const rapidjson::Value &json);
 
         unsigned int getHandSize() const;
@@ -30,10 +32,12 @@ namespace reduced
 
         static ptr_t make(const shared::PlayerBase &player, std::vector<shared::CardBase::id_t> hand_cards);
 
+        Player(const Player &other) = default;
         Player(Player &&other) noexcept : shared::PlayerBase(std::move(other)), hand_cards(std::move(other.hand_cards))
         {}
 
         rapidjson::Document toJson() const;
+        void writeJson(rapidjson::Writer<rapidjson::StringBuffer> &writer) const;
         static std::unique_ptr<Player> fromJson(const rapidjson::Value &json);
 
         const std::vector<shared::CardBase::id_t> &getHandCards() const;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -14,6 +15,27 @@
 
 namespace shared
 {
+    /**
+     * @brief Which subclass a Message is. Every message class passes its KIND to the base constructor, so the tag is
+     * set as soon as a message is created or parsed and messages can be dispatched with a switch.
+     */
+    enum class MessageKind : uint8_t
+    {
+        // client -> server
+        GAME_STATE_REQUEST,
+        CREATE_LOBBY_REQUEST,
+        JOIN_LOBBY_REQUEST,
+        START_GAME_REQUEST,
+        ACTION_DECISION,
+        // server -> client
+        GAME_STATE,
+        CREATE_LOBBY_RESPONSE,
+        JOIN_LOBBY_BROADCAST,
+        START_GAME_BROADCAST,
+        END_GAME_BROADCAST,
+        RESULT_RESPONSE,
+        ACTION_ORDER,
+    };
 
     class Message
     {
@@ -21,16 +43,32 @@ namespace shared
         virtual ~Message() = default;
         virtual std::string toJson() const = 0;
 
+        MessageKind getKind() const { return kind; }
+
         std::string game_id;
         std::string message_id;
 
     protected:
-        Message(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            game_id(game_id), message_id(message_id)
+        Message(MessageKind kind, std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
+            game_id(game_id), message_id(message_id), kind(kind)
         {}
         bool operator==(const Message &other) const;
+
+    private:
+        MessageKind kind;
     };
 
+    /**
+     * @brief Downcast checked by the kind tag instead of RTTI.
+     * @return nullptr if message is nullptr or of another type
+     */
+    template <typename MessageType, typename BaseType>
+    MessageType *messageCast(BaseType *message)
+    {
+        return message != nullptr && message->getKind() == MessageType::KIND ? static_cast<MessageType *>(message)
+                                                                              : nullptr;
+    }
+
     /* ======= client -> server ======= */
 
     class ClientToServerMessage : public Message
@@ -43,9 +81,9 @@ namespace shared
         PlayerBase::id_t player_id;
 
     protected:
-        ClientToServerMessage(std::string game_id, PlayerBase::id_t player_id,
+        ClientToServerMessage(MessageKind kind, std::string game_id, PlayerBase::id_t player_id,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            Message(game_id, message_id),
+            Message(kind, game_id, message_id),
             player_id(player_id)
         {}
         bool operator==(const ClientToServerMessage &other) const;
@@ -54,9 +92,11 @@ namespace shared
     class GameStateRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::GAME_STATE_REQUEST;
+
         GameStateRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(KIND, game_id, player_id, message_id)
         {}
         ~GameStateRequestMessage() override = default;
         std::string toJson() const override;
@@ -66,9 +106,11 @@ namespace shared
     class CreateLobbyRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::CREATE_LOBBY_REQUEST;
+
         CreateLobbyRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                   std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(KIND, game_id, player_id, message_id)
         {}
         ~CreateLobbyRequestMessage() override = default;
         std::string toJson() const override;
@@ -78,10 +120,12 @@ namespace shared
     class JoinLobbyRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::JOIN_LOBBY_REQUEST;
+
         ~JoinLobbyRequestMessage() override = default;
         JoinLobbyRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(KIND, game_id, player_id, message_id)
         {}
         std::string toJson() const override;
         bool operator==(const JoinLobbyRequestMessage &other) const;
@@ -90,6 +134,8 @@ namespace shared
     class StartGameRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::START_GAME_REQUEST;
+
         ~StartGameRequestMessage() override = default;
         /**
          * @param selected_cards The 10 cards selected by the game master to play with.
@@ -107,11 +153,13 @@ namespace shared
     class ActionDecisionMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::ACTION_DECISION;
+
         ~ActionDecisionMessage() override = default;
         ActionDecisionMessage(std::string game_id, PlayerBase::id_t player_id, std::unique_ptr<ActionDecision> decision,
                               std::optional<std::string> in_response_to = std::nullopt,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id),
+            ClientToServerMessage(KIND, game_id, player_id, message_id),
             decision(std::move(decision)), in_response_to(in_response_to)
         {}
         std::string toJson() const override;
@@ -136,8 +184,9 @@ namespace shared
         static std::unique_ptr<ServerToClientMessage> fromJson(const std::string &json);
 
     protected:
-        ServerToClientMessage(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            Message(game_id, message_id)
+        ServerToClientMessage(MessageKind kind, std::string game_id,
+                              std::string message_id = UuidGenerator::generateUuidV4()) :
+            Message(kind, game_id, message_id)
         {}
         bool operator==(const ServerToClientMessage &other) const;
     };
@@ -145,12 +194,14 @@ namespace shared
     class GameStateMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::GAME_STATE;
+
         ~GameStateMessage() override = default;
         GameStateMessage(std::string game_id, std::unique_ptr<reduced::GameState> game_state,
                          std::optional<std::string> in_response_to = std::nullopt,
                          std::string message_id = UuidGenerator::generateUuidV4()) :
 
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(KIND, game_id, message_id),
             game_state(std::move(game_state)), in_response_to(in_response_to)
         {}
         std::string toJson() const override;
@@ -163,10 +214,12 @@ namespace shared
     class CreateLobbyResponseMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::CREATE_LOBBY_RESPONSE;
+
         ~CreateLobbyResponseMessage() override = default;
         CreateLobbyResponseMessage(std::string game_id, std::optional<std::string> in_response_to = std::nullopt,
                                    std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(KIND, game_id, message_id),
             in_response_to(in_response_to)
         {}
         std::string toJson() const override;
@@ -179,10 +232,12 @@ namespace shared
     class JoinLobbyBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::JOIN_LOBBY_BROADCAST;
+
         ~JoinLobbyBroadcastMessage() override = default;
         JoinLobbyBroadcastMessage(std::string game_id, std::vector<shared::PlayerBase::id_t> players,
                                   std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(KIND, game_id, message_id),
             players(players)
         {}
         std::string toJson() const override;
@@ -193,9 +248,11 @@ namespace shared
     class StartGameBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::START_GAME_BROADCAST;
+
         ~StartGameBroadcastMessage() override = default;
         StartGameBroadcastMessage(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id)
+            ServerToClientMessage(KIND, game_id, message_id)
         {}
         std::string toJson() const override;
         bool operator==(const StartGameBroadcastMessage &other) const;
@@ -204,10 +261,12 @@ namespace shared
     class EndGameBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::END_GAME_BROADCAST;
+
         ~EndGameBroadcastMessage() override = default;
         EndGameBroadcastMessage(std::string game_id, std::vector<PlayerResult> results,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(KIND, game_id, message_id),
             results(results)
         {}
         std::string toJson() const override;
@@ -222,12 +281,14 @@ namespace shared
     class ResultResponseMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::RESULT_RESPONSE;
+
         ~ResultResponseMessage() override = default;
         ResultResponseMessage(std::string game_id, bool success,
                               std::optional<std::string> in_response_to = std::nullopt,
                               std::optional<std::string> additional_information = std::nullopt,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(KIND, game_id, message_id),
             success(success), in_response_to(in_response_to), additional_information(additional_information)
         {}
         std::string toJson() const override;
@@ -241,12 +302,14 @@ namespace shared
     class ActionOrderMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageKind KIND = MessageKind::ACTION_ORDER;
+
         ~ActionOrderMessage() override = default;
         ActionOrderMessage(std::string game_id, std::unique_ptr<ActionOrder> order,
                            std::unique_ptr<reduced::GameState> game_state,
                            std::optional<std::string> description = std::nullopt,
                            std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(std::move(game_id), std::move(message_id)),
+            ServerToClientMessage(KIND, std::move(game_id), std::move(message_id)),
             order(std::move(order)), game_state(std::move(game_state)), description(std::move(description))
         {}
 
@@ -85,6 +85,7 @@ NEW_BASE_EXCEPTION(Logger, "Exception in the Logger");
 // for gamestate
 NEW_BASE_EXCEPTION(GameState, "GameStateError");
 NEW_INHERITED_EXCEPTION(PlayerCountMismatch, GameState, "Wrong number of players.");
+NEW_INHERITED_EXCEPTION(InvalidSnapshot, GameState, "Invalid game snapshot.");
 NEW_INHERITED_EXCEPTION(InsufficientFunds, GameState, "You don not have enough funds.");
 NEW_INHERITED_EXCEPTION(CardNotAvailable, GameState, "Chosen card is not available.");
 NEW_INHERITED_EXCEPTION(WrongCardCount, GameState, "Received wrong number of cards.");
@@ -95,6 +96,10 @@ NEW_INHERITED_EXCEPTION(InvalidCardAccess, GameState, "");
 NEW_INHERITED_EXCEPTION(InvalidCardType, GameState, "");
 NEW_INHERITED_EXCEPTION(InvalidRequest, GameState, "");
 
+// for the network layer
+NEW_BASE_EXCEPTION(Network, "Network error");
+NEW_INHERITED_EXCEPTION(MalformedFrame, Network, "Malformed frame header");
+
 NEW_BASE_EXCEPTION(SevereError, "Severe Error!");
 NEW_INHERITED_EXCEPTION(UnreachableCode, SevereError, "This should NEVER happen!");
 NEW_INHERITED_EXCEPTION(UnrecoverableError, SevereError, "This is not recoverable, shutting down!");
\ No newline at end of file
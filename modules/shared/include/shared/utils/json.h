@@ -2,6 +2,8 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <shared/utils/logger.h>
 
 
@@ -155,4 +157,80 @@
     doc.AddMember(#key, key##_array, doc.GetAllocator());
 
 
+// ======= WRITER MACROS ======= //
+// Same members and output as the setter macros, but written straight to `writer` without building a Document.
+
+
+#define WRITE_STRING_MEMBER(var, key)                                                                                  \
+    writer.Key(#key);                                                                                                  \
+    writer.String(var);
+
+#define WRITE_UINT_MEMBER(var, key)                                                                                    \
+    writer.Key(#key);                                                                                                  \
+    writer.Uint(var);
+
+#define WRITE_ENUM_MEMBER(var, key)                                                                                    \
+    writer.Key(#key);                                                                                                  \
+    writer.Uint(static_cast<unsigned int>(var));
+
+#define WRITE_OPTIONAL_STRING_MEMBER(var, key)                                                                         \
+    if ( var ) {                                                                                                       \
+        writer.Key(#key);                                                                                              \
+        writer.String((var).value().c_str());                                                                          \
+    }
+
+#define WRITE_BOOL_MEMBER(var, key)                                                                                    \
+    writer.Key(#key);                                                                                                  \
+    writer.Bool(var);
+
+#define WRITE_ARRAY_OF_STRINGS_MEMBER(var, key)                                                                        \
+    writer.Key(#key);                                                                                                  \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        writer.String(item.c_str());                                                                                   \
+    }                                                                                                                  \
+    writer.EndArray();
+
+#define WRITE_ARRAY_OF_UINTS_MEMBER(var, key)                                                                          \
+    writer.Key(#key);                                                                                                  \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        writer.Uint(item);                                                                                             \
+    }                                                                                                                  \
+    writer.EndArray();
+
+#define WRITE_ARRAY_OF_ENUMS_MEMBER(var, key, type)                                                                    \
+    writer.Key(#key);                                                                                                  \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        writer.Uint(static_cast<type>(item));                                                                          \
+    }                                                                                                                  \
+    writer.EndArray();
+
+
+using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
 std::string documentToString(const rapidjson::Document &doc);
+
+/**
+ * @brief The writer of the calling thread, reset onto its emptied buffer. Use writeToString() instead.
+ */
+JsonWriter &threadWriter();
+
+/**
+ * @brief What the writer of the calling thread wrote since threadWriter() was called.
+ */
+std::string threadWriterOutput();
+
+/**
+ * @brief Calls write with a writer and returns what it wrote.
+ *
+ * The buffer and the writer are kept per thread and reused (see threadWriter()), so after the first few messages
+ * writing one only allocates the returned string. write must not call writeToString itself.
+ */
+template <typename WriteFunction>
+std::string writeToString(WriteFunction &&write)
+{
+    write(threadWriter());
+    return threadWriterOutput();
+}
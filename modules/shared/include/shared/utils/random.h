@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace shared
+{
+    /**
+     * @brief The splitmix64 finalizer: a fixed, well mixed 64 bit value for every input.
+     */
+    constexpr uint64_t splitmix64(uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief xoshiro256** by David Blackman and Sebastiano Vigna (https://prng.di.unimi.it/).
+     *
+     * Much faster than std::mt19937 and only 32 bytes of state, so every game (and every player) can have its own
+     * generator. The same seed always gives the same numbers, which makes games replayable.
+     * Satisfies UniformRandomBitGenerator, so it can be used with std::shuffle and the std distributions.
+     */
+    class Xoshiro256
+    {
+    public:
+        using result_type = uint64_t;
+        using state_t = std::array<uint64_t, 4>;
+
+        explicit Xoshiro256(uint64_t seed)
+        {
+            // the state is filled with splitmix64, as recommended by the authors
+            for ( auto &word : state ) {
+                word = splitmix64(seed);
+                seed += 0x9e3779b97f4a7c15;
+            }
+        }
+
+        /**
+         * @brief Continues where the generator that getState() was called on stopped.
+         */
+        static Xoshiro256 fromState(const state_t &state)
+        {
+            Xoshiro256 generator(0);
+            generator.state = state;
+            return generator;
+        }
+
+        const state_t &getState() const { return state; }
+
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()()
+        {
+            const uint64_t result = std::rotl(state[1] * 5, 7) * 9;
+            const uint64_t t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = std::rotl(state[3], 45);
+
+            return result;
+        }
+
+        bool operator==(const Xoshiro256 &other) const = default;
+
+    private:
+        state_t state;
+    };
+
+    /**
+     * @brief A fresh seed from std::random_device, e.g. for a new game.
+     */
+    inline uint64_t randomSeed()
+    {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }
+} // namespace shared
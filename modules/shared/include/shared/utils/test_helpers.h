@@ -13,9 +13,9 @@
 std::vector<shared::CardBase::id_t> getValidKingdomCards();
 
 /**
- * @brief Set the count of min(n, pile_container.size()) piles to empty.
+ * @brief Set the count of min(n, pile_container.size()) piles of the board to empty.
  */
-void setNPilesToEmpty(shared::Board::pile_container_t &pile_container, size_t n);
+void setNPilesToEmpty(shared::Board &board, shared::Board::pile_container_t pile_container, size_t n);
 
 namespace test_helper
 {
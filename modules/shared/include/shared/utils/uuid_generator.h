@@ -8,6 +8,8 @@
 #include <random>
 #include <sstream>
 
+#include <shared/utils/random.h>
+
 class UuidGenerator
 {
 
@@ -15,11 +17,10 @@ private:
 public:
     static std::string generateUuidV4()
     {
-        // made those static to not seed a new engine for every call
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<int> hexDist(0, 15);
-        static std::uniform_int_distribution<int> variantDist(8, 11);
+        // one engine per thread, seeded once, so threads do not race on a shared engine
+        thread_local shared::Xoshiro256 gen(shared::randomSeed());
+        std::uniform_int_distribution<int> hexDist(0, 15);
+        std::uniform_int_distribution<int> variantDist(8, 11);
 
         // stuff below is by chatgpt
         std::array<int, 16> uuidData;
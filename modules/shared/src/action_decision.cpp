@@ -1,12 +1,11 @@
 
 #include <shared/action_decision.h>
-#include <typeinfo>
 
 namespace shared
 {
     bool ActionDecision::operator==(const ActionDecision &other) const
     {
-        return typeid(*this) == typeid(other) && equals(other);
+        return kind == other.kind && equals(other);
     }
 
     bool ActionDecision::operator!=(const ActionDecision &other) const { return !ActionDecision::operator==(other); }
@@ -18,28 +17,28 @@ namespace shared
 
     bool PlayActionCardDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const PlayActionCardDecision &>(other);
+        return *this == static_cast<const PlayActionCardDecision &>(other);
     }
 
     bool BuyCardDecision::operator==(const BuyCardDecision &other) const { return this->card == other.card; }
 
     bool BuyCardDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const BuyCardDecision &>(other);
+        return *this == static_cast<const BuyCardDecision &>(other);
     }
 
     bool EndActionPhaseDecision::operator==(const EndActionPhaseDecision & /*other*/) const { return true; }
 
     bool EndActionPhaseDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const EndActionPhaseDecision &>(other);
+        return *this == static_cast<const EndActionPhaseDecision &>(other);
     }
 
     bool EndTurnDecision::operator==(const EndTurnDecision & /*other*/) const { return true; }
 
     bool EndTurnDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const EndTurnDecision &>(other);
+        return *this == static_cast<const EndTurnDecision &>(other);
     }
 
 
@@ -57,7 +56,7 @@ namespace shared
 
     bool DeckChoiceDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const DeckChoiceDecision &>(other);
+        return *this == static_cast<const DeckChoiceDecision &>(other);
     }
 
     bool GainFromBoardDecision::operator==(const GainFromBoardDecision &other) const
@@ -72,6 +71,6 @@ namespace shared
 
     bool GainFromBoardDecision::equals(const ActionDecision &other) const
     {
-        return *this == dynamic_cast<const GainFromBoardDecision &>(other);
+        return *this == static_cast<const GainFromBoardDecision &>(other);
     }
 } // namespace shared
@@ -81,6 +81,37 @@ namespace shared
         return doc;
     }
 
+    void ActionOrder::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        if ( typeid(*this) == typeid(ActionPhaseOrder) ) {
+            WRITE_STRING_MEMBER("action_phase", type);
+        } else if ( typeid(*this) == typeid(BuyPhaseOrder) ) {
+            WRITE_STRING_MEMBER("buy_phase", type);
+        } else if ( typeid(*this) == typeid(GainFromBoardOrder) ) {
+            const auto *order = static_cast<const GainFromBoardOrder *>(this);
+            WRITE_STRING_MEMBER("gain_card", type);
+            WRITE_UINT_MEMBER(order->max_cost, max_cost);
+            WRITE_ENUM_MEMBER(order->allowed_type, allowed_type);
+        } else if ( typeid(*this) == typeid(ChooseFromHandOrder) ) {
+            const auto *order = static_cast<const ChooseFromHandOrder *>(this);
+            WRITE_STRING_MEMBER("choose_from_hand", type);
+            WRITE_UINT_MEMBER(order->min_cards, min_cards);
+            WRITE_UINT_MEMBER(order->max_cards, max_cards);
+            WRITE_ENUM_MEMBER(order->allowed_choices, allowed_choices);
+            WRITE_ENUM_MEMBER(order->allowed_type, allowed_type);
+        } else if ( typeid(*this) == typeid(ChooseFromStagedOrder) ) {
+            const auto *order = static_cast<const ChooseFromStagedOrder *>(this);
+            WRITE_STRING_MEMBER("choose_from_staged", type);
+            WRITE_UINT_MEMBER(order->min_cards, min_cards);
+            WRITE_UINT_MEMBER(order->max_cards, max_cards);
+            WRITE_ENUM_MEMBER(order->allowed_choices, allowed_choices);
+            WRITE_ARRAY_OF_STRINGS_MEMBER(order->cards, cards);
+            WRITE_ENUM_MEMBER(order->allowed_type, allowed_type);
+        }
+        writer.EndObject();
+    }
+
     bool ActionPhaseOrder::operator==(const ActionPhaseOrder & /* other */) const { return true; }
 
     bool ActionPhaseOrder::operator!=(const ActionPhaseOrder &other) const
@@ -1,6 +1,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <utility>
 
 #include <rapidjson/document.h>
 #include <shared/game/game_state/board_base.h>
@@ -36,9 +37,25 @@ namespace shared
         return doc;
     }
 
+    void Pile::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_STRING_MEMBER(this->card_id.c_str(), card_id);
+        WRITE_UINT_MEMBER(this->count, count);
+        writer.EndObject();
+    }
+
     Board::Board(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count) :
-        victory_cards(initialiseVictoryCards(player_count)), treasure_cards(initialiseTreasureCards(player_count)),
-        curse_card_pile(initialiseCursePile(player_count))
+        Board(initialiseVictoryCards(player_count), initialiseTreasureCards(player_count),
+              [&kingdom_cards]()
+              {
+                  std::vector<Pile> kingdom_piles;
+                  kingdom_piles.reserve(kingdom_cards.size());
+                  std::transform(kingdom_cards.begin(), kingdom_cards.end(), std::back_inserter(kingdom_piles),
+                                 [](const shared::CardBase::id_t &card_id) { return Pile::makeKingdomCard(card_id); });
+                  return kingdom_piles;
+              }(),
+              initialiseCursePile(player_count), {}, {})
     {
         _ASSERT_TRUE(board_config::validatePlayerCount(player_count),
                      std::string_view{"player_count must be in [" + std::to_string(board_config::MIN_PLAYER_COUNT) +
@@ -49,12 +66,44 @@ namespace shared
                    std::string_view{"Board must be initialised with 10 kingdom cards, but was initialised with " +
                                     std::to_string(kingdom_cards.size()) + " cards"});
 
-        std::transform(kingdom_cards.begin(), kingdom_cards.end(),
-                       std::inserter(this->kingdom_cards, this->kingdom_cards.end()),
-                       [](const shared::CardBase::id_t &card_id) { return Pile::makeKingdomCard(card_id); });
+        // the kingdom piles are sorted, so duplicates are next to each other
+        const auto kingdom_piles = getKingdomCards();
+        const bool has_duplicates =
+                std::adjacent_find(kingdom_piles.begin(), kingdom_piles.end(), [](const Pile &a, const Pile &b)
+                                   { return a.card_id == b.card_id; }) != kingdom_piles.end();
+        _ASSERT_FALSE(has_duplicates, std::string_view{"Board received duplicate kingdom card"});
+    }
 
-        _ASSERT_EQ(this->kingdom_cards.size(), board_config::KINGDOM_CARD_COUNT,
-                   std::string_view{"Board received duplicate kingdom card"});
+    Board::Board(std::vector<Pile> victory_cards, std::vector<Pile> treasure_cards, std::vector<Pile> kingdom_cards,
+                 Pile curse_card_pile, std::vector<shared::CardBase::id_t> trash,
+                 std::vector<shared::CardBase::id_t> played_cards) :
+        treasure_begin(victory_cards.size()),
+        kingdom_begin(treasure_begin + treasure_cards.size()), curse_slot(kingdom_begin + kingdom_cards.size()),
+        trash(std::move(trash)), played_cards(std::move(played_cards))
+    {
+        auto by_cost = [](const Pile &a, const Pile &b)
+        {
+            const auto cost_a = CardFactory::getCost(a.card_id);
+            const auto cost_b = CardFactory::getCost(b.card_id);
+            return cost_a < cost_b || (cost_a == cost_b && a.card_id < b.card_id);
+        };
+
+        piles.reserve(curse_slot + 1);
+        for ( auto *group : {&victory_cards, &treasure_cards, &kingdom_cards} ) {
+            std::sort(group->begin(), group->end(), by_cost);
+            piles.insert(piles.end(), group->begin(), group->end());
+        }
+        piles.push_back(std::move(curse_card_pile));
+        _ASSERT_LT(piles.size(), size_t{NO_SLOT}, "too many supply piles");
+
+        pile_slots.fill(NO_SLOT);
+        // if a card has more than one pile, the first one is used
+        for ( size_t slot = piles.size(); slot-- > 0; ) {
+            const CardId card_id = piles[slot].card_id;
+            if ( card_id.valid() ) {
+                pile_slots[card_id.index()] = static_cast<uint8_t>(slot);
+            }
+        }
     }
 
     Board::ptr_t Board::make(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count)
@@ -64,25 +113,24 @@ namespace shared
 
     bool Board::operator==(const Board &other) const
     {
-        return other.victory_cards == victory_cards && other.treasure_cards == treasure_cards &&
-                other.kingdom_cards == kingdom_cards && other.curse_card_pile == curse_card_pile &&
-                other.trash == trash;
+        return other.treasure_begin == treasure_begin && other.kingdom_begin == kingdom_begin &&
+                other.piles == piles && other.trash == trash;
     }
 
     bool Board::operator!=(const Board &other) const { return !(*this == other); }
 
     // PRE: JSON must be an array type
-    std::optional<Board::pile_container_t> pileContainerFromJson(const rapidjson::Value &json)
+    std::optional<std::vector<Pile>> pileContainerFromJson(const rapidjson::Value &json)
     {
         _ASSERT_TRUE(json.IsArray(), "Pile container must be an array");
-        Board::pile_container_t pile_container;
+        std::vector<Pile> pile_container;
         for ( const auto &pile : json.GetArray() ) {
             const std::unique_ptr<Pile> pile_ptr = Pile::fromJson(pile);
             if ( pile_ptr == nullptr ) {
                 LOG(WARN) << "Failed to parse pile from JSON";
                 return std::nullopt;
             }
-            pile_container.insert(*pile_ptr);
+            pile_container.push_back(*pile_ptr);
         }
         return pile_container;
     }
@@ -103,7 +151,7 @@ namespace shared
         const Pile curse_pile = *curse_pile_ptr;
 
 #define GET_PILE_CONTAINER(pile_container, json, member_name)                                                          \
-    pile_container_t pile_container;                                                                                   \
+    std::vector<Pile> pile_container;                                                                                  \
     if ( (json).HasMember(member_name) && (json)[member_name].IsArray() ) {                                            \
         const auto container = pileContainerFromJson((json)[member_name]);                                             \
         if ( container.has_value() ) {                                                                                 \
@@ -130,7 +178,8 @@ namespace shared
         GET_STRING_ARRAY_MEMBER(played_cards, json, "played_cards");
 
         return std::unique_ptr<Board>(
-                new Board(victory_cards, treasure_cards, kingdom_cards, curse_pile, trash, played_cards));
+                new Board(std::move(victory_cards), std::move(treasure_cards), std::move(kingdom_cards), curse_pile,
+                          std::move(trash), std::move(played_cards)));
     }
 
     rapidjson::Document Board::toJson() const
@@ -138,7 +187,7 @@ namespace shared
         rapidjson::Document doc;
         doc.SetObject();
 
-        rapidjson::Document curse_pile_doc = curse_card_pile.toJson();
+        rapidjson::Document curse_pile_doc = getCurseCardPile().toJson();
         rapidjson::Value curse_pile_value;
         curse_pile_value.CopyFrom(curse_pile_doc, doc.GetAllocator());
         doc.AddMember("curse_pile", curse_pile_value, doc.GetAllocator());
@@ -153,9 +202,9 @@ namespace shared
     }                                                                                                                  \
     doc.AddMember(#member_name, member_name##_json, doc.GetAllocator());
 
-        ADD_PILE_CONTAINER(victory_cards, victory_cards);
-        ADD_PILE_CONTAINER(treasure_cards, treasure_cards);
-        ADD_PILE_CONTAINER(kingdom_cards, kingdom_cards);
+        ADD_PILE_CONTAINER(getVictoryCards(), victory_cards);
+        ADD_PILE_CONTAINER(getTreasureCards(), treasure_cards);
+        ADD_PILE_CONTAINER(getKingdomCards(), kingdom_cards);
 
 #undef ADD_PILE_CONTAINER
 
@@ -165,35 +214,61 @@ namespace shared
         return doc;
     }
 
+    void Board::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+
+        writer.Key("curse_pile");
+        getCurseCardPile().writeJson(writer);
+
+        const std::pair<const char *, pile_container_t> pile_containers[] = {
+                {"victory_cards", getVictoryCards()},
+                {"treasure_cards", getTreasureCards()},
+                {"kingdom_cards", getKingdomCards()},
+        };
+        for ( const auto &[member_name, pile_container] : pile_containers ) {
+            writer.Key(member_name);
+            writer.StartArray();
+            for ( const auto &pile : pile_container ) {
+                pile.writeJson(writer);
+            }
+            writer.EndArray();
+        }
+
+        WRITE_ARRAY_OF_STRINGS_MEMBER(trash, trash);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(played_cards, played_cards);
+
+        writer.EndObject();
+    }
+
     size_t Board::getEmptyPilesCount() const
     {
-        auto count_empty = [](const auto &pile_set) -> size_t
-        { return std::count_if(pile_set.begin(), pile_set.end(), [](const auto &pile) { return pile.count == 0; }); };
+        // the supply has a fixed number of piles (17), all in one array
+        return std::count_if(piles.begin(), piles.end(), [](const Pile &pile) { return pile.empty(); });
+    }
 
-        return count_empty(treasure_cards) + count_empty(victory_cards) + count_empty(kingdom_cards) +
-                static_cast<size_t>(curse_card_pile.empty());
+    void Board::setPileCount(CardId card_id, size_t count)
+    {
+        if ( getPile(card_id) != nullptr ) {
+            piles[pile_slots[card_id.index()]].count = count;
+        }
     }
 
     bool Board::isGameOver() const
     {
-        auto is_province_pile_empty = [&]() -> bool
-        {
-            if ( auto province_pile = victory_cards.find("Province"); province_pile != victory_cards.end() ) {
-                return province_pile->empty();
-            }
-            return false;
-        }();
+        const Pile *province_pile = getPile(CardId::of("Province"));
+        const bool is_province_pile_empty = province_pile != nullptr && province_pile->empty();
 
         return is_province_pile_empty || (getEmptyPilesCount() >= board_config::MAX_NUM_EMPTY_PILES);
     }
 
-    Board::pile_container_t Board::initialiseTreasureCards(size_t player_count)
+    std::vector<Pile> Board::initialiseTreasureCards(size_t player_count)
     {
         return {Pile("Copper", board_config::getCopperCount(player_count)),
                 Pile("Silver", board_config::TREASURE_SILVER_COUNT), Pile("Gold", board_config::TREASURE_GOLD_COUNT)};
     }
 
-    Board::pile_container_t Board::initialiseVictoryCards(size_t player_count)
+    std::vector<Pile> Board::initialiseVictoryCards(size_t player_count)
     {
         const size_t card_count = board_config::getVictoryCardCount(player_count);
         return {Pile("Estate", card_count), Pile("Duchy", card_count), Pile("Province", card_count)};
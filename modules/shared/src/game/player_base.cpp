@@ -115,6 +115,17 @@ namespace shared
         return doc;
     }
 
+    void PlayerBase::writeJsonMembers(JsonWriter &writer) const
+    {
+        WRITE_STRING_MEMBER(this->player_id.c_str(), player_id);
+        WRITE_UINT_MEMBER(this->actions, actions);
+        WRITE_UINT_MEMBER(this->buys, buys);
+        WRITE_UINT_MEMBER(this->treasure, treasure);
+        WRITE_STRING_MEMBER(this->current_card.c_str(), current_card);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(this->discard_pile, discard_pile);
+        WRITE_UINT_MEMBER(this->draw_pile_size, draw_pile_size);
+    }
+
     std::unique_ptr<PlayerBase> PlayerBase::fromJson(const rapidjson::Value &json)
     {
         PlayerBase::id_t player_id;
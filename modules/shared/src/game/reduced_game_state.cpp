@@ -50,6 +50,29 @@ namespace reduced
         return doc;
     }
 
+    void GameState::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+
+        writer.Key("board");
+        board->writeJson(writer);
+
+        writer.Key("reduced_player");
+        reduced_player->writeJson(writer);
+
+        writer.Key("reduced_enemies");
+        writer.StartArray();
+        for ( const auto &reduced_enemy : reduced_enemies ) {
+            reduced_enemy->writeJson(writer);
+        }
+        writer.EndArray();
+
+        WRITE_STRING_MEMBER(shared::toString(this->game_phase).c_str(), game_phase);
+        WRITE_STRING_MEMBER(this->active_player.c_str(), active_player);
+
+        writer.EndObject();
+    }
+
     bool GameState::isPlayerActive() const { return active_player == reduced_player->getId(); }
 
     std::unique_ptr<GameState> GameState::fromJson(const rapidjson::Value &json)
@@ -19,6 +19,14 @@ namespace reduced
         return doc;
     }
 
+    void Player::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        writeJsonMembers(writer);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(this->hand_cards, hand_cards);
+        writer.EndObject();
+    }
+
     std::unique_ptr<Player> Player::fromJson(const rapidjson::Value &json)
     {
         std::unique_ptr<shared::PlayerBase> player_base = PlayerBase::fromJson(json);
@@ -43,6 +51,14 @@ namespace reduced
         return doc;
     }
 
+    void Enemy::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        writeJsonMembers(writer);
+        WRITE_UINT_MEMBER(this->hand_size, hand_size);
+        writer.EndObject();
+    }
+
     std::unique_ptr<Enemy> Enemy::fromJson(const rapidjson::Value &json)
     {
         std::unique_ptr<shared::PlayerBase> player_base = PlayerBase::fromJson(json);
@@ -1,7 +1,13 @@
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 
 #include <shared/game/game_state/reduced_game_state.h>
 #include <shared/message_types.h>
@@ -185,7 +191,7 @@ static std::unique_ptr<StartGameRequestMessage> parseStartGameRequest(const Docu
         return nullptr;
     }
 
-    return std::make_unique<StartGameRequestMessage>(game_id, player_id, selected_cards, message_id);
+    return std::make_unique<StartGameRequestMessage>(game_id, player_id, std::move(selected_cards), message_id);
 }
 
 static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Document &json, const std::string &game_id,
@@ -233,38 +239,354 @@ static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Document
 
 /* ======= CLIENT TO SERVER MESSAGES ======= */
 
-namespace shared
+/**
+ * @brief The DOM parser: the document is parsed completely and the members are looked up with the GET_*_MEMBER
+ * macros. ClientToServerMessage::fromJson uses ClientToServerHandler instead, debug builds check it against this.
+ */
+static std::unique_ptr<ClientToServerMessage> parseClientToServerDocument(const std::string &json)
 {
-    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromJson(const std::string &json)
+    Document doc;
+    doc.Parse(json.c_str());
+
+    if ( doc.HasParseError() || !doc.IsObject() ) {
+        return nullptr;
+    }
+
+    std::string game_id;
+    GET_STRING_MEMBER(game_id, doc, "game_id");
+    std::string message_id;
+    GET_STRING_MEMBER(message_id, doc, "message_id");
+    std::string player_id;
+    GET_STRING_MEMBER(player_id, doc, "player_id");
+
+    std::string type;
+    GET_STRING_MEMBER(type, doc, "type");
+    if ( type == "game_state_request" ) {
+        return parseGameStateRequest(doc, game_id, player_id, message_id);
+    } else if ( type == "initiate_game_request" ) {
+        return parseCreateLobbyRequest(doc, game_id, player_id, message_id);
+    } else if ( type == "join_game_request" ) {
+        return parseJoinGameRequest(doc, game_id, player_id, message_id);
+    } else if ( type == "start_game_request" ) {
+        return parseStartGameRequest(doc, game_id, player_id, message_id);
+    } else if ( type == "action_decision" ) {
+        return parseActionDecision(doc, game_id, player_id, message_id);
+    } else {
+        return nullptr;
+    }
+}
+
+namespace
+{
+    /**
+     * @brief SAX handler that reads a client to server message in a single pass over the JSON, without building a
+     * document, and then builds the message of its type.
+     *
+     * The members of the top level object are checked like the GET_*_MEMBER macros of the DOM parser check them: only
+     * the first member of a name counts, a member of the wrong type is invalid (even if the message does not need it),
+     * strings end at their first null character and unsigned numbers are integers in [0, 2^32), -0 included. Other
+     * members and everything nested in them are skipped.
+     */
+    class ClientToServerHandler : public BaseReaderHandler<UTF8<>, ClientToServerHandler>
     {
-        Document doc;
-        doc.Parse(json.c_str());
+    public:
+        bool StartObject()
+        {
+            if ( depth == 0 ) {
+                depth = 1;
+                return true;
+            }
+            invalidate();
+            ++depth;
+            return true;
+        }
 
-        if ( doc.HasParseError() ) {
+        bool Key(const char *str, SizeType length, bool /*copy*/)
+        {
+            if ( depth == 1 ) {
+                current = find(std::string_view(str, length));
+            }
+            return true;
+        }
+
+        bool EndObject(SizeType /*member_count*/)
+        {
+            --depth;
+            return true;
+        }
+
+        bool StartArray()
+        {
+            if ( depth == 0 ) {
+                // the root has to be an object
+                return false;
+            }
+            if ( depth == 1 && isArray(current) ) {
+                array = current;
+                states[array] = VALID;
+                current = NONE;
+            } else {
+                invalidate();
+            }
+            ++depth;
+            return true;
+        }
+
+        bool EndArray(SizeType /*element_count*/)
+        {
+            if ( --depth == 1 ) {
+                array = NONE;
+            }
+            return true;
+        }
+
+        bool String(const char *str, SizeType /*length*/, bool /*copy*/)
+        {
+            if ( depth == 1 && isString(current) ) {
+                strings[current] = str;
+                states[current] = VALID;
+                current = NONE;
+            } else if ( depth == 2 && (array == SELECTED_CARDS || array == CARDS) ) {
+                (array == SELECTED_CARDS ? selected_cards : cards).emplace_back(str);
+            } else {
+                return Default();
+            }
+            return true;
+        }
+
+        bool Uint(unsigned u)
+        {
+            if ( depth == 1 && current == FROM ) {
+                from = u;
+                states[FROM] = VALID;
+                current = NONE;
+            } else if ( depth == 2 && array == CHOICES ) {
+                choices.push_back(u);
+            } else {
+                return Default();
+            }
+            return true;
+        }
+
+        bool Int(int i) { return i >= 0 ? Uint(static_cast<unsigned>(i)) : Default(); }
+
+        // null, booleans, large or negative numbers and doubles are not valid for any member
+        bool Default()
+        {
+            if ( depth == 0 ) {
+                return false;
+            }
+            invalidate();
+            return true;
+        }
+
+        /**
+         * @brief Builds the message once the whole JSON was parsed, nullptr if it is not valid.
+         */
+        std::unique_ptr<ClientToServerMessage> message()
+        {
+            if ( !require(GAME_ID) || !require(MESSAGE_ID) || !require(PLAYER_ID) || !require(TYPE) ) {
+                return nullptr;
+            }
+
+            std::string &game_id = strings[GAME_ID];
+            std::string &message_id = strings[MESSAGE_ID];
+            std::string &player_id = strings[PLAYER_ID];
+            const std::string &type = strings[TYPE];
+            if ( type == "game_state_request" ) {
+                return std::make_unique<GameStateRequestMessage>(std::move(game_id), std::move(player_id),
+                                                                 std::move(message_id));
+            } else if ( type == "initiate_game_request" ) {
+                return std::make_unique<CreateLobbyRequestMessage>(std::move(game_id), std::move(player_id),
+                                                                   std::move(message_id));
+            } else if ( type == "join_game_request" ) {
+                return std::make_unique<JoinLobbyRequestMessage>(std::move(game_id), std::move(player_id),
+                                                                 std::move(message_id));
+            } else if ( type == "start_game_request" ) {
+                if ( !require(SELECTED_CARDS) || selected_cards.size() != shared::board_config::KINGDOM_CARD_COUNT ) {
+                    return nullptr;
+                }
+                return std::make_unique<StartGameRequestMessage>(std::move(game_id), std::move(player_id),
+                                                                 std::move(selected_cards), std::move(message_id));
+            } else if ( type == "action_decision" ) {
+                return actionDecision(game_id, player_id, message_id);
+            }
             return nullptr;
         }
 
-        std::string game_id;
-        GET_STRING_MEMBER(game_id, doc, "game_id");
-        std::string message_id;
-        GET_STRING_MEMBER(message_id, doc, "message_id");
-        std::string player_id;
-        GET_STRING_MEMBER(player_id, doc, "player_id");
+    private:
+        /**
+         * @brief The members that are read, by the type of their value.
+         */
+        enum Field : unsigned
+        {
+            NONE,
+            // strings
+            TYPE,
+            GAME_ID,
+            MESSAGE_ID,
+            PLAYER_ID,
+            IN_RESPONSE_TO,
+            ACTION,
+            CARD_ID,
+            CARD,
+            CHOSEN_CARD,
+            // unsigned
+            FROM,
+            // arrays of strings
+            SELECTED_CARDS,
+            CARDS,
+            // arrays of unsigned
+            CHOICES,
+            FIELD_COUNT
+        };
+
+        static constexpr std::array<std::string_view, FIELD_COUNT> NAMES = {
+                "",     "type",        "game_id", "message_id",     "player_id", "in_response_to", "action", "card_id",
+                "card", "chosen_card", "from",    "selected_cards", "cards",     "choices"};
+
+        enum State : uint8_t
+        {
+            MISSING,
+            VALID,
+            INVALID
+        };
+
+        static bool isString(Field field) { return field >= TYPE && field <= CHOSEN_CARD; }
+        static bool isArray(Field field) { return field >= SELECTED_CARDS && field <= CHOICES; }
+
+        /**
+         * @brief The field of a member name, NONE if it is not needed or if there already was a member of this name.
+         */
+        Field find(std::string_view name) const
+        {
+            for ( unsigned field = TYPE; field < FIELD_COUNT; ++field ) {
+                if ( NAMES[field] == name ) {
+                    return states[field] == MISSING ? static_cast<Field>(field) : NONE;
+                }
+            }
+            return NONE;
+        }
 
-        std::string type;
-        GET_STRING_MEMBER(type, doc, "type");
-        if ( type == "game_state_request" ) {
-            return parseGameStateRequest(doc, game_id, player_id, message_id);
-        } else if ( type == "initiate_game_request" ) {
-            return parseCreateLobbyRequest(doc, game_id, player_id, message_id);
-        } else if ( type == "join_game_request" ) {
-            return parseJoinGameRequest(doc, game_id, player_id, message_id);
-        } else if ( type == "start_game_request" ) {
-            return parseStartGameRequest(doc, game_id, player_id, message_id);
-        } else if ( type == "action_decision" ) {
-            return parseActionDecision(doc, game_id, player_id, message_id);
-        } else {
+        /**
+         * @brief The value that starts now does not have the type of the member it belongs to.
+         */
+        void invalidate()
+        {
+            if ( depth == 1 && current != NONE ) {
+                states[current] = INVALID;
+                current = NONE;
+            } else if ( depth == 2 && array != NONE ) {
+                states[array] = INVALID;
+            }
+        }
+
+        bool require(Field field) const
+        {
+            if ( states[field] != VALID ) {
+                LOG(WARN) << "Missing or invalid member: " << NAMES[field];
+                return false;
+            }
+            return true;
+        }
+
+        std::unique_ptr<ActionDecisionMessage> actionDecision(const std::string &game_id,
+                                                              const PlayerBase::id_t &player_id,
+                                                              const std::string &message_id)
+        {
+            std::optional<std::string> in_response_to;
+            if ( states[IN_RESPONSE_TO] == INVALID ) {
+                LOG(WARN) << "Invalid member: " << NAMES[IN_RESPONSE_TO];
+                return nullptr;
+            } else if ( states[IN_RESPONSE_TO] == VALID ) {
+                in_response_to = std::move(strings[IN_RESPONSE_TO]);
+            }
+
+            if ( !require(ACTION) ) {
+                return nullptr;
+            }
+            std::unique_ptr<ActionDecision> decision;
+            const std::string &action = strings[ACTION];
+            if ( action == "play_action_card" ) {
+                if ( !require(CARD_ID) || !require(FROM) ) {
+                    return nullptr;
+                }
+                decision = std::make_unique<PlayActionCardDecision>(strings[CARD_ID], static_cast<CardAccess>(from));
+            } else if ( action == "buy_card" ) {
+                if ( !require(CARD) ) {
+                    return nullptr;
+                }
+                decision = std::make_unique<BuyCardDecision>(strings[CARD]);
+            } else if ( action == "end_action_phase" ) {
+                decision = std::make_unique<EndActionPhaseDecision>();
+            } else if ( action == "end_turn" ) {
+                decision = std::make_unique<EndTurnDecision>();
+            } else if ( action == "deck_choice" ) {
+                if ( !require(CARDS) || !require(CHOICES) ) {
+                    return nullptr;
+                }
+                std::vector<shared::ChooseFromOrder::AllowedChoice> allowed_choices;
+                allowed_choices.reserve(choices.size());
+                for ( const unsigned choice : choices ) {
+                    allowed_choices.push_back(static_cast<shared::ChooseFromOrder::AllowedChoice>(choice));
+                }
+                decision = std::make_unique<DeckChoiceDecision>(cards, allowed_choices);
+            } else if ( action == "board_choice" ) {
+                if ( !require(CHOSEN_CARD) ) {
+                    return nullptr;
+                }
+                decision = std::make_unique<GainFromBoardDecision>(strings[CHOSEN_CARD]);
+            } else {
+                return nullptr;
+            }
+
+            return std::make_unique<ActionDecisionMessage>(game_id, player_id, std::move(decision), in_response_to,
+                                                           message_id);
+        }
+
+        std::array<State, FIELD_COUNT> states{};
+        std::array<std::string, FROM> strings;
+        unsigned from = 0;
+        std::vector<CardBase::id_t> selected_cards;
+        std::vector<CardBase::id_t> cards;
+        std::vector<unsigned> choices;
+
+        size_t depth = 0;
+        // the member whose value comes next and the array member whose elements come next
+        Field current = NONE;
+        Field array = NONE;
+    };
+
+    /**
+     * @brief Parses with ClientToServerHandler. The reader is kept per thread, so its stack is only allocated once.
+     */
+    std::unique_ptr<ClientToServerMessage> parseClientToServer(const std::string &json)
+    {
+        thread_local Reader reader;
+        ClientToServerHandler handler;
+        StringStream stream(json.c_str());
+        if ( reader.Parse(stream, handler).IsError() ) {
             return nullptr;
         }
+        return handler.message();
+    }
+} // namespace
+
+namespace shared
+{
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromJson(const std::string &json)
+    {
+        std::unique_ptr<ClientToServerMessage> message = parseClientToServer(json);
+#ifndef NDEBUG
+        // debug builds use the DOM parser and check that both parsers agree
+        std::unique_ptr<ClientToServerMessage> dom_message = parseClientToServerDocument(json);
+        const bool parsers_agree = message == nullptr
+                ? dom_message == nullptr
+                : dom_message != nullptr && message->toJson() == dom_message->toJson();
+        _ASSERT_TRUE(parsers_agree, "The SAX and the DOM parser do not agree on a message");
+        return dom_message;
+#else
+        return message;
+#endif
     }
 } // namespace shared
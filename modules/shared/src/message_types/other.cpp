@@ -34,7 +34,7 @@ namespace shared
     StartGameRequestMessage::StartGameRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                                      std::vector<CardBase::id_t> selected_cards,
                                                      std::string message_id) :
-        ClientToServerMessage(game_id, player_id, message_id),
+        ClientToServerMessage(KIND, game_id, player_id, message_id),
         selected_cards(selected_cards)
     {
         // Due to a bug in the assert macro we need to cast the size to int
@@ -1,8 +1,18 @@
+#include <shared/utils/json.h>
 
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 #include <string>
 
+namespace
+{
+    // the buffer keeps the memory of the largest message; after a message larger than this it is given back
+    constexpr size_t MAX_KEPT_BUFFER_SIZE = size_t{64} << 10;
+
+    thread_local rapidjson::StringBuffer thread_buffer;
+    thread_local JsonWriter thread_writer;
+} // namespace
+
 std::string documentToString(const rapidjson::Document &doc)
 {
     rapidjson::StringBuffer buffer;
@@ -10,3 +20,20 @@ std::string documentToString(const rapidjson::Document &doc)
     doc.Accept(writer);
     return buffer.GetString();
 }
+
+JsonWriter &threadWriter()
+{
+    thread_buffer.Clear();
+    thread_writer.Reset(thread_buffer);
+    return thread_writer;
+}
+
+std::string threadWriterOutput()
+{
+    std::string output(thread_buffer.GetString(), thread_buffer.GetSize());
+    if ( thread_buffer.GetSize() > MAX_KEPT_BUFFER_SIZE ) {
+        thread_buffer.Clear();
+        thread_buffer.ShrinkToFit();
+    }
+    return output;
+}
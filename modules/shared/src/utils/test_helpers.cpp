@@ -1,6 +1,7 @@
 #include <shared/utils/test_helpers.h>
 
 #include <cstdlib> // for std::rand
+#include <set>
 
 std::vector<shared::CardBase::id_t> getValidKingdomCards()
 {
@@ -8,14 +9,14 @@ std::vector<shared::CardBase::id_t> getValidKingdomCards()
             "Silk_Road", "Council_Room", "Witch",  "Gardens",  "Duke"};
 }
 
-void setNPilesToEmpty(shared::Board::pile_container_t &pile_container, size_t n)
+void setNPilesToEmpty(shared::Board &board, shared::Board::pile_container_t pile_container, size_t n)
 {
     size_t i = 0;
     for ( const auto &pile : pile_container ) {
         if ( i >= n ) {
             break;
         }
-        pile.count = 0;
+        board.setPileCount(pile.card_id, 0);
         ++i;
     }
 }
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/game/behaviour_chain.h>
+#include <shared/utils/test_helpers.h>
+
+TEST(BehaviourChainTest, OneShotCardsAreStatic)
+{
+    server::BehaviourRegistry registry;
+
+    EXPECT_NE(registry.getStaticBehaviours("Copper"), nullptr);
+    EXPECT_NE(registry.getStaticBehaviours("Village"), nullptr);
+    EXPECT_NE(registry.getStaticBehaviours("Witch"), nullptr);
+    EXPECT_NE(registry.getStaticBehaviours("Estate"), nullptr);
+
+    // these wait for decisions, so they keep state
+    EXPECT_EQ(registry.getStaticBehaviours("Militia"), nullptr);
+    EXPECT_EQ(registry.getStaticBehaviours("Remodel"), nullptr);
+    EXPECT_EQ(registry.getStaticBehaviours("Artisan"), nullptr);
+
+    EXPECT_THROW(registry.getStaticBehaviours(shared::CardId::invalid()), exception::CardNotAvailable);
+}
+
+TEST(BehaviourChainTest, RunsStaticBehaviours)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2"};
+    server::GameState game_state(selected_cards, player_ids);
+    auto &player = game_state.getCurrentPlayer();
+    const auto hand_size = player.get<shared::HAND>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours("Market");
+    EXPECT_FALSE(chain.empty());
+
+    auto response = chain.startChain(game_state);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_TRUE(response.empty());
+    EXPECT_EQ(player.getActions(), 2);
+    EXPECT_EQ(player.getBuys(), 2);
+    EXPECT_EQ(player.getTreasure(), 1);
+    EXPECT_EQ(player.get<shared::HAND>().size(), hand_size + 1);
+}
+
+TEST(BehaviourChainTest, KeepsStatefulBehavioursUntilTheTurnEnds)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3"};
+    server::GameState game_state(selected_cards, player_ids);
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours("Militia");
+
+    // both enemies have 5 cards in their hand and have to discard 2
+    auto response = chain.startChain(game_state);
+    EXPECT_FALSE(chain.empty());
+    EXPECT_TRUE(response.hasOrder(1));
+    EXPECT_TRUE(response.hasOrder(2));
+    EXPECT_EQ(game_state.getCurrentPlayer().getTreasure(), 2);
+
+    EXPECT_THROW(chain.resetArena(), exception::UnreachableCode);
+}
+
+TEST(BehaviourChainTest, ResumesMultiStepBehavioursWithTheirDecisions)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2"};
+    server::GameState game_state(selected_cards, player_ids);
+    game_state.setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
+    auto &player = game_state.getCurrentPlayer();
+    const auto hand_size = player.get<shared::HAND>().size();
+    const auto discard_size = player.get<shared::DISCARD_PILE>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours("Remodel");
+
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(0));
+    EXPECT_NE(dynamic_cast<shared::ChooseFromHandOrder *>(response.getOrder(0).get()), nullptr);
+
+    // a decision of the wrong type is rejected and Remodel keeps waiting for the card to trash
+    std::unique_ptr<shared::ActionDecision> wrong_decision = std::make_unique<shared::GainFromBoardDecision>("Estate");
+    EXPECT_THROW(chain.continueChain(game_state, 0, wrong_decision), std::runtime_error);
+    EXPECT_FALSE(chain.empty());
+
+    const auto trashed_card = player.get<shared::HAND>().front();
+    std::unique_ptr<shared::ActionDecision> trash_decision = std::make_unique<shared::DeckChoiceDecision>(
+            std::vector<shared::CardBase::id_t>{trashed_card.name()},
+            std::vector<shared::ChooseFromOrder::AllowedChoice>{shared::ChooseFromOrder::AllowedChoice::TRASH});
+    response = chain.continueChain(game_state, 0, trash_decision);
+    ASSERT_TRUE(response.hasOrder(0));
+    EXPECT_NE(dynamic_cast<shared::GainFromBoardOrder *>(response.getOrder(0).get()), nullptr);
+    EXPECT_EQ(player.get<shared::HAND>().size(), hand_size - 1);
+    EXPECT_FALSE(chain.empty());
+
+    std::unique_ptr<shared::ActionDecision> gain_decision = std::make_unique<shared::GainFromBoardDecision>("Estate");
+    response = chain.continueChain(game_state, 0, gain_decision);
+    EXPECT_TRUE(response.empty());
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.get<shared::DISCARD_PILE>().size(), discard_size + 1);
+
+    EXPECT_NO_THROW(chain.resetArena());
+}
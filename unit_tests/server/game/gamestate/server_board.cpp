@@ -15,9 +15,14 @@
 // ================================
 // HELPERS
 // ================================
+auto findPile(server::ServerBoard::pile_container_t piles, const shared::CardBase::id_t &card_id)
+{
+    return std::find_if(piles.begin(), piles.end(), [&](const shared::Pile &pile) { return pile.card_id == card_id; });
+}
+
 #define EXPECT_PILE(pile_set, key, expected_count)                                                                     \
     do {                                                                                                               \
-        auto it = (pile_set).find((key));                                                                              \
+        auto it = findPile((pile_set), (key));                                                                         \
         EXPECT_NE(it, (pile_set).end());                                                                               \
         if ( it != (pile_set).end() ) {                                                                                \
             EXPECT_EQ(it->count, (expected_count));                                                                    \
@@ -40,15 +45,7 @@ public:
     using server::ServerBoard::trashCard;
 
     // Accessors for protected data members
-    const server::ServerBoard::pile_container_t &getKingdomCards() const { return kingdom_cards; }
-    const server::ServerBoard::pile_container_t &getTreasureCards() const { return treasure_cards; }
-    const server::ServerBoard::pile_container_t &getVictoryCards() const { return victory_cards; }
     const std::vector<shared::CardBase::id_t> &getTrash() const { return trash; }
-
-    // Mutable accessors for testing purposes
-    server::ServerBoard::pile_container_t &getMutableKingdomCards() { return kingdom_cards; }
-    server::ServerBoard::pile_container_t &getMutableTreasureCards() { return treasure_cards; }
-    server::ServerBoard::pile_container_t &getMutableVictoryCards() { return victory_cards; }
 };
 
 // ================================
@@ -78,26 +75,8 @@ protected:
         board = new TestableServerBoard(kingdom_cards, player_count);
 
         if ( param.empty_pile ) {
-            // Empty the specified pile
-            if ( param.pile_type == "Kingdom" ) {
-                auto &kingdom_piles = board->getMutableKingdomCards();
-                auto it = kingdom_piles.find(param.card_to_buy);
-                if ( it != kingdom_piles.end() ) {
-                    it->count = 0;
-                }
-            } else if ( param.pile_type == "Treasure" ) {
-                auto &treasure_piles = board->getMutableTreasureCards();
-                auto it = treasure_piles.find(param.card_to_buy);
-                if ( it != treasure_piles.end() ) {
-                    it->count = 0;
-                }
-            } else if ( param.pile_type == "Victory" ) {
-                auto &victory_piles = board->getMutableVictoryCards();
-                auto it = victory_piles.find(param.card_to_buy);
-                if ( it != victory_piles.end() ) {
-                    it->count = 0;
-                }
-            }
+            // Empty the specified pile, this does nothing for cards that are not in the supply
+            board->setPileCount(param.card_to_buy, 0);
         }
     }
 
@@ -119,25 +98,26 @@ TEST_P(ServerBoardBuyCardTest, BuyCardTest)
     bool card_exists = false;
     size_t initial_count = 0;
     auto it = server::ServerBoard::pile_container_t::iterator();
+    server::ServerBoard::pile_container_t piles;
 
     if ( pile_type == "Kingdom" ) {
-        const auto &kingdom_piles = board->getKingdomCards();
-        it = kingdom_piles.find(card_to_buy);
-        if ( it != kingdom_piles.end() ) {
+        piles = board->getKingdomCards();
+        it = findPile(piles, card_to_buy);
+        if ( it != piles.end() ) {
             card_exists = true;
             initial_count = it->count;
         }
     } else if ( pile_type == "Treasure" ) {
-        const auto &treasure_piles = board->getTreasureCards();
-        it = treasure_piles.find(card_to_buy);
-        if ( it != treasure_piles.end() ) {
+        piles = board->getTreasureCards();
+        it = findPile(piles, card_to_buy);
+        if ( it != piles.end() ) {
             card_exists = true;
             initial_count = it->count;
         }
     } else if ( pile_type == "Victory" ) {
-        const auto &victory_piles = board->getVictoryCards();
-        it = victory_piles.find(card_to_buy);
-        if ( it != victory_piles.end() ) {
+        piles = board->getVictoryCards();
+        it = findPile(piles, card_to_buy);
+        if ( it != piles.end() ) {
             card_exists = true;
             initial_count = it->count;
         }
@@ -250,8 +230,74 @@ TEST(ServerBoardTest, BuyAllCopiesOfCard)
     EXPECT_THROW(board.tryTake(card_to_buy), exception::CardNotAvailable);
 
     // Check that the pile count is zero
-    const auto &kingdom_piles = board.getKingdomCards();
-    auto it = kingdom_piles.find(card_to_buy);
+    const auto kingdom_piles = board.getKingdomCards();
+    auto it = findPile(kingdom_piles, card_to_buy);
     ASSERT_NE(it, kingdom_piles.end());
     EXPECT_EQ(it->count, 0);
 }
+
+TEST(ServerBoardTest, EmptyPilesAreCounted)
+{
+    auto kingdom_cards = getValidKingdomCards();
+    TestableServerBoard board(kingdom_cards, 2);
+    EXPECT_EQ(board.getEmptyPilesCount(), 0);
+    EXPECT_EQ(board.getProgress(), 0.0);
+
+    // the Provinces are the closest to the end
+    for ( size_t i = 0; i < shared::board_config::VICTORY_CARDS_SMALL_GAME / 2; ++i ) {
+        board.tryTake("Province");
+    }
+    EXPECT_DOUBLE_EQ(board.getProgress(), 0.5);
+
+    for ( size_t pile = 0; pile < shared::board_config::MAX_NUM_EMPTY_PILES; ++pile ) {
+        EXPECT_FALSE(board.isGameOver());
+        for ( size_t i = 0; i < shared::board_config::KINGDOM_CARD_COUNT; ++i ) {
+            board.tryTake(kingdom_cards[pile]);
+        }
+        EXPECT_EQ(board.getEmptyPilesCount(), pile + 1);
+        EXPECT_EQ(board.getEmptyPilesCount(), board.shared::Board::getEmptyPilesCount());
+    }
+    EXPECT_TRUE(board.isGameOver());
+    EXPECT_EQ(board.getProgress(), 1.0);
+
+    // an empty pile stays empty
+    EXPECT_FALSE(board.tryTake(kingdom_cards[0], std::nothrow));
+    EXPECT_EQ(board.getEmptyPilesCount(), shared::board_config::MAX_NUM_EMPTY_PILES);
+
+    const auto restored = server::ServerBoard::make(board.snapshot(), 2);
+    EXPECT_EQ(restored->getEmptyPilesCount(), shared::board_config::MAX_NUM_EMPTY_PILES);
+    EXPECT_TRUE(restored->isGameOver());
+}
+
+TEST(ServerBoardTest, TheLastProvinceEndsTheGame)
+{
+    TestableServerBoard board(getValidKingdomCards(), 3);
+    for ( size_t i = 0; i < shared::board_config::VICTORY_CARDS_LARGE_GAME - 1; ++i ) {
+        board.tryTake("Province");
+    }
+    EXPECT_FALSE(board.isGameOver());
+    EXPECT_LT(board.getProgress(), 1.0);
+
+    board.tryTake("Province");
+    EXPECT_TRUE(board.isGameOver());
+    EXPECT_EQ(board.getEmptyPilesCount(), 1);
+}
+
+TEST(ServerBoardTest, SetPileCountKeepsTheCountersInSync)
+{
+    TestableServerBoard board(getValidKingdomCards(), 2);
+    const auto smithy = shared::CardId::of("Smithy");
+
+    board.setPileCount(smithy, 0);
+    EXPECT_EQ(board.getPile(smithy)->count, 0);
+    EXPECT_EQ(board.getEmptyPilesCount(), 1);
+    EXPECT_EQ(board.hash(), board.computeHash());
+
+    board.setPileCount(smithy, 3);
+    EXPECT_EQ(board.getEmptyPilesCount(), 0);
+    EXPECT_EQ(board.hash(), board.computeHash());
+
+    // not in the supply
+    board.setPileCount(shared::CardId::of("Moat"), 0);
+    EXPECT_EQ(board.getEmptyPilesCount(), 0);
+}
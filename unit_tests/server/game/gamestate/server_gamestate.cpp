@@ -1,5 +1,7 @@
 // game_state_test.cpp
 
+#include <cstring>
+#include <functional>
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
@@ -104,3 +106,225 @@ TEST(GameStateTest, StartTurn)
     // For testing purposes, we can check if hand_cards is not empty
     EXPECT_EQ(current_player.get<shared::CardAccess::HAND>().size(), 5);
 }
+
+TEST(GameStateTest, SameSeedSameShuffles)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3"};
+
+    server::GameState game_state(selected_cards, player_ids, 42);
+    server::GameState replay(selected_cards, player_ids, game_state.getSeed());
+    EXPECT_EQ(replay.getSeed(), 42);
+
+    // the discard pile is reshuffled every other turn
+    for ( int turn = 0; turn < 12; ++turn ) {
+        for ( const auto &id : player_ids ) {
+            EXPECT_EQ(game_state.getPlayer(id).get<shared::CardAccess::HAND>(),
+                      replay.getPlayer(id).get<shared::CardAccess::HAND>());
+        }
+        game_state.endTurn();
+        replay.endTurn();
+    }
+}
+
+TEST(GameStateTest, RejectedMovesReturnTheirError)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2"};
+    server::GameState game_state(selected_cards, player_ids);
+    const auto copper = shared::CardId::of("Copper");
+    const auto province = shared::CardId::of("Province");
+
+    EXPECT_EQ(game_state.tryBuy(1, copper, std::nothrow).error(), server::MoveError::NOT_YOUR_TURN);
+    auto result = game_state.tryBuy(0, copper, std::nothrow);
+    EXPECT_EQ(result.error(), server::MoveError::OUT_OF_PHASE);
+    EXPECT_EQ(result.message(), "You can not buy a card while in action_phase");
+    EXPECT_THROW(game_state.tryBuy(0, copper), exception::OutOfPhase);
+    EXPECT_THROW(game_state.tryEndTurn(1), exception::NotYourTurn);
+
+    ASSERT_TRUE(game_state.tryEndActionPhase(0, std::nothrow));
+    EXPECT_EQ(game_state.getPhase(), shared::GamePhase::BUY_PHASE);
+    EXPECT_EQ(game_state.tryPlay<shared::CardAccess::HAND>(0, copper, std::nothrow).error(),
+              server::MoveError::OUT_OF_PHASE);
+
+    // a rejected move does not change the game
+    auto &player = game_state.getPlayer("player1");
+    const auto treasure = player.getTreasure();
+    EXPECT_EQ(game_state.tryBuy(0, province, std::nothrow).error(), server::MoveError::INSUFFICIENT_FUNDS);
+    EXPECT_EQ(game_state.tryBuy(0, shared::CardId::invalid(), std::nothrow).error(),
+              server::MoveError::CARD_NOT_AVAILABLE);
+    EXPECT_EQ(player.getTreasure(), treasure);
+    EXPECT_EQ(player.getBuys(), 1);
+
+    EXPECT_TRUE(game_state.tryBuy(0, copper, std::nothrow).ok());
+    EXPECT_EQ(player.getBuys(), 0);
+}
+
+TEST(GameStateTest, ForkIsIndependent)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2"};
+    server::GameState game_state(selected_cards, player_ids, 42);
+    const auto silver = shared::CardId::of("Silver");
+
+    server::GameState fork = game_state.fork();
+    EXPECT_NE(fork.getBoard(), game_state.getBoard());
+
+    fork.tryEndActionPhase(0);
+    fork.getPlayer("player1").addTreasure(3);
+    fork.tryBuy(0, silver);
+    fork.tryEndTurn(0);
+
+    // the original has not moved
+    EXPECT_EQ(game_state.getCurrentPlayerId(), "player1");
+    EXPECT_EQ(game_state.getPhase(), shared::GamePhase::ACTION_PHASE);
+    EXPECT_EQ(game_state.getBoard()->getPile(silver)->count, fork.getBoard()->getPile(silver)->count + 1);
+    EXPECT_EQ(game_state.getPlayer("player1").get<shared::CardAccess::DISCARD_PILE>().size(), 0);
+    EXPECT_EQ(fork.getPlayer("player1").get<shared::CardAccess::DISCARD_PILE>().size(), 6);
+    EXPECT_EQ(fork.getCurrentPlayerId(), "player2");
+
+    // the generators are copied, so the same moves give the same game
+    server::GameState replay = game_state.fork();
+    for ( int turn = 0; turn < 4; ++turn ) {
+        game_state.endTurn();
+        replay.endTurn();
+        for ( const auto &id : player_ids ) {
+            EXPECT_EQ(game_state.getPlayer(id).get<shared::CardAccess::HAND>(),
+                      replay.getPlayer(id).get<shared::CardAccess::HAND>());
+            EXPECT_EQ(game_state.getPlayer(id).getCounts<shared::CardAccess::DRAW_PILE_TOP>().size(),
+                      replay.getPlayer(id).getCounts<shared::CardAccess::DRAW_PILE_TOP>().size());
+        }
+    }
+}
+
+TEST(GameStateTest, SnapshotRestoresTheGame)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3"};
+    server::GameState game_state(selected_cards, player_ids, 42);
+    const auto silver = shared::CardId::of("Silver");
+
+    for ( int turn = 0; turn < 5; ++turn ) {
+        game_state.getCurrentPlayer().gain(silver);
+        game_state.endTurn();
+    }
+    game_state.getBoard()->tryTake(silver);
+    game_state.getBoard()->trashCard(shared::CardId::of("Copper"));
+    // without action cards the turn starts in the buy phase
+    game_state.tryPlayAllTreasures(game_state.getCurrentSeat());
+
+    // a snapshot is plain bytes
+    const server::GameSnapshot snapshot = game_state.snapshot();
+    server::GameSnapshot copy;
+    std::memcpy(&copy, &snapshot, sizeof(snapshot));
+    EXPECT_EQ(copy, snapshot);
+
+    server::GameState restored(copy, player_ids);
+    EXPECT_EQ(restored.snapshot(), snapshot);
+    EXPECT_EQ(restored.getCurrentPlayerId(), game_state.getCurrentPlayerId());
+    EXPECT_EQ(restored.getPhase(), game_state.getPhase());
+    EXPECT_EQ(restored.getSeed(), 42);
+    EXPECT_EQ(restored.getBoard()->getPile(silver)->count, game_state.getBoard()->getPile(silver)->count);
+    EXPECT_EQ(restored.getBoard()->getPlayedCards(), game_state.getBoard()->getPlayedCards());
+    for ( const auto &id : player_ids ) {
+        EXPECT_EQ(restored.getPlayer(id).get<shared::CardAccess::HAND>(),
+                  game_state.getPlayer(id).get<shared::CardAccess::HAND>());
+        EXPECT_EQ(restored.getPlayer(id).get<shared::CardAccess::DISCARD_PILE>(),
+                  game_state.getPlayer(id).get<shared::CardAccess::DISCARD_PILE>());
+        EXPECT_EQ(restored.getPlayer(id).getVictoryPoints(), game_state.getPlayer(id).getVictoryPoints());
+    }
+
+    // the generators are restored as well
+    for ( int turn = 0; turn < 6; ++turn ) {
+        game_state.endTurn();
+        restored.endTurn();
+    }
+    EXPECT_EQ(restored.snapshot(), game_state.snapshot());
+
+    EXPECT_THROW(server::GameState(snapshot, {"player1", "player2"}), exception::PlayerCountMismatch);
+}
+
+TEST(GameStateTest, CorruptedSnapshotsAreRejected)
+{
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3"};
+    const server::GameSnapshot valid =
+            server::GameState(test_helper::getValidRandomKingdomCards(10), player_ids, 42).snapshot();
+    EXPECT_NO_THROW(server::validate(valid));
+    constexpr auto UNKNOWN_CARD = static_cast<shared::CardId::index_t>(shared::CARD_COUNT);
+
+    auto expectInvalid = [&](const std::function<void(server::GameSnapshot &)> &corrupt)
+    {
+        server::GameSnapshot snapshot = valid;
+        corrupt(snapshot);
+        EXPECT_THROW(server::validate(snapshot), exception::InvalidSnapshot);
+        EXPECT_THROW(server::GameState(snapshot, player_ids), exception::InvalidSnapshot);
+    };
+    expectInvalid([](auto &snapshot) { snapshot.current_player = 9; });
+    expectInvalid([](auto &snapshot) { snapshot.phase = 77; });
+    expectInvalid([](auto &snapshot) { snapshot.player_count = 5; });
+    expectInvalid([](auto &snapshot) { snapshot.player_count = 1; });
+    expectInvalid(
+            [](auto &snapshot)
+            {
+                snapshot.players[1].draw_pile_size = 255;
+                snapshot.players[1].hand_size = 255;
+            });
+    expectInvalid([](auto &snapshot) { snapshot.players[2].cards[0] = UNKNOWN_CARD; });
+    expectInvalid([](auto &snapshot) { snapshot.board.played_count = 255; });
+    expectInvalid(
+            [](auto &snapshot)
+            {
+                snapshot.board.played_count = 1;
+                snapshot.board.played[0] = shared::CardId::INVALID_INDEX;
+            });
+    expectInvalid([](auto &snapshot) { snapshot.board.kingdom[3] = UNKNOWN_CARD; });
+    expectInvalid([](auto &snapshot) { snapshot.board.kingdom[3] = shared::CardId::of("Copper").index(); });
+    expectInvalid([](auto &snapshot) { snapshot.board.kingdom[3] = snapshot.board.kingdom[4]; });
+}
+
+TEST(GameStateTest, HashFollowsThePosition)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2"};
+    server::GameState game_state(selected_cards, player_ids, 42);
+    const auto silver = shared::CardId::of("Silver");
+    const auto estate = shared::CardId::of("Estate");
+
+    const auto start = game_state.hash();
+    EXPECT_EQ(start, game_state.computeHash());
+    EXPECT_EQ(game_state.fork().hash(), start);
+    EXPECT_EQ(server::GameState(game_state.snapshot(), player_ids).hash(), start);
+
+    // gaining cards is only allowed while an action card is played
+    game_state.setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
+    EXPECT_NE(game_state.hash(), start);
+
+    // the same position reached in another order has the same hash
+    auto silver_first = game_state.fork();
+    silver_first.tryGain<shared::CardAccess::DISCARD_PILE>(0, silver);
+    silver_first.tryGain<shared::CardAccess::DISCARD_PILE>(0, estate);
+    auto estate_first = game_state.fork();
+    estate_first.tryGain<shared::CardAccess::DISCARD_PILE>(0, estate);
+    estate_first.tryGain<shared::CardAccess::DISCARD_PILE>(0, silver);
+    EXPECT_NE(silver_first.hash(), game_state.hash());
+    EXPECT_EQ(silver_first.hash(), estate_first.hash());
+
+    // the same card in another pile or of another player is another position
+    auto hand = game_state.fork();
+    hand.tryGain<shared::CardAccess::HAND>(0, silver);
+    auto enemy = game_state.fork();
+    enemy.tryGain<shared::CardAccess::DISCARD_PILE>(1, silver);
+    auto discard = game_state.fork();
+    discard.tryGain<shared::CardAccess::DISCARD_PILE>(0, silver);
+    EXPECT_NE(hand.hash(), discard.hash());
+    EXPECT_NE(enemy.hash(), discard.hash());
+
+    game_state.getBoard()->trashCard(shared::CardId::of("Copper"));
+    game_state.setPhase(shared::GamePhase::BUY_PHASE);
+    const auto buy_phase = game_state.hash();
+    EXPECT_NE(buy_phase, start);
+    game_state.tryBuy(0, shared::CardId::of("Copper"));
+    game_state.endTurn();
+    EXPECT_NE(game_state.hash(), buy_phase);
+    EXPECT_EQ(game_state.hash(), game_state.computeHash());
+}
@@ -14,6 +14,7 @@ public:
     using Player::getMutable;
 
     // expose the functions to test
+    using Player::take;
 };
 
 // Begin test cases
@@ -61,65 +62,65 @@ TEST(PlayerTest, DrawCards)
 {
     TestPlayer player("player");
 
-    std::vector<std::string> draw_pile = {"Card1", "Card2", "Card3", "Card4", "Card5"};
+    std::vector<shared::CardId> draw_pile = {"Copper", "Silver", "Gold", "Estate", "Duchy"};
     player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = draw_pile;
 
     player.draw(2);
 
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Copper");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Silver");
 
     ASSERT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>().size(), 3);
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Card3");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Card4");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[2], "Card5");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Gold");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Estate");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[2], "Duchy");
 }
 
 TEST(PlayerTest, TrashCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> hand = {"Card1", "Card2", "Card3"};
+    std::vector<shared::CardId> hand = {"Copper", "Silver", "Gold"};
     player.getMutable<shared::CardAccess::HAND>() = hand;
 
     player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(hand[1]);
 
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Copper");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Gold");
 }
 
 TEST(PlayerTest, DiscardCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> hand = {"Card1", "Card2", "Card3"};
+    std::vector<shared::CardId> hand = {"Copper", "Silver", "Gold"};
     player.getMutable<shared::CardAccess::HAND>() = hand;
 
     // Discard the second card (index 1)
     player.move<shared::HAND, shared::DISCARD_PILE>(hand[1]);
 
-    // Now hand should have "Card1", "Card3"
+    // Now hand should have "Copper", "Gold"
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Copper");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Gold");
 
-    // Discard pile should have "Card2"
+    // Discard pile should have "Silver"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 1);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Silver");
 }
 
 TEST(PlayerTest, GainCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> discard_pile = {"Card1", "Card2"};
+    std::vector<shared::CardId> discard_pile = {"Copper", "Silver"};
     player.getMutable<shared::CardAccess::DISCARD_PILE>() = discard_pile;
 
-    // Add "Card3" to hand
-    player.gain("Card3");
+    // Add "Gold" to hand
+    player.gain("Gold");
 
-    // Now hand should have "Card1", "Card2", "Card3"
+    // Now hand should have "Copper", "Silver", "Gold"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 3);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[2], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[2], "Gold");
 }
 
 TEST(PlayerTest, AddToDiscardPile)
@@ -129,12 +130,12 @@ TEST(PlayerTest, AddToDiscardPile)
     // Discard pile is initially empty
     EXPECT_TRUE(player.get<shared::CardAccess::DISCARD_PILE>().empty());
 
-    // Add "Card1" to discard pile
-    player.gain("Card1");
+    // Add "Copper" to discard pile
+    player.gain("Copper");
 
-    // Now discard pile should have "Card1"
+    // Now discard pile should have "Copper"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 1);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card1");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Copper");
 }
 
 TEST(PlayerTest, IncreaseActions)
@@ -171,8 +172,8 @@ TEST(PlayerTest, EndTurn)
     player.addActions(2);
     player.addBuys(1);
     player.addTreasure(3);
-    player.getMutable<shared::CardAccess::HAND>() = {"Card1", "Card2"};
-    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Card3"};
+    player.getMutable<shared::CardAccess::HAND>() = {"Copper", "Silver"};
+    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Gold"};
 
     // Call end_turn()
     player.endTurn();
@@ -197,17 +198,17 @@ TEST(PlayerTest, AddCardsToPile)
     player.getMutable<shared::CardAccess::DISCARD_PILE>().clear();
 
     // Add cards to the discard pile
-    player.gain("Card1");
-    player.gain("Card2");
-    player.gain("Card3");
+    player.gain("Copper");
+    player.gain("Silver");
+    player.gain("Gold");
 
     // Verify the discard pile
     const auto &discard_pile = player.get<shared::CardAccess::DISCARD_PILE>();
 
     ASSERT_EQ(discard_pile.size(), 3);
-    EXPECT_EQ(discard_pile[0], "Card1");
-    EXPECT_EQ(discard_pile[1], "Card2");
-    EXPECT_EQ(discard_pile[2], "Card3");
+    EXPECT_EQ(discard_pile[0], "Copper");
+    EXPECT_EQ(discard_pile[1], "Silver");
+    EXPECT_EQ(discard_pile[2], "Gold");
 }
 
 TEST(PlayerTest, GetPile)
@@ -215,16 +216,188 @@ TEST(PlayerTest, GetPile)
     TestPlayer player("player");
 
     // Set up piles
-    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Card1", "Card2"};
-    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Card3", "Card4"};
-    player.getMutable<shared::CardAccess::HAND>() = {"Card5"};
+    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Copper", "Silver"};
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Gold", "Estate"};
+    player.getMutable<shared::CardAccess::HAND>() = {"Duchy"};
 
     // Access and verify each pile
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[1], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Copper");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[1], "Silver");
 
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Card3");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Card4");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Gold");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Estate");
 
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card5");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Duchy");
+}
+
+TEST(PlayerTest, VictoryPoints)
+{
+    TestPlayer player("player");
+
+    // 12 cards: 1 + 3 + 6 - 1 points, Gardens 1 per 10 cards, Duke 1 per Duchy, Silk_Road 1 per 4 victory cards
+    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Estate", "Duchy", "Province", "Curse"};
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Gardens", "Duke", "Silk_Road", "Copper"};
+    player.getMutable<shared::CardAccess::HAND>() = {"Copper", "Silver", "Gold", "Village"};
+
+    // victory cards are Estate, Duchy, Province, Curse, Gardens, Duke and Silk_Road
+    EXPECT_EQ(player.getVictoryPoints(), 1 + 3 + 6 - 1 + 1 + 1 + 1);
+
+    player.gain("Duchy");
+    EXPECT_EQ(player.getVictoryPoints(), 9 + 3 + 1 + 2 + 2);
+}
+
+TEST(PlayerTest, CountsFollowThePiles)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Copper", "Copper", "Estate", "Moat", "Silver", "Gold"};
+
+    player.draw(4);
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().count("Copper"), 2);
+    EXPECT_TRUE(player.hasCard<shared::CardAccess::HAND>("Moat"));
+    EXPECT_FALSE(player.hasCard<shared::CardAccess::HAND>("Silver"));
+    EXPECT_TRUE(player.canBlock());
+    EXPECT_EQ(player.getCounts<shared::CardAccess::DRAW_PILE_TOP>().size(), 2);
+
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>("Moat");
+    EXPECT_FALSE(player.canBlock());
+    EXPECT_TRUE(player.hasCard<shared::CardAccess::DISCARD_PILE>("Moat"));
+
+    player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>("Copper");
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().count("Copper"), 1);
+    EXPECT_EQ(player.getType<shared::CardAccess::HAND>(shared::CardType::TREASURE),
+              std::vector<shared::CardId>({"Copper"}));
+
+    const auto deck = player.getDeckCounts();
+    EXPECT_EQ(deck.size(), 5);
+    EXPECT_EQ(deck.countType(shared::CardType::TREASURE), 3);
+    EXPECT_EQ(deck.countType(shared::CardType::VICTORY), 1);
+}
+
+TEST(PlayerTest, TypeCountsFollowThePiles)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::HAND>() = {"Copper", "Gardens", "Moat", "Witch", "Great_Hall", "Curse"};
+    const auto &hand = player.getCounts<shared::CardAccess::HAND>();
+
+    EXPECT_EQ(hand.countType(shared::CardType::KINGDOM), 4);
+    EXPECT_EQ(hand.countType(shared::CardType::TREASURE), 1);
+    EXPECT_EQ(hand.countType(shared::CardType::VICTORY), 3);
+    EXPECT_EQ(hand.countType(shared::CardType::CURSE), 1);
+    EXPECT_EQ(hand.countType(shared::CardType::ACTION), 3);
+    EXPECT_EQ(hand.countType(shared::CardType::ATTACK), 1);
+    EXPECT_EQ(hand.countType(shared::CardType::REACTION), 1);
+    // not a single type, the cards are looked at
+    EXPECT_EQ(hand.countType(static_cast<shared::CardType>(shared::CardType::ACTION | shared::CardType::VICTORY)), 1);
+    EXPECT_FALSE(hand.hasType(static_cast<shared::CardType>(shared::CardType::TREASURE | shared::CardType::VICTORY)));
+
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>("Moat");
+    player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>("Copper");
+    EXPECT_FALSE(player.canBlock());
+    EXPECT_FALSE(player.hasType<shared::CardAccess::HAND>(shared::CardType::TREASURE));
+    EXPECT_TRUE(player.hasType<shared::CardAccess::HAND>(shared::CardType::ATTACK));
+    EXPECT_EQ(hand.typeMask(), shared::CardType::ATTACK | shared::CardType::CURSE);
+    EXPECT_TRUE(player.hasType<shared::CardAccess::DISCARD_PILE>(shared::CardType::REACTION));
+    EXPECT_EQ(player.getType<shared::CardAccess::HAND>(shared::CardType::VICTORY),
+              std::vector<shared::CardId>({"Great_Hall", "Gardens", "Curse"}));
+}
+
+TEST(PlayerTest, DrawPileTopAndBottom)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Copper", "Silver", "Gold"};
+
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(std::vector<shared::CardId>{"Estate", "Duchy"});
+    player.add<shared::CardAccess::DRAW_PILE_BOTTOM>(std::vector<shared::CardId>{"Curse", "Moat"});
+    const auto &draw_pile = player.get<shared::CardAccess::DRAW_PILE_TOP>();
+    EXPECT_EQ(std::vector<shared::CardId>(draw_pile.begin(), draw_pile.end()),
+              std::vector<shared::CardId>({"Estate", "Duchy", "Copper", "Silver", "Gold", "Curse", "Moat"}));
+
+    EXPECT_EQ(player.take<shared::CardAccess::DRAW_PILE_TOP>(2), std::vector<shared::CardId>({"Estate", "Duchy"}));
+    EXPECT_EQ(player.take<shared::CardAccess::DRAW_PILE_BOTTOM>(2), std::vector<shared::CardId>({"Curse", "Moat"}));
+
+    // the card put back on top is the next one drawn
+    player.draw(1);
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DRAW_PILE_TOP>("Copper");
+    player.draw(2);
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>(), std::vector<shared::CardId>({"Copper", "Silver"}));
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Gold");
+}
+
+TEST(PlayerTest, HandStaysInDisplayOrder)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::HAND>() = {"Estate", "Gold", "Village", "Copper"};
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>(),
+              std::vector<shared::CardId>({"Village", "Copper", "Gold", "Estate"}));
+
+    // drawn cards go to their place, after the copies already in the hand, Curse counts as a victory card
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Smithy", "Curse", "Copper", "Festival"};
+    player.draw(4);
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>(),
+              std::vector<shared::CardId>(
+                      {"Village", "Smithy", "Festival", "Copper", "Copper", "Gold", "Curse", "Estate"}));
+
+    // Great_Hall is shown with the actions, before Village as they cost the same
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>("Smithy");
+    player.add<shared::CardAccess::HAND>("Great_Hall");
+    const std::vector<shared::CardBase::id_t> expected = {"Great_Hall", "Village", "Festival", "Copper",
+                                                          "Copper",     "Gold",    "Curse",    "Estate"};
+    EXPECT_EQ(player.getReducedPlayer()->getHandCards(), expected);
+}
+
+TEST(PlayerTest, VictoryPointsFollowTheCards)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Gardens", "Silk_Road", "Estate", "Copper"};
+    // 4 cards: Gardens 0, Silk_Road 0 (3 victory cards), Estate 1
+    EXPECT_EQ(player.getVictoryPoints(), 1);
+
+    player.draw(3);
+    player.move<shared::CardAccess::HAND, shared::CardAccess::STAGED_CARDS>("Estate");
+    EXPECT_EQ(player.getVictoryPoints(), 1);
+
+    // the 4th victory card makes Silk_Road worth 1
+    player.gain("Duke");
+    EXPECT_EQ(player.getVictoryPoints(), 2);
+    player.gain("Duchy");
+    EXPECT_EQ(player.getVictoryPoints(), 2 + 3 + 1);
+
+    // 10 cards make Gardens worth 1, Curses are victory cards for Silk_Road
+    for ( int i = 0; i < 4; ++i ) {
+        player.gain("Curse");
+    }
+    EXPECT_EQ(player.getVictoryPoints(), 1 + 3 + 1 - 4 + 1 + 2);
+
+    player.move<shared::CardAccess::STAGED_CARDS, shared::CardAccess::TRASH>("Estate");
+    EXPECT_EQ(player.getVictoryPoints(), 3 + 1 - 4 + 2);
+}
+
+TEST(PlayerTest, ReducedViewsFollowThePlayer)
+{
+    TestPlayer player("player");
+    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Copper", "Village", "Estate", "Silver", "Gold"};
+    player.draw(3);
+
+    const auto first = player.getReducedPlayer();
+    EXPECT_EQ(first->getHandCards(), std::vector<shared::CardBase::id_t>({"Village", "Copper", "Estate"}));
+    // nothing changed, the cached view is copied
+    EXPECT_EQ(player.getReducedPlayer()->getHandCards(), first->getHandCards());
+    EXPECT_EQ(player.getReducedEnemy()->getHandSize(), 3);
+
+    player.gain("Duchy");
+    EXPECT_EQ(player.getReducedPlayer()->getDiscardPileSize(), 1);
+    EXPECT_EQ(player.getReducedEnemy()->getTopDiscardCard(), "Duchy");
+
+    player.addTreasure(2);
+    EXPECT_EQ(player.getReducedPlayer()->getTreasure(), 2);
+    EXPECT_EQ(player.getReducedEnemy()->getTreasure(), 2);
+
+    player.draw(1);
+    EXPECT_EQ(player.getReducedEnemy()->getHandSize(), 4);
+    EXPECT_EQ(player.getReducedPlayer()->getDrawPileSize(), 1);
+
+    // a copy of the player shares the views until one of them changes
+    TestPlayer copy(player);
+    copy.addActions(1);
+    EXPECT_EQ(copy.getReducedEnemy()->getActions(), player.getReducedEnemy()->getActions() + 1);
 }
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sockpp/unix_stream_socket.h>
+
+#include <server/network/basic_network.h>
+#include <server/network/framing.h>
+
+using server::BasicNetwork;
+using server::FrameParser;
+
+TEST(BasicNetwork, ConcurrentSendsToOneConnectionDoNotInterleave)
+{
+    constexpr size_t MESSAGES = 50;
+    constexpr size_t THREADS = 4;
+
+    // writes to a closed socket fail instead of raising SIGPIPE
+    sockpp::socket_initializer::initialize();
+    auto pair = sockpp::unix_socket::pair();
+    ASSERT_TRUE(pair);
+    auto [server_side, client_side] = pair.release();
+
+    const std::string address = "test:concurrent-sends";
+    BasicNetwork::addAddressToSocket(address, std::move(server_side), false);
+    std::vector<std::string> channel_addresses;
+    for ( size_t channel = 0; channel < THREADS; ++channel ) {
+        channel_addresses.push_back(BasicNetwork::addChannel(address, static_cast<server::channel_id_t>(channel)));
+    }
+
+    // payloads larger than the socket buffer, so that every frame takes more than one write
+    auto payload = [](size_t channel, size_t n)
+    { return std::string((256 << 10) + n, static_cast<char>('a' + channel)); };
+
+    std::vector<size_t> received(THREADS, 0);
+    auto read_frames = [&]
+    {
+        FrameParser parser;
+        std::vector<char> buffer(1 << 16);
+        size_t frames = 0;
+        while ( frames < THREADS * MESSAGES ) {
+            auto result = client_side.read(buffer.data(), buffer.size());
+            ASSERT_TRUE(result && result.value() > 0);
+            parser.append(buffer.data(), result.value());
+            while ( auto frame = parser.next() ) {
+                ASSERT_TRUE(frame->channel.has_value());
+                const size_t channel = frame->channel.value();
+                ASSERT_LT(channel, THREADS);
+                ASSERT_EQ(frame->payload, payload(channel, received[channel]));
+                ++received[channel];
+                ++frames;
+            }
+        }
+    };
+    std::thread reader(
+            [&]
+            {
+                read_frames();
+                // the senders fail instead of blocking if the frames are broken
+                client_side.shutdown();
+            });
+
+    std::vector<std::thread> senders;
+    for ( size_t channel = 0; channel < THREADS; ++channel ) {
+        senders.emplace_back(
+                [&, channel]
+                {
+                    BasicNetwork::SendBatch batch;
+                    for ( size_t n = 0; n < MESSAGES; ++n ) {
+                        BasicNetwork::sendToAddress(payload(channel, n), channel_addresses[channel]);
+                    }
+                });
+    }
+    for ( auto &sender : senders ) {
+        sender.join();
+    }
+    reader.join();
+
+    EXPECT_EQ(received, std::vector<size_t>(THREADS, MESSAGES));
+    BasicNetwork::playerDisconnect(address);
+}
+
+TEST(BasicNetwork, DisconnectReleasesConnectionWithClosedChannels)
+{
+    sockpp::socket_initializer::initialize();
+    auto pair = sockpp::unix_socket::pair();
+    ASSERT_TRUE(pair);
+    auto [server_side, client_side] = pair.release();
+
+    const std::string address = "test:closed-channels";
+    BasicNetwork::addAddressToSocket(address, std::move(server_side), false);
+    BasicNetwork::closeChannel(BasicNetwork::addChannel(address, 7));
+    BasicNetwork::playerDisconnect(address);
+
+    ASSERT_EQ(BasicNetwork::sendToAddress("{}", address), -1);
+    // the connection held the only copy of the socket, so the peer sees it closed
+    ASSERT_TRUE(client_side.read_timeout(std::chrono::seconds(5)));
+    char byte;
+    auto result = client_side.read(&byte, 1);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value(), 0u);
+}
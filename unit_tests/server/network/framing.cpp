@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include <server/network/framing.h>
+#include <shared/utils/exception.h>
+
+using server::encodeFrame;
+using server::Frame;
+using server::FrameParser;
+
+namespace
+{
+    void append(FrameParser &parser, const std::string &data) { parser.append(data.data(), data.size()); }
+} // namespace
+
+TEST(Framing, EncodeFrame)
+{
+    EXPECT_EQ(encodeFrame("{\"a\":1}"), "7:{\"a\":1}");
+    EXPECT_EQ(encodeFrame("{\"a\":1}", 42), "42/7:{\"a\":1}");
+    EXPECT_EQ(encodeFrame("", 3), "3/0:");
+}
+
+TEST(Framing, SingleFrame)
+{
+    FrameParser parser;
+    append(parser, encodeFrame("{\"type\":\"x\"}"));
+
+    auto frame = parser.next();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_FALSE(frame->channel.has_value());
+    EXPECT_EQ(frame->payload, "{\"type\":\"x\"}");
+    EXPECT_FALSE(parser.next().has_value());
+}
+
+TEST(Framing, FrameSplitAcrossReads)
+{
+    FrameParser parser;
+    const std::string wire = encodeFrame("hello world", 7);
+
+    // feed the frame byte by byte, it must only appear once it is complete
+    for ( size_t i = 0; i + 1 < wire.size(); ++i ) {
+        parser.append(&wire[i], 1);
+        EXPECT_FALSE(parser.next().has_value());
+    }
+    parser.append(&wire.back(), 1);
+
+    auto frame = parser.next();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->channel, 7u);
+    EXPECT_EQ(frame->payload, "hello world");
+}
+
+TEST(Framing, SeveralFramesInOneRead)
+{
+    FrameParser parser;
+    append(parser, encodeFrame("first", 1) + encodeFrame("second", 2) + encodeFrame("", 1) + encodeFrame("plain") +
+                           "4:pa");
+
+    auto first = parser.next();
+    auto second = parser.next();
+    auto close = parser.next();
+    auto plain = parser.next();
+    ASSERT_TRUE(first && second && close && plain);
+    EXPECT_EQ(first->channel, 1u);
+    EXPECT_EQ(first->payload, "first");
+    EXPECT_EQ(second->channel, 2u);
+    EXPECT_EQ(second->payload, "second");
+    EXPECT_EQ(close->channel, 1u);
+    EXPECT_TRUE(close->payload.empty());
+    EXPECT_FALSE(plain->channel.has_value());
+    EXPECT_EQ(plain->payload, "plain");
+
+    // the last frame is incomplete
+    EXPECT_FALSE(parser.next().has_value());
+    append(parser, "rt");
+    auto partial = parser.next();
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_EQ(partial->payload, "part");
+}
+
+TEST(Framing, MalformedHeader)
+{
+    {
+        FrameParser parser;
+        append(parser, "abc:{}");
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+    }
+    {
+        FrameParser parser;
+        append(parser, "1/x/2:{}");
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+    }
+    {
+        FrameParser parser;
+        append(parser, "/2:{}");
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+    }
+    {
+        // no separator in sight
+        FrameParser parser;
+        append(parser, std::string(100, '1'));
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+
+        parser.clear();
+        append(parser, encodeFrame("ok"));
+        EXPECT_EQ(parser.next()->payload, "ok");
+    }
+}
+
+TEST(Framing, PayloadTooLong)
+{
+    {
+        FrameParser parser;
+        append(parser, "1/99999999999:");
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+    }
+    {
+        FrameParser parser;
+        append(parser, std::to_string(FrameParser::MAX_FRAME_LENGTH + 1) + ":{}");
+        EXPECT_THROW(parser.next(), exception::MalformedFrame);
+    }
+    {
+        // the longest payload is still accepted
+        FrameParser parser;
+        const std::string payload(FrameParser::MAX_FRAME_LENGTH, 'x');
+        append(parser, encodeFrame(payload, 3));
+        auto frame = parser.next();
+        ASSERT_TRUE(frame.has_value());
+        EXPECT_EQ(frame->payload.size(), FrameParser::MAX_FRAME_LENGTH);
+    }
+}
@@ -8,6 +8,7 @@
 
 #include <shared/game/cards/card_base.h>
 #include <shared/game/game_state/board_base.h>
+#include <shared/utils/json.h>
 #include <shared/utils/test_helpers.h>
 
 TEST(PileTest, Pile2WayJsonConversion)
@@ -28,12 +29,29 @@ TEST(BoardJsonTest, Board2WayJsonConversion)
     EXPECT_EQ(*actual, *expected);
 }
 
+TEST(BoardJsonTest, WriterGivesTheSameJsonAsTheDocument)
+{
+    shared::Board::ptr_t board = shared::Board::make(getValidKingdomCards(), 3);
+    board->getPlayedCards() = {"Smithy", "Copper"};
+
+    shared::Pile pile("Militia", 7);
+    EXPECT_EQ(writeToString([&pile](JsonWriter &writer) { pile.writeJson(writer); }),
+              documentToString(pile.toJson()));
+    EXPECT_EQ(writeToString([&board](JsonWriter &writer) { board->writeJson(writer); }),
+              documentToString(board->toJson()));
+}
+
 // ================================
 // HELPERS
 // ================================
+auto findPile(shared::Board::pile_container_t piles, const shared::CardBase::id_t &card_id)
+{
+    return std::find_if(piles.begin(), piles.end(), [&](const shared::Pile &pile) { return pile.card_id == card_id; });
+}
+
 #define EXPECT_PILE(pile_set, key, expected_count)                                                                     \
     do {                                                                                                               \
-        auto it = (pile_set).find((key));                                                                              \
+        auto it = findPile((pile_set), (key));                                                                         \
         EXPECT_NE(it, (pile_set).end());                                                                               \
         if ( it != (pile_set).end() ) {                                                                                \
             EXPECT_EQ(it->count, (expected_count));                                                                    \
@@ -70,10 +88,7 @@ public:
     using shared::Board::isGameOver;
 
     // Expose protected member variables for testing access
-    shared::Board::pile_container_t &getTreasureCards() { return treasure_cards; }
-    shared::Board::pile_container_t &getVictoryCards() { return victory_cards; }
-    shared::Board::pile_container_t &getKingdomCards() { return kingdom_cards; }
-    shared::Pile &getCursePile() { return curse_card_pile; }
+    const shared::Pile &getCursePile() { return getCurseCardPile(); }
     std::vector<shared::CardBase::id_t> &getTrash() { return trash; }
 };
 
@@ -104,7 +119,7 @@ protected:
 TEST_P(BoardInitializationTest, InitializePiles)
 {
     // Check treasure cards
-    const auto &treasure_cards = board->getTreasureCards();
+    const auto treasure_cards = board->getTreasureCards();
     ASSERT_EQ(treasure_cards.size(), 3); // Copper, Silver, Gold
 
     size_t expected_copper_count = expected_constants::TREASURE_COPPER_COUNT - (7 * player_count);
@@ -113,7 +128,7 @@ TEST_P(BoardInitializationTest, InitializePiles)
     EXPECT_PILE(treasure_cards, "Gold", expected_constants::TREASURE_GOLD_COUNT);
 
     // Check victory cards
-    const auto &victory_cards = board->getVictoryCards();
+    const auto victory_cards = board->getVictoryCards();
     ASSERT_EQ(victory_cards.size(), 3); // Estate, Duchy, Province
 
     size_t expected_victory_count = (player_count == 2) ? expected_constants::VICTORY_CARDS_SMALL_GAME
@@ -128,7 +143,7 @@ TEST_P(BoardInitializationTest, InitializePiles)
     EXPECT_EQ(curse_cards.count, expected_curse_count);
 
     // Check kingdom cards
-    const auto &kingdom_piles = board->getKingdomCards();
+    const auto kingdom_piles = board->getKingdomCards();
     ASSERT_EQ(kingdom_piles.size(), kingdom_cards.size());
     for ( const auto &card_id : kingdom_cards ) {
         EXPECT_PILE(kingdom_piles, card_id, expected_constants::KINGDOM_CARD_COUNT);
@@ -137,6 +152,28 @@ TEST_P(BoardInitializationTest, InitializePiles)
 
 INSTANTIATE_TEST_SUITE_P(PlayerCountTests, BoardInitializationTest, ::testing::Values(2, 3, 4));
 
+TEST(BoardPilesTest, PilesAreOrderedByCostAndIndexedByCard)
+{
+    TestableSharedBoard board(getValidKingdomCards(), 2);
+
+    const auto kingdom_piles = board.getKingdomCards();
+    EXPECT_TRUE(std::is_sorted(kingdom_piles.begin(), kingdom_piles.end(),
+                               [](const shared::Pile &a, const shared::Pile &b)
+                               {
+                                   const auto cost_a = shared::CardFactory::getCost(a.card_id);
+                                   const auto cost_b = shared::CardFactory::getCost(b.card_id);
+                                   return cost_a < cost_b || (cost_a == cost_b && a.card_id < b.card_id);
+                               }));
+
+    for ( const auto &pile : kingdom_piles ) {
+        EXPECT_EQ(board.getPile(pile.card_id), &pile);
+    }
+    EXPECT_EQ(board.getPile("Curse"), &board.getCurseCardPile());
+    EXPECT_EQ(board.getPile("Province")->count, expected_constants::VICTORY_CARDS_SMALL_GAME);
+    EXPECT_EQ(board.getPile("Moat"), nullptr);
+    EXPECT_EQ(board.getPile("NonExistentCard"), nullptr);
+}
+
 // --------------------------------
 // GameOver Test
 // --------------------------------
@@ -160,17 +197,13 @@ protected:
 
         // Empty specified number of kingdom piles
         if ( param.empty_kingdom_piles > 0 ) {
-            auto &kingdom_piles = board->getKingdomCards();
-            setNPilesToEmpty(kingdom_piles, param.empty_kingdom_piles);
+            auto kingdom_piles = board->getKingdomCards();
+            setNPilesToEmpty(*board, kingdom_piles, param.empty_kingdom_piles);
         }
 
         // Empty the Province pile if required
         if ( param.empty_province_pile ) {
-            const auto &victory_piles = board->getVictoryCards();
-            auto it = victory_piles.find("Province");
-            if ( it != victory_piles.end() ) {
-                it->count = 0;
-            }
+            board->setPileCount(shared::CardId::of("Province"), 0);
         }
     }
 
@@ -220,20 +253,20 @@ protected:
 
         // Empty specified number of kingdom piles
         if ( param.empty_kingdom_piles > 0 ) {
-            auto &kingdom_piles = board->getKingdomCards();
-            setNPilesToEmpty(kingdom_piles, param.empty_kingdom_piles);
+            auto kingdom_piles = board->getKingdomCards();
+            setNPilesToEmpty(*board, kingdom_piles, param.empty_kingdom_piles);
         }
 
         // Empty specified number of victory piles
         if ( param.empty_victory_piles > 0 ) {
-            auto &victory_piles = board->getVictoryCards();
-            setNPilesToEmpty(victory_piles, param.empty_victory_piles);
+            auto victory_piles = board->getVictoryCards();
+            setNPilesToEmpty(*board, victory_piles, param.empty_victory_piles);
         }
 
         // Empty specified number of treasure piles
         if ( param.empty_treasure_piles > 0 ) {
-            auto &treasure_piles = board->getTreasureCards();
-            setNPilesToEmpty(treasure_piles, param.empty_treasure_piles);
+            auto treasure_piles = board->getTreasureCards();
+            setNPilesToEmpty(*board, treasure_piles, param.empty_treasure_piles);
         }
     }
 
@@ -365,11 +398,11 @@ protected:
         board = new TestableSharedBoard(kingdom_cards, player_count);
 
         // Set invalid victory card counts
-        const auto &victory_piles = board->getVictoryCards();
+        const auto victory_piles = board->getVictoryCards();
         for ( const auto &pile : victory_piles ) {
             if ( pile.card_id != "Curse" ) // Skip Curse cards
             {
-                pile.count = param.victory_card_count;
+                board->setPileCount(pile.card_id, param.victory_card_count);
             }
         }
     }
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_factory.h>
+#include <shared/game/cards/card_id.h>
 
 TEST(CardBaseTest, ConstructorAndGetters)
 {
@@ -181,3 +183,59 @@ TEST(CardBaseTest, CostTest)
     EXPECT_EQ(card2.getCost(), 3);
     EXPECT_EQ(card3.getCost(), 6);
 }
+
+TEST(CardIdTest, RoundTripsRegisteredNames)
+{
+    for ( const auto &[name, card] : shared::CardFactory::getAll() ) {
+        const shared::CardId card_id = name;
+        ASSERT_TRUE(card_id.valid());
+        EXPECT_LT(card_id.index(), shared::CardFactory::getCardCount());
+        EXPECT_EQ(card_id.name(), name);
+        EXPECT_EQ(&shared::CardFactory::getCard(card_id), card.get());
+    }
+}
+
+TEST(CardIdTest, IndicesAreDense)
+{
+    std::vector<bool> seen(shared::CardFactory::getCardCount(), false);
+    for ( const auto &entry : shared::CardFactory::getAll() ) {
+        const shared::CardId card_id = entry.first;
+        EXPECT_FALSE(seen.at(card_id.index()));
+        seen.at(card_id.index()) = true;
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool is_seen) { return is_seen; }));
+}
+
+TEST(CardIdTest, UnknownNamesAreInvalid)
+{
+    const shared::CardId card_id = "NonExistentCard";
+    EXPECT_FALSE(card_id.valid());
+    EXPECT_EQ(card_id, shared::CardId::invalid());
+    EXPECT_THROW(shared::CardFactory::getCard(card_id), std::out_of_range);
+    EXPECT_THROW(shared::CardFactory::getCost(card_id), std::invalid_argument);
+}
+
+TEST(CardIdTest, ComparesWithNames)
+{
+    const shared::CardId copper = "Copper";
+    EXPECT_EQ(copper, "Copper");
+    EXPECT_NE(copper, "Silver");
+    EXPECT_EQ(shared::CardFactory::getCost(copper), 0);
+    EXPECT_TRUE(shared::CardFactory::isTreasure(copper));
+}
+
+TEST(CardIdTest, LooksUpLiteralsAtCompileTime)
+{
+    constexpr auto copper = shared::CardId::of("Copper");
+    static_assert(copper.valid());
+    static_assert(shared::CARD_TABLE[copper.index()].cost == 0);
+    static_assert(shared::CARD_TABLE[shared::CardId::of("Province").index()].victory.points == 6);
+
+    EXPECT_EQ(copper, "Copper");
+    EXPECT_EQ(shared::CardFactory::getCardCount(), shared::CARD_COUNT);
+    for ( size_t index = 0; index < shared::CARD_COUNT; ++index ) {
+        const auto card_id = shared::CardId::fromIndex(static_cast<shared::CardId::index_t>(index));
+        EXPECT_EQ(card_id.name(), shared::CARD_TABLE[index].name);
+        EXPECT_EQ(shared::CardFactory::getType(card_id), shared::CARD_TABLE[index].type);
+    }
+}
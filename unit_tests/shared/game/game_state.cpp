@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/json.h>
 #include <shared/utils/test_helpers.h>
 
 TEST(ReducedGameStateTest, Json2WayConversion)
@@ -37,6 +38,17 @@ TEST(ReducedGameStateTest, Json2WayConversion)
     EXPECT_EQ(*actual, expected);
 }
 
+TEST(ReducedGameStateTest, WriterGivesTheSameJsonAsTheDocument)
+{
+    auto game_state = test_helper::getReducedGameStatePtr(4, getValidKingdomCards(), {"Village", "Copper", "Estate"},
+                                                          {5, 0, 3});
+    game_state->board->getPlayedCards().push_back("Village");
+
+    const std::string written =
+            writeToString([&game_state](JsonWriter &writer) { game_state->writeJson(writer); });
+    EXPECT_EQ(written, documentToString(game_state->toJson()));
+}
+
 TEST(ReducedGameStateTest, ParameterizedConstructor)
 {
     // Create a list of ReducedEnemies
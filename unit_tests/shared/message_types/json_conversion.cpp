@@ -3,6 +3,7 @@
 
 #include <shared/message_types.h>
 #include <shared/player_result.h>
+#include <shared/utils/json.h>
 #include <shared/utils/test_helpers.h>
 
 using namespace shared;
@@ -145,6 +146,23 @@ TEST(SharedLibraryTest, ActionOrderMessageTwoWayConversion)
     ASSERT_EQ(*parsed_message, original_message);
 }
 
+TEST(SharedLibraryTest, ActionOrderWriterGivesTheSameJsonAsTheDocument)
+{
+    std::vector<std::unique_ptr<ActionOrder>> orders;
+    orders.push_back(std::make_unique<ActionPhaseOrder>());
+    orders.push_back(std::make_unique<BuyPhaseOrder>());
+    orders.push_back(std::make_unique<EndTurnOrder>());
+    orders.push_back(std::make_unique<GainFromBoardOrder>(5, shared::CardType::TREASURE));
+    orders.push_back(std::make_unique<ChooseFromHandOrder>(1, 3, ChooseFromOrder::AllowedChoice::TRASH));
+    orders.push_back(std::make_unique<ChooseFromStagedOrder>(0, 2, ChooseFromOrder::AllowedChoice::DISCARD,
+                                                             std::vector<shared::CardBase::id_t>{"Gold", "Estate"}));
+
+    for ( const auto &order : orders ) {
+        EXPECT_EQ(writeToString([&order](JsonWriter &writer) { order->writeJson(writer); }),
+                  documentToString(order->toJson()));
+    }
+}
+
 // ======= CLIENT TO SERVER MESSAGES ======= //
 
 TEST(SharedLibraryTest, GameStateRequestMessageTwoWayConversion)
@@ -294,3 +312,83 @@ TEST(SharedLibraryTest, ActionDecisionMessageTwoWayConversionChooseNCardsFromHan
     ASSERT_NE(parsed_message, nullptr);
     ASSERT_EQ(*parsed_message, original_message);
 }
+
+TEST(SharedLibraryTest, ParsedMessagesHaveTheirKind)
+{
+    auto server_message = ServerToClientMessage::fromJson(CreateLobbyResponseMessage("123", std::nullopt).toJson());
+    ASSERT_EQ(server_message->getKind(), MessageKind::CREATE_LOBBY_RESPONSE);
+    ASSERT_NE(messageCast<CreateLobbyResponseMessage>(server_message.get()), nullptr);
+    ASSERT_EQ(messageCast<GameStateMessage>(server_message.get()), nullptr);
+
+    auto client_message = ClientToServerMessage::fromJson(GameStateRequestMessage("123", "player1").toJson());
+    ASSERT_EQ(client_message->getKind(), MessageKind::GAME_STATE_REQUEST);
+
+    std::vector<std::pair<std::unique_ptr<ActionDecision>, DecisionKind>> decisions;
+    decisions.emplace_back(std::make_unique<PlayActionCardDecision>("Village"), DecisionKind::PLAY_ACTION_CARD);
+    decisions.emplace_back(std::make_unique<BuyCardDecision>("Gold"), DecisionKind::BUY_CARD);
+    decisions.emplace_back(std::make_unique<EndActionPhaseDecision>(), DecisionKind::END_ACTION_PHASE);
+    decisions.emplace_back(std::make_unique<EndTurnDecision>(), DecisionKind::END_TURN);
+    decisions.emplace_back(std::make_unique<DeckChoiceDecision>(
+                                   std::vector<CardBase::id_t>{"Copper"},
+                                   std::vector<ChooseFromOrder::AllowedChoice>{ChooseFromOrder::AllowedChoice::TRASH}),
+                           DecisionKind::DECK_CHOICE);
+    decisions.emplace_back(std::make_unique<GainFromBoardDecision>("Silver"), DecisionKind::GAIN_FROM_BOARD);
+
+    for ( auto &[decision, kind] : decisions ) {
+        const std::string json = ActionDecisionMessage("123", "player1", std::move(decision)).toJson();
+        auto parsed = ClientToServerMessage::fromJson(json);
+        ASSERT_EQ(parsed->getKind(), MessageKind::ACTION_DECISION);
+
+        auto *parsed_message = messageCast<ActionDecisionMessage>(parsed.get());
+        ASSERT_NE(parsed_message, nullptr);
+        ASSERT_EQ(parsed_message->decision->getKind(), kind);
+    }
+}
+
+TEST(SharedLibraryTest, ClientToServerMessageValidation)
+{
+    const std::string header = R"("type":"action_decision","game_id":"g","message_id":"m","player_id":"p")";
+    const std::string cards = R"(["Village","Smithy","Festival","Market","Laboratory","Witch","Moat","Cellar",)"
+                              R"("Chapel","Mine"])";
+
+    const std::vector<std::string> valid = {
+            "{" + header + R"(,"action":"end_turn"})",
+            // other members and everything nested in them are ignored
+            "{" + header + R"(,"extra":{"type":5,"game_id":[1]},"action":"end_turn","card":[{}]})",
+            // only the first member of a name counts
+            "{" + header + R"(,"action":"end_turn","action":5,"game_id":null})",
+            "{" + header + R"(,"action":"play_action_card","card_id":"Village","from":-0})",
+            "{" + header + R"(,"action":"deck_choice","cards":["Copper","Estate"],"choices":[2,4]})",
+            "{" + header + R"(,"in_response_to":"r","action":"buy_card","card":"Gold"})",
+            R"({"type":"start_game_request","game_id":"g","message_id":"m","player_id":"p","selected_cards":)" + cards +
+                    "}",
+            R"({"player_id":"p","message_id":"m","game_id":"g","type":"join_game_request"})",
+    };
+    for ( const auto &json : valid ) {
+        EXPECT_NE(ClientToServerMessage::fromJson(json), nullptr) << json;
+    }
+
+    const std::vector<std::string> invalid = {
+            "",
+            "[]",
+            "5",
+            R"("action_decision")",
+            "{" + header + R"(,"action":"end_turn"} {})",
+            "{" + header + R"(,"action":"end_turn")",
+            "{" + header + R"(,"action":"unknown"})",
+            "{" + header + "}",
+            "{" + header + R"(,"action":"end_turn","in_response_to":5})",
+            "{" + header + R"(,"action":"play_action_card","card_id":"Village","from":-1})",
+            "{" + header + R"(,"action":"play_action_card","card_id":"Village","from":1.0})",
+            "{" + header + R"(,"action":"play_action_card","card_id":"Village","from":4294967296})",
+            "{" + header + R"(,"action":"deck_choice","cards":["Copper",["Estate"]],"choices":[2]})",
+            "{" + header + R"(,"action":"deck_choice","cards":["Copper"],"choices":["trash"]})",
+            "{" + header + R"(,"action":"board_choice","chosen_card":{"name":"Silver"}})",
+            R"({"type":"action_decision","game_id":"g","message_id":"m","action":"end_turn"})",
+            R"({"type":"action_decision","game_id":"g","message_id":"m","player_id":true,"action":"end_turn"})",
+            R"({"type":"start_game_request","game_id":"g","message_id":"m","player_id":"p","selected_cards":["a"]})",
+    };
+    for ( const auto &json : invalid ) {
+        EXPECT_EQ(ClientToServerMessage::fromJson(json), nullptr) << json;
+    }
+}